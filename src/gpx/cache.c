@@ -0,0 +1,1405 @@
+//  cache.c
+//
+//  Content addressed cache of converted x3g
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include "cache.h"
+
+#ifdef HAVE_DIRENT_H
+#include <dirent.h>
+#endif
+
+// bump when the x3g of the same gcode and settings could change
+#define CACHE_FORMAT 2
+
+// BLAKE2b
+
+// BLAKE2b (RFC 7693) with a 32 byte digest, on 64 bit machines it hashes
+// about twice as fast as SHA-256 so a hit costs little more than the copy
+
+static const uint64_t blake2b_iv[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+static const unsigned char blake2b_sigma[12][16] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+    { 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+    { 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+    { 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+    { 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+    { 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+    { 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+    { 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+    { 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 }
+};
+
+#define ROR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+#define G(a, b, c, d, x, y) \
+    v[a] = v[a] + v[b] + (x); v[d] = ROR64(v[d] ^ v[a], 32); \
+    v[c] = v[c] + v[d];       v[b] = ROR64(v[b] ^ v[c], 24); \
+    v[a] = v[a] + v[b] + (y); v[d] = ROR64(v[d] ^ v[a], 16); \
+    v[c] = v[c] + v[d];       v[b] = ROR64(v[b] ^ v[c], 63)
+
+static void blake2b_compress(Blake2b *b2, const unsigned char *p, int last)
+{
+    uint64_t v[16], m[16];
+    int i, j;
+
+    for(i = 0; i < 16; i++) {
+        m[i] = 0;
+        for(j = 7; j >= 0; j--) {
+            m[i] = m[i] << 8 | p[8 * i + j];
+        }
+    }
+    for(i = 0; i < 8; i++) {
+        v[i] = b2->state[i];
+        v[i + 8] = blake2b_iv[i];
+    }
+    v[12] ^= b2->length;
+    if(last) v[14] = ~v[14];
+    for(i = 0; i < 12; i++) {
+        const unsigned char *s = blake2b_sigma[i];
+        G(0, 4, 8, 12, m[s[0]], m[s[1]]);
+        G(1, 5, 9, 13, m[s[2]], m[s[3]]);
+        G(2, 6, 10, 14, m[s[4]], m[s[5]]);
+        G(3, 7, 11, 15, m[s[6]], m[s[7]]);
+        G(0, 5, 10, 15, m[s[8]], m[s[9]]);
+        G(1, 6, 11, 12, m[s[10]], m[s[11]]);
+        G(2, 7, 8, 13, m[s[12]], m[s[13]]);
+        G(3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+    for(i = 0; i < 8; i++) {
+        b2->state[i] ^= v[i] ^ v[i + 8];
+    }
+}
+
+void blake2b_init(Blake2b *b2)
+{
+    memcpy(b2->state, blake2b_iv, sizeof(blake2b_iv));
+    // no key and a HASH_SIZE digest
+    b2->state[0] ^= 0x01010000 ^ HASH_SIZE;
+    b2->length = 0;
+    b2->used = 0;
+}
+
+// the last block is only compressed by blake2b_final, so a full block is
+// kept until more data follows it
+
+void blake2b_update(Blake2b *b2, const void *data, size_t length)
+{
+    const unsigned char *p = data;
+    if(length == 0) return;
+    if(b2->used) {
+        size_t n = 128 - b2->used;
+        if(n > length) n = length;
+        memcpy(b2->block + b2->used, p, n);
+        b2->used += n;
+        p += n;
+        length -= n;
+        if(length == 0) return;
+        b2->length += 128;
+        blake2b_compress(b2, b2->block, 0);
+        b2->used = 0;
+    }
+    while(length > 128) {
+        b2->length += 128;
+        blake2b_compress(b2, p, 0);
+        p += 128;
+        length -= 128;
+    }
+    memcpy(b2->block, p, length);
+    b2->used = length;
+}
+
+void blake2b_final(Blake2b *b2, unsigned char digest[HASH_SIZE])
+{
+    int i;
+    b2->length += b2->used;
+    memset(b2->block + b2->used, 0, 128 - b2->used);
+    blake2b_compress(b2, b2->block, 1);
+    for(i = 0; i < HASH_SIZE; i++) {
+        digest[i] = (unsigned char)(b2->state[i / 8] >> (8 * (i % 8)));
+    }
+}
+
+static void hex_digest(const unsigned char digest[HASH_SIZE], char hex[2 * HASH_SIZE + 1])
+{
+    int i;
+    for(i = 0; i < HASH_SIZE; i++) {
+        sprintf(hex + 2 * i, "%02x", digest[i]);
+    }
+}
+
+// GCODE CHUNKS
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+void chunker_init(Chunker *c, Blake2b *key)
+{
+    memset(c, 0, sizeof(Chunker));
+    blake2b_init(&c->gcode);
+    c->key = key;
+    c->lineStart = 1;
+}
+
+// the hash of each chunk goes into the key whether or not its end is kept
+
+static void chunker_end(Chunker *c, uint64_t line)
+{
+    unsigned char digest[HASH_SIZE];
+    blake2b_final(&c->gcode, digest);
+    blake2b_update(c->key, digest, HASH_SIZE);
+    blake2b_init(&c->gcode);
+    if(c->count == c->size && !c->failed) {
+        unsigned size = c->size ? c->size * 2 : 256;
+        ChunkEnd *grown = realloc(c->end, size * sizeof(ChunkEnd));
+        if(grown) {
+            c->end = grown;
+            c->size = size;
+        }
+        else {
+            c->failed = 1;
+        }
+    }
+    if(!c->failed) {
+        ChunkEnd *end = c->end + c->count++;
+        end->input = c->pos;
+        end->line = line;
+        memcpy(end->gcode, digest, HASH_SIZE);
+    }
+    c->start = c->pos;
+}
+// only the lines that start far enough into the chunk are hashed, the chunk
+// is hashed a run of lines at a time
+
+void chunker_update(Chunker *c, const char *data, size_t length)
+{
+    const char *end = data + length;
+    const char *run = data;
+    while(data < end) {
+        const char *eol = memchr(data, '\n', end - data);
+        const char *next = eol ? eol + 1 : end;
+        if(c->lineStart) {
+            c->hashing = c->pos - c->start >= CHUNK_SIZE;
+            c->line = FNV_OFFSET;
+            c->lineStart = 0;
+        }
+        if(c->hashing) {
+            const char *p;
+            for(p = data; p < next; p++) {
+                c->line = (c->line ^ (unsigned char)*p) * FNV_PRIME;
+            }
+        }
+        c->pos += next - data;
+        data = next;
+        if(eol) {
+            c->lineStart = 1;
+            if(c->hashing && (c->line & CHUNK_MASK) == 0) {
+                blake2b_update(&c->gcode, run, next - run);
+                run = next;
+                chunker_end(c, c->line);
+            }
+        }
+    }
+    blake2b_update(&c->gcode, run, end - run);
+}
+
+void chunker_final(Chunker *c)
+{
+    if(c->pos > c->start || c->pos == 0) chunker_end(c, 0);
+    if(c->failed) {
+        free(c->end);
+        c->end = NULL;
+        c->count = 0;
+    }
+}
+
+// CONFIGURATION KEY
+
+// every value is hashed on its own, so padding and pointers never are
+
+static void hash_double(Blake2b *b2, double value)
+{
+    blake2b_update(b2, &value, sizeof(double));
+}
+
+static void hash_unsigned(Blake2b *b2, unsigned long value)
+{
+    blake2b_update(b2, &value, sizeof(unsigned long));
+}
+
+static void hash_string(Blake2b *b2, const char *s)
+{
+    if(s == NULL) {
+        hash_unsigned(b2, 0);
+        return;
+    }
+    hash_unsigned(b2, strlen(s) + 1);
+    blake2b_update(b2, s, strlen(s));
+}
+
+static void hash_point(Blake2b *b2, const double *v, int n)
+{
+    int i;
+    for(i = 0; i < n; i++) {
+        hash_double(b2, v[i]);
+    }
+}
+
+static void hash_axis(Blake2b *b2, const Axis *axis)
+{
+    hash_double(b2, axis->max_feedrate);
+    hash_double(b2, axis->max_accel);
+    hash_double(b2, axis->max_speed_change);
+    hash_double(b2, axis->home_feedrate);
+    hash_double(b2, axis->length);
+    hash_double(b2, axis->steps_per_mm);
+    hash_unsigned(b2, axis->endstop);
+}
+
+static void hash_extruder(Blake2b *b2, const Extruder *extruder)
+{
+    hash_double(b2, extruder->max_feedrate);
+    hash_double(b2, extruder->max_accel);
+    hash_double(b2, extruder->max_speed_change);
+    hash_double(b2, extruder->steps_per_mm);
+    hash_double(b2, extruder->motor_steps);
+    hash_unsigned(b2, extruder->has_heated_build_platform);
+}
+
+void cache_hash_settings(Blake2b *b2, const Gpx *gpx)
+{
+    const Machine *m = &gpx->machine;
+    int i;
+
+    hash_string(b2, PACKAGE_VERSION);
+    hash_unsigned(b2, CACHE_FORMAT);
+
+    // the machine definition
+    hash_string(b2, m->type);
+    hash_axis(b2, &m->x);
+    hash_axis(b2, &m->y);
+    hash_axis(b2, &m->z);
+    hash_extruder(b2, &m->a);
+    hash_extruder(b2, &m->b);
+    hash_double(b2, m->nominal_filament_diameter);
+    hash_double(b2, m->nominal_packing_density);
+    hash_double(b2, m->nozzle_diameter);
+    hash_point(b2, m->toolhead_offsets, 3);
+    hash_point(b2, m->jkn, 2);
+    hash_unsigned(b2, m->extruder_count);
+    hash_unsigned(b2, m->timeout);
+    hash_unsigned(b2, m->id);
+
+    // offset and scale
+    hash_point(b2, &gpx->user.offset.x, 3);
+    hash_double(b2, gpx->user.scale);
+
+    // the macros from the ini files
+    for(i = 0; i < gpx->filamentLength; i++) {
+        const Filament *f = gpx->filament + i;
+        hash_string(b2, f->colour);
+        hash_double(b2, f->diameter);
+        hash_unsigned(b2, f->temperature);
+        hash_unsigned(b2, f->LED);
+    }
+    hash_unsigned(b2, gpx->eepromMap != NULL);
+    hash_unsigned(b2, gpx->eepromMappingVector ? gpx->eepromMappingVector->c : 0);
+
+    // the build name, start and end
+    hash_string(b2, gpx->preamble);
+    hash_unsigned(b2, gpx->nostart);
+    hash_unsigned(b2, gpx->noend);
+    hash_string(b2, gpx->buildName);
+
+    // the flags that change the x3g but not as the gcode is converted, not
+    // those that only change how or where it's written
+    hash_unsigned(b2, gpx->flag.verboseMode);
+    hash_unsigned(b2, gpx->flag.rewrite5D);
+    hash_unsigned(b2, gpx->flag.M106AlwaysValve);
+    hash_unsigned(b2, gpx->flag.framingEnabled);
+    hash_unsigned(b2, gpx->flag.fixedPoint);
+
+    // conversion settings
+    hash_double(b2, gpx->coalesce.tolerance);
+    hash_unsigned(b2, gpx->planner.window);
+    hash_double(b2, gpx->resume.z);
+    hash_unsigned(b2, gpx->resume.line);
+    hash_double(b2, gpx->resume.hop);
+}
+
+void cache_hash_config(Blake2b *b2, const Gpx *gpx)
+{
+    int i;
+
+    cache_hash_settings(b2, gpx);
+
+    // overrides and offsets
+    for(i = 0; i < 2; i++) {
+        const Override *o = gpx->override + i;
+        hash_double(b2, o->actual_filament_diameter);
+        hash_double(b2, o->filament_scale);
+        hash_double(b2, o->packing_density);
+        hash_unsigned(b2, o->standby_temperature);
+        hash_unsigned(b2, o->active_temperature);
+        hash_unsigned(b2, o->build_platform_temperature);
+        hash_unsigned(b2, o->extrusion_factor);
+        hash_unsigned(b2, gpx->tool[i].motor_enabled);
+        hash_unsigned(b2, gpx->tool[i].nozzle_temperature);
+        hash_unsigned(b2, gpx->tool[i].build_platform_temperature);
+        hash_unsigned(b2, (unsigned long)(gpx->tool[i].fan + 1));
+        hash_unsigned(b2, (unsigned long)(gpx->tool[i].valve + 1));
+    }
+    for(i = 0; i < 7; i++) {
+        hash_point(b2, &gpx->offset[i].x, 3);
+    }
+
+    // where the conversion starts from
+    hash_point(b2, &gpx->current.position.x, 5);
+    hash_double(b2, gpx->current.feedrate);
+    hash_unsigned(b2, gpx->current.extruder);
+    hash_unsigned(b2, gpx->current.offset);
+    hash_unsigned(b2, gpx->current.percent);
+    hash_unsigned(b2, gpx->current.speed_factor);
+    hash_unsigned(b2, gpx->axis.positionKnown);
+    hash_unsigned(b2, gpx->axis.mask);
+    hash_point(b2, &gpx->excess.a, 2);
+    hash_double(b2, gpx->layerHeight);
+    for(i = 0; i < gpx->commandAtLength; i++) {
+        const CommandAt *c = gpx->commandAt + i;
+        hash_double(b2, c->z);
+        hash_unsigned(b2, c->filament_index);
+        hash_unsigned(b2, c->nozzle_temperature);
+        hash_unsigned(b2, c->build_platform_temperature);
+    }
+    hash_unsigned(b2, gpx->commandAtLength);
+    hash_unsigned(b2, gpx->commandAtIndex);
+    hash_double(b2, gpx->commandAtZ);
+
+    // the flags the gcode can change
+    hash_unsigned(b2, gpx->flag.relativeCoordinates);
+    hash_unsigned(b2, gpx->flag.extruderIsRelative);
+    hash_unsigned(b2, gpx->flag.reprapFlavor);
+    hash_unsigned(b2, gpx->flag.dittoPrinting);
+    hash_unsigned(b2, gpx->flag.buildProgress);
+    hash_unsigned(b2, gpx->flag.onlyExplicitToolChange);
+    hash_unsigned(b2, gpx->flag.programState);
+    hash_unsigned(b2, gpx->flag.doPauseAtZPos);
+    hash_unsigned(b2, gpx->flag.pausePending);
+    hash_unsigned(b2, gpx->flag.macrosEnabled);
+    hash_unsigned(b2, gpx->flag.loadMacros);
+    hash_unsigned(b2, gpx->flag.runMacros);
+    hash_unsigned(b2, gpx->flag.ignoreAbsoluteMoves);
+}
+
+// ENTRIES
+
+typedef struct tCacheHeader {
+    char key[2 * HASH_SIZE + 1];
+    char x3g[2 * HASH_SIZE + 1];    // BLAKE2b of the x3g
+    unsigned long bytes;
+    unsigned long commands;
+    unsigned lines;
+    double length;
+    double time;
+    double a;
+    double b;
+} CacheHeader;
+
+// the header is a line of text padded to CACHE_HEADER_SIZE, doubles are
+// written in hex so they read back exactly
+
+#define HEADER_FORMAT "gpx-cache %d %64s %64s %lu %lu %u %la %la %la %la"
+
+static int read_header(FILE *fp, CacheHeader *h)
+{
+    char header[CACHE_HEADER_SIZE + 1];
+    int format;
+    if(fread(header, 1, CACHE_HEADER_SIZE, fp) != CACHE_HEADER_SIZE) return ERROR;
+    header[CACHE_HEADER_SIZE] = 0;
+    if(sscanf(header, HEADER_FORMAT, &format, h->key, h->x3g, &h->bytes, &h->commands, &h->lines,
+              &h->length, &h->time, &h->a, &h->b) != 10
+       || format != CACHE_FORMAT) return ERROR;
+    return SUCCESS;
+}
+
+static int write_header(FILE *fp, const CacheHeader *h)
+{
+    char header[CACHE_HEADER_SIZE + 1];
+    int n = snprintf(header, sizeof(header), HEADER_FORMAT, CACHE_FORMAT, h->key, h->x3g,
+                     h->bytes, h->commands, h->lines, h->length, h->time, h->a, h->b);
+    if(n < 0 || n >= CACHE_HEADER_SIZE) return ERROR;
+    memset(header + n, ' ', CACHE_HEADER_SIZE - 1 - n);
+    header[CACHE_HEADER_SIZE - 1] = '\n';
+    if(fseek(fp, 0, SEEK_SET) != 0) return ERROR;
+    return fwrite(header, 1, CACHE_HEADER_SIZE, fp) == CACHE_HEADER_SIZE ? SUCCESS : ERROR;
+}
+
+// the BLAKE2b of the x3g after the header, which must be length bytes
+
+static int hash_x3g(FILE *fp, unsigned long length, char hex[2 * HASH_SIZE + 1])
+{
+    char buffer[8192];
+    unsigned char digest[HASH_SIZE];
+    unsigned long total = 0;
+    size_t n;
+    Blake2b b2;
+    if(fseek(fp, CACHE_HEADER_SIZE, SEEK_SET) != 0) return ERROR;
+    blake2b_init(&b2);
+    while((n = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+        blake2b_update(&b2, buffer, n);
+        total += n;
+    }
+    if(ferror(fp) || total != length) return ERROR;
+    blake2b_final(&b2, digest);
+    hex_digest(digest, hex);
+    return SUCCESS;
+}
+
+static char *entry_path(const char *dir, const char *name, const char *suffix)
+{
+    char *path = malloc(strlen(dir) + strlen(name) + strlen(suffix) + 2);
+    if(path) sprintf(path, "%s%c%s%s", dir, PATH_DELIM, name, suffix);
+    return path;
+}
+
+static FILE *create_temp(char **temp, const char *dir, const char *key)
+{
+#if !defined(_WIN32) && !defined(_WIN64)
+    int fd;
+    if((*temp = entry_path(dir, key, ".XXXXXX")) == NULL) return NULL;
+    mkdir(dir, 0777);
+    fd = mkstemp(*temp);
+    if(fd < 0) return NULL;
+    return fdopen(fd, "w+b");
+#else
+    if((*temp = entry_path(dir, key, ".XXXXXX")) == NULL) return NULL;
+    mkdir(dir);
+    if(_mktemp(*temp) == NULL) return NULL;
+    return fopen(*temp, "w+b");
+#endif
+}
+
+int cache_open(Gpx *gpx, const unsigned char key[HASH_SIZE], CacheEntry *entry, int create)
+{
+    char name[2 * HASH_SIZE + 1];
+    CacheHeader h;
+    struct stat st;
+
+    memset(entry, 0, sizeof(CacheEntry));
+    hex_digest(key, name);
+    if((entry->path = entry_path(gpx->cache.dir, name, CACHE_EXTENSION)) == NULL) return ERROR;
+
+    entry->file = fopen(entry->path, "rb");
+    if(entry->file) {
+        // a damaged entry is a miss that replaces it
+        if(read_header(entry->file, &h) == SUCCESS
+           && strcmp(h.key, name) == 0
+           && fstat(fileno(entry->file), &st) == 0
+           && (unsigned long)st.st_size == CACHE_HEADER_SIZE + h.bytes) {
+            gpx->total.length = h.length;
+            gpx->total.time = gpx->accumulated.time = h.time;
+            gpx->total.bytes = gpx->accumulated.bytes = h.bytes;
+            gpx->total.commands = gpx->accumulated.commands = h.commands;
+            gpx->accumulated.a = h.a;
+            gpx->accumulated.b = h.b;
+            gpx->lineNumber = h.lines;
+            // the modification time is the last use
+            utime(entry->path, NULL);
+            return SUCCESS;
+        }
+        fclose(entry->file);
+        entry->file = NULL;
+    }
+    if(create) {
+        blake2b_init(&entry->x3g);
+        entry->file = create_temp(&entry->temp, gpx->cache.dir, name);
+        if(entry->file && fseek(entry->file, CACHE_HEADER_SIZE, SEEK_SET) != 0) {
+            fclose(entry->file);
+            entry->file = NULL;
+        }
+    }
+    return END_OF_FILE;
+}
+
+// EVICTION
+
+typedef struct tCached {
+    char *path;
+    unsigned long long size;
+    time_t used;
+} Cached;
+
+static int compare_used(const void *a, const void *b)
+{
+    const Cached *ca = a, *cb = b;
+    return ca->used < cb->used ? -1 : ca->used > cb->used;
+}
+
+static int has_extension(const char *name, const char *extension)
+{
+    size_t n = strlen(name), e = strlen(extension);
+    return n > e && strcmp(name + n - e, extension) == 0;
+}
+
+static int is_entry(const char *name)
+{
+    return has_extension(name, CACHE_EXTENSION) || has_extension(name, CHECKPOINT_EXTENSION);
+}
+
+// remove the least recently used entries and checkpoints other than those of
+// keep until they take at most size bytes
+
+static void cache_evict(const char *dir, unsigned long long size, const CacheEntry *keep)
+{
+#ifdef HAVE_DIRENT_H
+    DIR *d = opendir(dir);
+    struct dirent *de;
+    struct stat st;
+    Cached *cached = NULL;
+    unsigned count = 0, allocated = 0, i;
+    unsigned long long total = 0;
+
+    if(d == NULL) return;
+    while((de = readdir(d)) != NULL) {
+        char *path;
+        if(!is_entry(de->d_name)) continue;
+        if((path = entry_path(dir, de->d_name, "")) == NULL) break;
+        if(strcmp(path, keep->path) == 0 || (keep->sidecar && strcmp(path, keep->sidecar) == 0)) {
+            free(path);
+            continue;
+        }
+        if(stat(path, &st) != 0) {
+            free(path);
+            continue;
+        }
+        if(count == allocated) {
+            Cached *grown = realloc(cached, (allocated ? allocated * 2 : 64) * sizeof(Cached));
+            if(grown == NULL) {
+                free(path);
+                break;
+            }
+            cached = grown;
+            allocated = allocated ? allocated * 2 : 64;
+        }
+        cached[count].path = path;
+        cached[count].size = (unsigned long long)st.st_size;
+        cached[count].used = st.st_mtime;
+        total += cached[count++].size;
+    }
+    closedir(d);
+    // the entry kept counts towards size but is never removed
+    if(stat(keep->path, &st) == 0) total += (unsigned long long)st.st_size;
+    if(keep->sidecar && stat(keep->sidecar, &st) == 0) total += (unsigned long long)st.st_size;
+    if(total > size) {
+        qsort(cached, count, sizeof(Cached), compare_used);
+        for(i = 0; i < count && total > size; i++) {
+            if(remove(cached[i].path) == 0) total -= cached[i].size;
+        }
+    }
+    for(i = 0; i < count; i++) {
+        free(cached[i].path);
+    }
+    free(cached);
+#endif
+}
+
+int cache_store(Gpx *gpx, CacheEntry *entry)
+{
+    CacheHeader h;
+    unsigned char digest[HASH_SIZE];
+    const char *leaf = strrchr(entry->path, PATH_DELIM) + 1;
+    FILE *fp = entry->file;
+    struct stat st;
+
+    if(fp == NULL) return ERROR;
+    entry->file = NULL;
+    memcpy(h.key, leaf, 2 * HASH_SIZE);
+    h.key[2 * HASH_SIZE] = 0;
+    h.bytes = gpx->total.bytes;
+    h.commands = gpx->total.commands;
+    h.lines = gpx->lineNumber;
+    h.length = gpx->total.length;
+    h.time = gpx->total.time;
+    h.a = gpx->accumulated.a;
+    h.b = gpx->accumulated.b;
+    blake2b_final(&entry->x3g, digest);
+    hex_digest(digest, h.x3g);
+    // the x3g was hashed as it was written, so only its length is checked
+    if(fflush(fp) != 0
+       || fstat(fileno(fp), &st) != 0
+       || (unsigned long)st.st_size != CACHE_HEADER_SIZE + h.bytes
+       || write_header(fp, &h) != SUCCESS) {
+        fclose(fp);
+        return ERROR;
+    }
+    if(fclose(fp) != 0) return ERROR;
+#if defined(_WIN32) || defined(_WIN64)
+    remove(entry->path);
+#endif
+    if(rename(entry->temp, entry->path) != 0) return ERROR;
+    free(entry->temp);
+    entry->temp = NULL;
+    cache_evict(gpx->cache.dir, gpx->cache.size, entry);
+    return SUCCESS;
+}
+
+void cache_close(CacheEntry *entry)
+{
+    if(entry->file) fclose(entry->file);
+    if(entry->temp) remove(entry->temp);
+    free(entry->temp);
+    free(entry->path);
+    free(entry->sidecar);
+    free(entry->chunk);
+    memset(entry, 0, sizeof(CacheEntry));
+}
+
+// SERIALIZATION
+
+// values are written little endian whatever the machine, so checkpoints
+// read back the same anywhere
+
+static void put_bytes(Bytes *b, const void *data, size_t length)
+{
+    if(b->failed) return;
+    if(b->length + length > b->size) {
+        size_t size = b->size ? b->size : 4096;
+        unsigned char *grown;
+        while(size < b->length + length) size *= 2;
+        if((grown = realloc(b->data, size)) == NULL) {
+            b->failed = 1;
+            return;
+        }
+        b->data = grown;
+        b->size = size;
+    }
+    memcpy(b->data + b->length, data, length);
+    b->length += length;
+}
+
+static void put_u64(Bytes *b, uint64_t value)
+{
+    unsigned char le[8];
+    int i;
+    for(i = 0; i < 8; i++) {
+        le[i] = (unsigned char)(value >> (8 * i));
+    }
+    put_bytes(b, le, 8);
+}
+
+// LEB128, small numbers take a byte
+
+static void put_varint(Bytes *b, uint64_t value)
+{
+    unsigned char v[10];
+    int n = 0;
+    while(value >= 0x80) {
+        v[n++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    v[n++] = (unsigned char)value;
+    put_bytes(b, v, n);
+}
+
+// differences that could go either way, zigzag encoded so small ones stay small
+
+static void put_delta(Bytes *b, uint64_t value, uint64_t from)
+{
+    int64_t delta = (int64_t)(value - from);
+    put_varint(b, ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63));
+}
+
+static void put_double(Bytes *b, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(double));
+    put_u64(b, bits);
+}
+
+typedef struct tReader {
+    const unsigned char *p;
+    const unsigned char *end;
+    int failed;                 // ran out of data
+} Reader;
+
+static void get_bytes(Reader *r, void *data, size_t length)
+{
+    if(r->failed || (size_t)(r->end - r->p) < length) {
+        r->failed = 1;
+        memset(data, 0, length);
+        return;
+    }
+    memcpy(data, r->p, length);
+    r->p += length;
+}
+
+static uint64_t get_u64(Reader *r)
+{
+    unsigned char le[8];
+    uint64_t value = 0;
+    int i;
+    get_bytes(r, le, 8);
+    for(i = 7; i >= 0; i--) {
+        value = value << 8 | le[i];
+    }
+    return value;
+}
+
+static uint64_t get_varint(Reader *r)
+{
+    uint64_t value = 0;
+    int shift = 0;
+    unsigned char v;
+    do {
+        get_bytes(r, &v, 1);
+        if(shift < 64) value |= (uint64_t)(v & 0x7f) << shift;
+        shift += 7;
+    } while(v & 0x80 && !r->failed);
+    return value;
+}
+
+static uint64_t get_delta(Reader *r, uint64_t from)
+{
+    uint64_t zigzag = get_varint(r);
+    return from + ((zigzag >> 1) ^ (0 - (zigzag & 1)));
+}
+
+static double get_double(Reader *r)
+{
+    uint64_t bits = get_u64(r);
+    double value;
+    memcpy(&value, &bits, sizeof(double));
+    return value;
+}
+
+// SNAPSHOTS
+
+// the state is visited in the same order to write it out and read it back
+
+typedef struct tVisit {
+    Bytes *out;                 // writing to out, or
+    Reader *in;                 // reading from in
+} Visit;
+
+static void visit_double(Visit *v, double *value)
+{
+    if(v->out) put_double(v->out, *value);
+    else *value = get_double(v->in);
+}
+
+static void visit_point(Visit *v, double *value, int n)
+{
+    int i;
+    for(i = 0; i < n; i++) {
+        visit_double(v, value + i);
+    }
+}
+
+static void visit_unsigned(Visit *v, unsigned *value)
+{
+    if(v->out) put_u64(v->out, *value);
+    else *value = (unsigned)get_u64(v->in);
+}
+
+static void visit_int(Visit *v, int *value)
+{
+    if(v->out) put_u64(v->out, (uint64_t)(int64_t)*value);
+    else *value = (int)(int64_t)get_u64(v->in);
+}
+
+#define VISIT_FLAG(v, gpx, name) { \
+    unsigned value = gpx->flag.name; \
+    visit_unsigned(v, &value); \
+    if(v->in) gpx->flag.name = value; }
+
+// only the parameters the command has are part of the state, the rest are
+// left over from earlier lines
+
+static void visit_command(Visit *v, Command *command)
+{
+    static const int bit[12] = {
+        X_IS_SET, Y_IS_SET, Z_IS_SET, A_IS_SET, B_IS_SET, E_IS_SET,
+        F_IS_SET, I_IS_SET, J_IS_SET, P_IS_SET, R_IS_SET, S_IS_SET
+    };
+    double *value[12];
+    unsigned *code[3] = { &command->g, &command->m, &command->t };
+    static const int codeBit[3] = { G_IS_SET, M_IS_SET, T_IS_SET };
+    int i;
+
+    value[0] = &command->x; value[1] = &command->y; value[2] = &command->z;
+    value[3] = &command->a; value[4] = &command->b; value[5] = &command->e;
+    value[6] = &command->f; value[7] = &command->i; value[8] = &command->j;
+    value[9] = &command->p; value[10] = &command->r; value[11] = &command->s;
+    visit_int(v, &command->flag);
+    for(i = 0; i < 12; i++) {
+        double unset = 0.0;
+        visit_double(v, command->flag & bit[i] ? value[i] : &unset);
+    }
+    for(i = 0; i < 3; i++) {
+        unsigned unset = 0;
+        visit_unsigned(v, command->flag & codeBit[i] ? code[i] : &unset);
+    }
+    if(v->in) {
+        command->flag &= ~(COMMENT_IS_SET | ARG_IS_SET);
+        command->comment = NULL;
+        command->arg = NULL;
+    }
+}
+
+static void visit_segment(Visit *v, Segment *s)
+{
+    visit_point(v, &s->unit.x, 5);
+    visit_double(v, &s->length);
+    visit_double(v, &s->nominal);
+    visit_double(v, &s->acceleration);
+    visit_double(v, &s->max_entry);
+    visit_double(v, &s->bound);
+    visit_double(v, &s->entry);
+    visit_double(v, &s->time);
+}
+
+// everything the gcode changes as it's converted other than the totals
+// that only add up (bytes, commands, lines), what's in the settings hash and
+// the @pause and @temp commands, which a conversion keeps its own of
+
+static void visit_state(Visit *v, Gpx *gpx)
+{
+    Coalesce *c = &gpx->coalesce;
+    Planner *p = &gpx->planner;
+    unsigned i;
+
+    visit_point(v, &gpx->target.position.x, 5);
+    visit_int(v, &gpx->target.extruder);
+    visit_point(v, &gpx->current.position.x, 5);
+    visit_double(v, &gpx->current.feedrate);
+    visit_int(v, &gpx->current.extruder);
+    visit_int(v, &gpx->current.offset);
+    visit_unsigned(v, &gpx->current.percent);
+    visit_unsigned(v, &gpx->current.speed_factor);
+    visit_unsigned(v, &gpx->axis.positionKnown);
+    visit_unsigned(v, &gpx->axis.mask);
+    visit_point(v, &gpx->excess.a, 2);
+    for(i = 0; i < 7; i++) {
+        visit_point(v, &gpx->offset[i].x, 3);
+    }
+
+    // tools and overrides
+    for(i = 0; i < 2; i++) {
+        Tool *t = gpx->tool + i;
+        Override *o = gpx->override + i;
+        visit_unsigned(v, &t->motor_enabled);
+#if ENABLE_SIMULATED_RPM
+        visit_unsigned(v, &t->rpm);
+#endif
+        visit_unsigned(v, &t->nozzle_temperature);
+        visit_unsigned(v, &t->build_platform_temperature);
+        visit_int(v, &t->fan);
+        visit_int(v, &t->valve);
+        visit_double(v, &o->actual_filament_diameter);
+        visit_double(v, &o->filament_scale);
+        visit_double(v, &o->packing_density);
+        visit_unsigned(v, &o->standby_temperature);
+        visit_unsigned(v, &o->active_temperature);
+        visit_unsigned(v, &o->build_platform_temperature);
+        visit_unsigned(v, &o->extrusion_factor);
+    }
+
+    // the flags the gcode can change
+    VISIT_FLAG(v, gpx, relativeCoordinates);
+    VISIT_FLAG(v, gpx, extruderIsRelative);
+    VISIT_FLAG(v, gpx, reprapFlavor);
+    VISIT_FLAG(v, gpx, dittoPrinting);
+    VISIT_FLAG(v, gpx, buildProgress);
+    VISIT_FLAG(v, gpx, onlyExplicitToolChange);
+    VISIT_FLAG(v, gpx, programState);
+    VISIT_FLAG(v, gpx, doPauseAtZPos);
+    VISIT_FLAG(v, gpx, pausePending);
+    VISIT_FLAG(v, gpx, macrosEnabled);
+    VISIT_FLAG(v, gpx, loadMacros);
+    VISIT_FLAG(v, gpx, runMacros);
+    VISIT_FLAG(v, gpx, needSecondPass);
+    VISIT_FLAG(v, gpx, ignoreAbsoluteMoves);
+    visit_double(v, &gpx->layerHeight);
+
+    // motion constants
+    visit_point(v, &gpx->motion.steps_per_mm.x, 5);
+    visit_double(v, &gpx->motion.max_feedrate);
+    visit_double(v, &gpx->motion.speed_scale);
+    visit_int(v, &gpx->motion.longest_dda);
+    for(i = 0; i < 2; i++) {
+        visit_double(v, &gpx->motion.extruder[i].extrusion_scale);
+        visit_double(v, &gpx->motion.extruder[i].packing_area);
+        visit_double(v, &gpx->motion.extruder[i].packing_scale);
+        visit_double(v, &gpx->motion.extruder[i].max_rpm);
+        visit_double(v, &gpx->motion.extruder[i].mm_per_revolution);
+    }
+
+    // sums that have to match exactly for the x3g and its build progress
+    // to, floating point addition isn't associative
+    visit_double(v, &gpx->accumulated.time);
+    visit_double(v, &gpx->accumulated.a);
+    visit_double(v, &gpx->accumulated.b);
+
+    // moves held back
+    visit_int(v, &c->anchored);
+    visit_int(v, &c->anchorHasE);
+    visit_int(v, &c->extruding);
+    visit_unsigned(v, &c->count);
+    if(v->in && c->count > COALESCE_WINDOW) {
+        v->in->failed = 1;
+        c->count = 0;
+    }
+    for(i = 0; i <= c->count; i++) {
+        visit_double(v, &c->point[i].x);
+        visit_double(v, &c->point[i].y);
+        visit_double(v, &c->point[i].e);
+    }
+    if(c->count) visit_command(v, &c->pending);
+
+    // the planner's window from its oldest move
+    visit_unsigned(v, &p->count);
+    if(v->in && p->count > PLANNER_WINDOW_MAX) {
+        v->in->failed = 1;
+        p->count = 0;
+    }
+    if(v->in) p->head = 0;
+    for(i = 0; i < p->count; i++) {
+        visit_segment(v, p->segment + (p->head + i) % PLANNER_WINDOW_MAX);
+    }
+}
+
+void checkpoint_snapshot(Bytes *state, const Gpx *gpx)
+{
+    Visit v;
+    v.out = state;
+    v.in = NULL;
+    // only read from when writing
+    visit_state(&v, (Gpx *)gpx);
+}
+
+int checkpoint_restore(Gpx *gpx, const unsigned char *state, size_t size)
+{
+    Reader r;
+    Visit v;
+    r.p = state;
+    r.end = state + size;
+    r.failed = 0;
+    v.out = NULL;
+    v.in = &r;
+    visit_state(&v, gpx);
+    return r.failed || r.p != r.end ? ERROR : SUCCESS;
+}
+
+void checkpoint_hash_pauses(const Gpx *gpx, unsigned first, unsigned last, int pending, unsigned char digest[HASH_SIZE])
+{
+    Blake2b b2;
+    unsigned i;
+    blake2b_init(&b2);
+    if(pending) last++;
+    for(i = first; i < last && i < (unsigned)gpx->commandAtLength; i++) {
+        const CommandAt *c = gpx->commandAt + i;
+        hash_double(&b2, c->z);
+        hash_unsigned(&b2, c->filament_index);
+        hash_unsigned(&b2, c->nozzle_temperature);
+        hash_unsigned(&b2, c->build_platform_temperature);
+    }
+    hash_unsigned(&b2, last - first);
+    if(pending) hash_unsigned(&b2, last <= (unsigned)gpx->commandAtLength);
+    blake2b_final(&b2, digest);
+}
+
+// CHECKPOINTS
+
+Checkpoint *checkpoint_add(Checkpoints *c)
+{
+    if(c->count == c->size) {
+        unsigned size = c->size ? c->size * 2 : 256;
+        Checkpoint *grown = realloc(c->checkpoint, size * sizeof(Checkpoint));
+        if(grown == NULL) return NULL;
+        c->checkpoint = grown;
+        c->size = size;
+    }
+    memset(c->checkpoint + c->count, 0, sizeof(Checkpoint));
+    return c->checkpoint + c->count++;
+}
+
+// the sidecar is the x3g, then the marks, checkpoints and snapshots, then a
+// trailer of CACHE_HEADER_SIZE bytes of text like the header of an entry.
+// Only the x3g of the spans is ever copied, so only that is hashed.
+
+#define TRAILER_FORMAT "gpx-checkpoints %d %64s %64s %lu %lu %u %u"
+
+typedef struct tTrailer {
+    char base[2 * HASH_SIZE + 1];
+    char table[2 * HASH_SIZE + 1];  // BLAKE2b of what follows the x3g
+    unsigned long bytes;
+    unsigned long length;       // of the rest
+    unsigned count;
+    unsigned marks;
+} Trailer;
+
+// there's a progress mark for nearly every command, so each is written as
+// the difference from the one before
+
+#define MARK_SIZE_MIN 14
+
+static void write_table(Bytes *b, Checkpoints *c, vector *marks)
+{
+    unsigned long offset = 0, commands = 0;
+    unsigned i;
+    for(i = 0; marks && i < (unsigned)marks->c; i++) {
+        ProgressMark *pm = vector_get(marks, i);
+        put_delta(b, pm->offset, offset);
+        put_delta(b, pm->commands, commands);
+        put_varint(b, (uint64_t)pm->type);
+        put_varint(b, pm->percent);
+        put_varint(b, pm->force);
+        put_varint(b, pm->extruder);
+        put_double(b, pm->time);
+        offset = pm->offset;
+        commands = pm->commands;
+    }
+    for(i = 0; i < c->count; i++) {
+        Checkpoint *cp = c->checkpoint + i;
+        put_u64(b, cp->input);
+        put_u64(b, cp->line);
+        put_u64(b, cp->bytes);
+        put_u64(b, cp->commands);
+        put_u64(b, cp->lineNumber);
+        put_u64(b, cp->eliminated);
+        put_u64(b, cp->marks);
+        put_u64(b, cp->state);
+        put_u64(b, cp->size);
+        put_bytes(b, cp->settings, HASH_SIZE);
+        put_u64(b, cp->commandAtIndex);
+        put_u64(b, cp->commandAtLength);
+        put_u64(b, cp->length);
+        put_bytes(b, cp->gcode, HASH_SIZE);
+        put_bytes(b, cp->pauses, HASH_SIZE);
+        put_bytes(b, cp->x3g, HASH_SIZE);
+        put_double(b, cp->reached);
+        put_u64(b, cp->pending);
+        put_u64(b, cp->reusable);
+        put_u64(b, cp->ended);
+    }
+    put_bytes(b, c->state.data, c->state.length);
+}
+
+static int read_table(Reader *r, Checkpoints *c, const Trailer *t)
+{
+    unsigned long offset = 0, commands = 0;
+    unsigned i;
+    // a damaged count can't ask for more than there is
+    if(t->marks > t->length / MARK_SIZE_MIN || t->count > t->length / 200) return ERROR;
+    if(t->marks && (c->mark = malloc(t->marks * sizeof(ProgressMark))) == NULL) return ERROR;
+    c->marks = t->marks;
+    for(i = 0; i < c->marks; i++) {
+        ProgressMark *pm = c->mark + i;
+        pm->offset = offset = (unsigned long)get_delta(r, offset);
+        pm->commands = commands = (unsigned long)get_delta(r, commands);
+        pm->type = (int)get_varint(r);
+        pm->percent = (unsigned)get_varint(r);
+        pm->force = (unsigned)get_varint(r);
+        pm->extruder = (unsigned)get_varint(r);
+        pm->time = get_double(r);
+    }
+    for(i = 0; i < t->count; i++) {
+        Checkpoint *cp = checkpoint_add(c);
+        if(cp == NULL) return ERROR;
+        cp->input = (unsigned long)get_u64(r);
+        cp->line = get_u64(r);
+        cp->bytes = (unsigned long)get_u64(r);
+        cp->commands = (unsigned long)get_u64(r);
+        cp->lineNumber = (unsigned)get_u64(r);
+        cp->eliminated = (unsigned long)get_u64(r);
+        cp->marks = (unsigned)get_u64(r);
+        cp->state = (unsigned long)get_u64(r);
+        cp->size = (unsigned long)get_u64(r);
+        get_bytes(r, cp->settings, HASH_SIZE);
+        cp->commandAtIndex = (unsigned)get_u64(r);
+        cp->commandAtLength = (unsigned)get_u64(r);
+        cp->length = (unsigned long)get_u64(r);
+        get_bytes(r, cp->gcode, HASH_SIZE);
+        get_bytes(r, cp->pauses, HASH_SIZE);
+        get_bytes(r, cp->x3g, HASH_SIZE);
+        cp->reached = get_double(r);
+        cp->pending = (int)get_u64(r);
+        cp->reusable = (int)get_u64(r);
+        cp->ended = (int)get_u64(r);
+    }
+    if(r->failed) return ERROR;
+    put_bytes(&c->state, r->p, r->end - r->p);
+    if(c->state.failed) return ERROR;
+    // everything has to be where it says it is
+    for(i = 0; i < c->count; i++) {
+        Checkpoint *cp = c->checkpoint + i;
+        if(cp->state + cp->size > c->state.length || cp->marks > c->marks || cp->bytes > t->bytes) return ERROR;
+    }
+    return c->count ? SUCCESS : ERROR;
+}
+
+static int read_trailer(FILE *fp, Trailer *t)
+{
+    char trailer[CACHE_HEADER_SIZE + 1];
+    int format;
+    struct stat st;
+    if(fstat(fileno(fp), &st) != 0 || st.st_size < CACHE_HEADER_SIZE) return ERROR;
+    if(fseek(fp, (long)st.st_size - CACHE_HEADER_SIZE, SEEK_SET) != 0
+       || fread(trailer, 1, CACHE_HEADER_SIZE, fp) != CACHE_HEADER_SIZE) return ERROR;
+    trailer[CACHE_HEADER_SIZE] = 0;
+    if(sscanf(trailer, TRAILER_FORMAT, &format, t->base, t->table,
+              &t->bytes, &t->length, &t->count, &t->marks) != 7
+       || format != CACHE_FORMAT
+       || (unsigned long)st.st_size != t->bytes + t->length + CACHE_HEADER_SIZE) return ERROR;
+    return SUCCESS;
+}
+
+// hash length bytes of fp from offset
+
+static int hash_span(FILE *fp, unsigned long offset, unsigned long length, unsigned char digest[HASH_SIZE])
+{
+    char buffer[8192];
+    Blake2b b2;
+    if(fseek(fp, (long)offset, SEEK_SET) != 0) return ERROR;
+    blake2b_init(&b2);
+    while(length) {
+        size_t n = length < sizeof(buffer) ? length : sizeof(buffer);
+        if(fread(buffer, 1, n, fp) != n) return ERROR;
+        blake2b_update(&b2, buffer, n);
+        length -= n;
+    }
+    blake2b_final(&b2, digest);
+    return SUCCESS;
+}
+
+// read the rest after the x3g into memory, checking it against its hash
+// when verifying
+
+static int read_rest(FILE *fp, const Trailer *t, unsigned char **rest, int verify)
+{
+    unsigned char digest[HASH_SIZE];
+    char hex[2 * HASH_SIZE + 1];
+    Blake2b b2;
+    *rest = malloc(t->length ? t->length : 1);
+    if(*rest == NULL) return ERROR;
+    if(fseek(fp, (long)t->bytes, SEEK_SET) != 0
+       || fread(*rest, 1, t->length, fp) != t->length) return ERROR;
+    if(!verify) return SUCCESS;
+    blake2b_init(&b2);
+    blake2b_update(&b2, *rest, t->length);
+    blake2b_final(&b2, digest);
+    hex_digest(digest, hex);
+    return strcmp(hex, t->table) == 0 ? SUCCESS : ERROR;
+}
+
+int checkpoint_open(Gpx *gpx, const CacheEntry *entry, Checkpoints *c)
+{
+    char name[2 * HASH_SIZE + 1];
+    unsigned char *rest = NULL;
+    Trailer t;
+    Reader r;
+    int rval = END_OF_FILE;
+
+    memset(c, 0, sizeof(Checkpoints));
+    hex_digest(entry->base, name);
+    if((c->path = entry_path(gpx->cache.dir, name, CHECKPOINT_EXTENSION)) == NULL) return ERROR;
+    if((c->file = fopen(c->path, "rb")) == NULL) return END_OF_FILE;
+    if(read_trailer(c->file, &t) == SUCCESS
+       && strcmp(t.base, name) == 0
+       && read_rest(c->file, &t, &rest, 0) == SUCCESS) {
+        r.p = rest;
+        r.end = rest + t.length;
+        r.failed = 0;
+        if(read_table(&r, c, &t) == SUCCESS) {
+            c->bytes = t.bytes;
+            // the modification time is the last use
+            utime(c->path, NULL);
+            rval = SUCCESS;
+        }
+    }
+    free(rest);
+    if(rval != SUCCESS) checkpoint_close(c);
+    return rval;
+}
+
+FILE *checkpoint_spool(Gpx *gpx, const CacheEntry *entry, Checkpoints *c)
+{
+    char name[2 * HASH_SIZE + 1];
+    memset(c, 0, sizeof(Checkpoints));
+    hex_digest(entry->base, name);
+    if((c->path = entry_path(gpx->cache.dir, name, CHECKPOINT_EXTENSION)) == NULL) return NULL;
+    c->file = create_temp(&c->temp, gpx->cache.dir, name);
+    return c->file;
+}
+
+int checkpoint_store(Gpx *gpx, const CacheEntry *entry, Checkpoints *c, vector *marks)
+{
+    char header[CACHE_HEADER_SIZE + 1];
+    unsigned char digest[HASH_SIZE];
+    char base[2 * HASH_SIZE + 1], table[2 * HASH_SIZE + 1];
+    Bytes b;
+    Blake2b b2;
+    FILE *fp = c->file;
+    int n;
+
+    if(fp == NULL || c->count == 0) return ERROR;
+    memset(&b, 0, sizeof(Bytes));
+    write_table(&b, c, marks);
+    if(b.failed) {
+        free(b.data);
+        return ERROR;
+    }
+    blake2b_init(&b2);
+    blake2b_update(&b2, b.data, b.length);
+    blake2b_final(&b2, digest);
+    hex_digest(digest, table);
+    hex_digest(entry->base, base);
+    n = snprintf(header, sizeof(header), TRAILER_FORMAT, CACHE_FORMAT, base, table,
+                 c->bytes, (unsigned long)b.length, c->count, marks ? (unsigned)marks->c : 0);
+    if(n < 0 || n >= CACHE_HEADER_SIZE) {
+        free(b.data);
+        return ERROR;
+    }
+    memset(header + n, ' ', CACHE_HEADER_SIZE - 1 - n);
+    header[CACHE_HEADER_SIZE - 1] = '\n';
+    // the x3g has to be all there before the rest goes after it
+    c->file = NULL;
+    if(fseek(fp, 0, SEEK_END) != 0
+       || (unsigned long)ftell(fp) != c->bytes
+       || fwrite(b.data, 1, b.length, fp) != b.length
+       || fwrite(header, 1, CACHE_HEADER_SIZE, fp) != CACHE_HEADER_SIZE) {
+        free(b.data);
+        fclose(fp);
+        return ERROR;
+    }
+    free(b.data);
+    if(fclose(fp) != 0) return ERROR;
+#if defined(_WIN32) || defined(_WIN64)
+    remove(c->path);
+#endif
+    if(rename(c->temp, c->path) != 0) return ERROR;
+    free(c->temp);
+    c->temp = NULL;
+    // the entry's sidecar, kept from eviction along with it
+    ((CacheEntry *)entry)->sidecar = strdup(c->path);
+    return SUCCESS;
+}
+
+void checkpoint_close(Checkpoints *c)
+{
+    if(c->file) fclose(c->file);
+    if(c->temp) remove(c->temp);
+    free(c->temp);
+    free(c->path);
+    free(c->checkpoint);
+    free(c->mark);
+    free(c->state.data);
+    memset(c, 0, sizeof(Checkpoints));
+}
+
+// check the rest of a sidecar and the x3g of its spans against their hashes
+
+static int verify_checkpoints(FILE *fp, const char *name)
+{
+    unsigned char hashed[HASH_SIZE];
+    unsigned char *rest = NULL;
+    Checkpoints c;
+    Trailer t;
+    Reader r;
+    unsigned i;
+    int good;
+    memset(&c, 0, sizeof(Checkpoints));
+    good = read_trailer(fp, &t) == SUCCESS
+        && strlen(name) == 2 * HASH_SIZE + strlen(CHECKPOINT_EXTENSION)
+        && strncmp(name, t.base, 2 * HASH_SIZE) == 0
+        && read_rest(fp, &t, &rest, 1) == SUCCESS;
+    if(good) {
+        r.p = rest;
+        r.end = rest + t.length;
+        r.failed = 0;
+        good = read_table(&r, &c, &t) == SUCCESS;
+    }
+    for(i = 0; good && i + 1 < c.count; i++) {
+        Checkpoint *from = c.checkpoint + i;
+        good = from[1].bytes >= from->bytes
+            && hash_span(fp, from->bytes, from[1].bytes - from->bytes, hashed) == SUCCESS
+            && memcmp(hashed, from->x3g, HASH_SIZE) == 0;
+    }
+    free(rest);
+    free(c.checkpoint);
+    free(c.mark);
+    free(c.state.data);
+    return good;
+}
+
+// VERIFICATION
+
+int cache_verify(const char *dir, FILE *log)
+{
+#ifdef HAVE_DIRENT_H
+    DIR *d = opendir(dir);
+    struct dirent *de;
+    int removed = 0;
+
+    if(d == NULL) return ERROR;
+    while((de = readdir(d)) != NULL) {
+        char hashed[2 * HASH_SIZE + 1];
+        CacheHeader h;
+        char *path;
+        FILE *fp;
+        int good = 0;
+        if(!is_entry(de->d_name)) continue;
+        if((path = entry_path(dir, de->d_name, "")) == NULL) break;
+        if((fp = fopen(path, "rb")) != NULL) {
+            if(has_extension(de->d_name, CHECKPOINT_EXTENSION))
+                good = verify_checkpoints(fp, de->d_name);
+            else
+                good = read_header(fp, &h) == SUCCESS
+                && strlen(de->d_name) == 2 * HASH_SIZE + strlen(CACHE_EXTENSION)
+                && strncmp(de->d_name, h.key, 2 * HASH_SIZE) == 0
+                && hash_x3g(fp, h.bytes, hashed) == SUCCESS
+                && strcmp(hashed, h.x3g) == 0;
+            fclose(fp);
+        }
+        if(!good) {
+            if(log) fprintf(log, "Removing damaged cache entry: %s" EOL, path);
+            if(remove(path) == 0) removed++;
+        }
+        free(path);
+    }
+    closedir(d);
+    return removed;
+#else
+    return ERROR;
+#endif
+}
@@ -0,0 +1,219 @@
+//  cache.h
+//
+//  Content addressed cache of converted x3g
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#ifndef __cache_h__
+#define __cache_h__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "gpx.h"
+
+// each entry is a file in the cache directory named by its key, the BLAKE2b
+// of the gcode and of everything in the Gpx context the x3g depends on.  It
+// holds a fixed size text header with the BLAKE2b of the x3g and the totals
+// of the conversion, then the x3g.  An entry's modification time is when it
+// was last used, the least recently used go first once the entries outgrow
+// the cache size.
+
+#define HASH_SIZE 32
+
+typedef struct tBlake2b {
+    uint64_t state[8];
+    uint64_t length;            // bytes compressed
+    unsigned char block[128];
+    size_t used;
+} Blake2b;
+
+void blake2b_init(Blake2b *b2);
+void blake2b_update(Blake2b *b2, const void *data, size_t length);
+void blake2b_final(Blake2b *b2, unsigned char digest[HASH_SIZE]);
+
+// GCODE CHUNKS
+
+// The gcode is hashed in chunks, each ending with the first line that starts
+// CHUNK_SIZE bytes or more into it and has a hash with none of the
+// CHUNK_MASK bits set, so the chunks of an edited file end in the same
+// places as before once past the edit.  The key of a conversion hashes the
+// hashes of the chunks.
+
+#define CHUNK_SIZE 65536
+#define CHUNK_MASK 0x3ff
+
+typedef struct tChunkEnd {
+    unsigned long input;        // bytes of gcode up to the end of the chunk
+    uint64_t line;              // hash of the line it ends with
+    unsigned char gcode[HASH_SIZE];     // of the chunk
+} ChunkEnd;
+
+typedef struct tChunker {
+    Blake2b *key;               // takes in the hash of each chunk
+    Blake2b gcode;              // of the chunk so far
+    uint64_t line;              // of the line so far
+    int lineStart;              // the next byte starts a line
+    int hashing;                // the line started far enough in to end the chunk
+    unsigned long pos;
+    unsigned long start;        // of the chunk
+    ChunkEnd *end;
+    unsigned count;
+    unsigned size;
+    int failed;                 // out of memory, the ends weren't all kept
+} Chunker;
+
+void chunker_init(Chunker *c, Blake2b *key);
+void chunker_update(Chunker *c, const char *data, size_t length);
+
+// end the last chunk, the ends are freed if they couldn't all be kept
+void chunker_final(Chunker *c);
+
+// CACHE
+
+#define CACHE_HEADER_SIZE 512
+#define CACHE_EXTENSION ".gpxc"
+
+typedef struct tCacheEntry {
+    char *path;                 // named by the key
+    char *temp;                 // the x3g of a miss is written here first
+    FILE *file;                 // the x3g of a hit or the temporary
+    Blake2b x3g;                // of the x3g written to the temporary
+    unsigned char base[HASH_SIZE];  // the key without the gcode, names the checkpoints
+    char *sidecar;              // the checkpoints stored with it
+    ChunkEnd *chunk;            // of the gcode, NULL if they weren't all kept
+    unsigned chunks;
+} CacheEntry;
+
+// hash everything in gpx the x3g depends on other than the gcode
+void cache_hash_config(Blake2b *b2, const Gpx *gpx);
+
+// hash the part of that a conversion doesn't change as it goes, or only
+// changes through macros: the machine, filaments, eeprom mappings, build
+// name and settings
+void cache_hash_settings(Blake2b *b2, const Gpx *gpx);
+
+// look up key in gpx->cache.dir.  A hit returns SUCCESS with the totals of
+// the conversion restored to gpx and file positioned at the x3g.  A miss
+// returns END_OF_FILE, and when create is set file is a temporary to write
+// the x3g to after CACHE_HEADER_SIZE bytes, hashing it into x3g as it goes,
+// or NULL if it couldn't be made.
+// ERROR if out of memory.
+int cache_open(Gpx *gpx, const unsigned char key[HASH_SIZE], CacheEntry *entry, int create);
+
+// keep the x3g written to the temporary of a miss as the entry, gpx holds
+// the totals of the conversion, then remove the least recently used entries
+// beyond the cache size
+int cache_store(Gpx *gpx, CacheEntry *entry);
+
+// close the entry, removing the temporary if it wasn't stored
+void cache_close(CacheEntry *entry);
+
+// check the x3g of every entry and of every span of the checkpoints in dir
+// against their hashes, removing those that don't match.  Returns the number removed or
+// ERROR if dir can't be read
+int cache_verify(const char *dir, FILE *log);
+
+// CHECKPOINTS
+
+// A conversion through the cache can also keep the x3g of its single pass,
+// before the build progress is written into it, in a sidecar named by the
+// key without the gcode, so the latest conversion with the same settings
+// replaces it.  Along the way it takes a checkpoint at the end of every
+// chunk of gcode: the offsets in the gcode and the x3g, the hashes of the
+// span of gcode and x3g since the last one and a snapshot of the conversion
+// state.
+
+#define CHECKPOINT_EXTENSION ".gpxk"
+
+typedef struct tBytes {
+    unsigned char *data;
+    size_t length;
+    size_t size;
+    int failed;                 // out of memory
+} Bytes;
+
+typedef struct tCheckpoint {
+    unsigned long input;        // bytes of gcode before it, from where the conversion started
+    uint64_t line;              // hash of the line it follows, 0 for the first
+    unsigned long bytes;        // of x3g before it
+    unsigned long commands;
+    unsigned lineNumber;
+    unsigned long eliminated;   // coalesced moves
+    unsigned marks;             // progress marks before it
+    unsigned long state;        // offset of its snapshot in the state
+    unsigned long size;         // of the snapshot
+    unsigned char settings[HASH_SIZE];
+    unsigned commandAtIndex;
+    unsigned commandAtLength;
+
+    // the span from it to the next checkpoint, the last checkpoint has none
+    unsigned long length;       // bytes of gcode
+    unsigned char gcode[HASH_SIZE];
+    unsigned char pauses[HASH_SIZE];    // of the @pause and @temp commands the span reached
+    double reached;             // highest Z moved to in the span
+    int pending;                // a command reached in the span read the next one
+    unsigned char x3g[HASH_SIZE];       // of the x3g of the span
+    int reusable;               // no macro in the span changed what isn't in the snapshot
+    int ended;                  // the gcode ended the conversion, not the end of the input
+} Checkpoint;
+
+typedef struct tCheckpoints {
+    Checkpoint *checkpoint;
+    unsigned count;
+    unsigned size;
+    Bytes state;                // the snapshots
+    ProgressMark *mark;         // of a sidecar read back
+    unsigned marks;
+    unsigned long bytes;        // of x3g spooled
+    FILE *file;                 // the sidecar
+    char *path;
+    char *temp;                 // a new sidecar is spooled here first
+} Checkpoints;
+
+// append a snapshot of the conversion state in gpx to state
+void checkpoint_snapshot(Bytes *state, const Gpx *gpx);
+
+// restore the conversion state in gpx from a snapshot
+int checkpoint_restore(Gpx *gpx, const unsigned char *state, size_t size);
+
+// hash the @pause and @temp commands from first up to last, and with
+// pending the command at last if there is one
+void checkpoint_hash_pauses(const Gpx *gpx, unsigned first, unsigned last, int pending, unsigned char digest[HASH_SIZE]);
+
+// append a checkpoint, returns NULL if out of memory
+Checkpoint *checkpoint_add(Checkpoints *c);
+
+// read the sidecar for the conversion of entry, its x3g is copied from
+// c->file.  END_OF_FILE if there is none or it's damaged, like an entry
+// only the size is checked, not the hashes.
+int checkpoint_open(Gpx *gpx, const CacheEntry *entry, Checkpoints *c);
+
+// a temporary to spool the x3g of the conversion of entry to, NULL if it
+// couldn't be made
+FILE *checkpoint_spool(Gpx *gpx, const CacheEntry *entry, Checkpoints *c);
+
+// append the checkpoints and marks to the spooled x3g and keep it as the
+// sidecar of the conversion of entry
+int checkpoint_store(Gpx *gpx, const CacheEntry *entry, Checkpoints *c, vector *marks);
+
+// close the sidecar and free the checkpoints, removing the temporary if it
+// wasn't stored
+void checkpoint_close(Checkpoints *c);
+
+#endif /* __cache_h__ */
@@ -0,0 +1,237 @@
+//  convbench.c
+//
+//  Conversion throughput benchmark, converts the given gcode with every
+//  standard machine definition and reports lines/s, MB/s and x3g commands/s.
+//  Single extruder machines convert the first file, dual extruder machines
+//  the second.  With -b each result is compared with the baseline file and
+//  any machine more than -t percent slower than its baseline fails the run.
+//  A missing baseline, or -w, records the results as the new baseline.
+//
+//  usage: convbench [-r REPEAT] [-t PERCENT] [-b BASELINE] [-w] SINGLE DUAL
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "gpx.h"
+
+#define MACHINE_ARRAY
+#include "std_machines.h"
+#undef MACHINE_ARRAY
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+#define MACHINES_MAX 64
+
+typedef struct tResult {
+    char type[16];
+    double lines;       // per second
+    double megabytes;   // per second
+    double commands;    // per second
+} Result;
+
+static int quiet_handler(Gpx *gpx, void *callbackData, const char *fmt, va_list ap)
+{
+    return SUCCESS;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// convert filename with the machine once, timing the conversion
+
+static int bench_once(Machine *machine, const char *filename, double *elapsed, Result *counts)
+{
+    int rval = ERROR;
+    double start;
+    FILE *in = fopen(filename, "r");
+    FILE *out = fopen(NULL_DEVICE, "wb");
+    Gpx *gpx = gpx_create();
+    if(in == NULL || out == NULL || gpx == NULL) {
+        perror(in == NULL ? filename : NULL_DEVICE);
+        goto L_DONE;
+    }
+    gpx->resultHandler = quiet_handler;
+    if(gpx_set_machine(gpx, machine->type, 1) != SUCCESS) {
+        fprintf(stderr, "convbench: unknown machine %s" "\n", machine->type);
+        goto L_DONE;
+    }
+    gpx_start_convert(gpx, "bench", 0, 0);
+    start = now();
+    rval = gpx_convert(gpx, in, out, NULL);
+    if(gpx_end_convert(gpx) != SUCCESS) rval = ERROR;
+    *elapsed = now() - start;
+    if(rval != SUCCESS) {
+        fprintf(stderr, "convbench: %s failed to convert %s" "\n", machine->type, filename);
+        rval = ERROR;
+        goto L_DONE;
+    }
+    counts->lines = gpx->lineNumber - 1;
+    counts->commands = gpx->total.commands;
+    counts->megabytes = ftell(in) / 1e6;
+
+L_DONE:
+    gpx_destroy(gpx);
+    if(in) fclose(in);
+    if(out) fclose(out);
+    return rval;
+}
+
+// convert filename with the machine, best of repeat runs
+
+static int bench(Machine *machine, const char *filename, int repeat, Result *result)
+{
+    Result counts;
+    double best = 0.0;
+    int i;
+
+    for(i = 0; i < repeat; i++) {
+        double elapsed;
+        if(bench_once(machine, filename, &elapsed, &counts) != SUCCESS) return ERROR;
+        if(i == 0 || elapsed < best) best = elapsed;
+    }
+    if(best <= 0.0) best = 1e-9;
+    snprintf(result->type, sizeof(result->type), "%s", machine->type);
+    result->lines = counts.lines / best;
+    result->megabytes = counts.megabytes / best;
+    result->commands = counts.commands / best;
+    return SUCCESS;
+}
+
+static int load_baseline(const char *filename, Result *baseline, int max)
+{
+    char line[256];
+    int count = 0;
+    FILE *fp = fopen(filename, "r");
+    if(fp == NULL) return -1;
+    while(count < max && fgets(line, sizeof(line), fp)) {
+        Result *r = baseline + count;
+        if(line[0] == '#') continue;
+        if(sscanf(line, "%15s %lf %lf %lf", r->type, &r->lines, &r->megabytes, &r->commands) == 4) count++;
+    }
+    fclose(fp);
+    return count;
+}
+
+static int save_baseline(const char *filename, Result *results, int count)
+{
+    int i;
+    FILE *fp = fopen(filename, "w");
+    if(fp == NULL) {
+        perror(filename);
+        return ERROR;
+    }
+    fprintf(fp, "# machine lines/s MB/s commands/s" "\n");
+    for(i = 0; i < count; i++) {
+        fprintf(fp, "%s %.0f %.3f %.0f" "\n", results[i].type, results[i].lines, results[i].megabytes, results[i].commands);
+    }
+    return fclose(fp) ? ERROR : SUCCESS;
+}
+
+static void usage(void)
+{
+    fputs("usage: convbench [-r REPEAT] [-t PERCENT] [-b BASELINE] [-w] SINGLE DUAL" "\n", stderr);
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    Result results[MACHINES_MAX];
+    Result baseline[MACHINES_MAX];
+    const char *baselineFile = NULL;
+    double tolerance = 10.0;
+    int repeat = 5;
+    int write = 0;
+    int count = 0;
+    int baselineCount = -1;
+    int failed = 0;
+    int i, j;
+    Machine **ptr;
+
+    for(i = 1; i < argc && argv[i][0] == '-'; i++) {
+        if(strcmp(argv[i], "-w") == 0) {
+            write = 1;
+        }
+        else if(i + 1 == argc) {
+            usage();
+        }
+        else if(strcmp(argv[i], "-r") == 0) {
+            repeat = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-t") == 0) {
+            tolerance = atof(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-b") == 0) {
+            baselineFile = argv[++i];
+        }
+        else {
+            usage();
+        }
+    }
+    if(argc - i != 2 || repeat < 1) usage();
+    if(baselineFile && !write) {
+        baselineCount = load_baseline(baselineFile, baseline, MACHINES_MAX);
+        if(baselineCount < 0) {
+            printf("No baseline in %s, recording this run" "\n", baselineFile);
+            write = 1;
+        }
+    }
+
+    printf("%-5s %12s %8s %12s %9s" "\n", "", "lines/s", "MB/s", "commands/s", "baseline");
+    for(ptr = machines; *ptr && count < MACHINES_MAX; ptr++) {
+        Result *r = results + count;
+        const char *filename = argv[(*ptr)->extruder_count > 1 ? i + 1 : i];
+        if(bench(*ptr, filename, repeat, r) != SUCCESS) return 1;
+        count++;
+        printf("%-5s %12.0f %8.2f %12.0f", r->type, r->lines, r->megabytes, r->commands);
+        for(j = 0; j < baselineCount; j++) {
+            if(strcmp(baseline[j].type, r->type) == 0) {
+                double change = 100.0 * (r->lines - baseline[j].lines) / baseline[j].lines;
+                printf(" %+8.1f%%", change);
+                if(change < -tolerance) {
+                    printf("  REGRESSION");
+                    failed++;
+                }
+                break;
+            }
+        }
+        printf("\n");
+    }
+
+    if(failed) {
+        printf("FAILED: %d machine%s more than %.0f%% slower than the baseline" "\n",
+               failed, failed > 1 ? "s" : "", tolerance);
+        return 1;
+    }
+    if(write && baselineFile) {
+        if(save_baseline(baselineFile, results, count) != SUCCESS) return 1;
+        printf("Baseline written to %s" "\n", baselineFile);
+    }
+    return 0;
+}
@@ -0,0 +1,205 @@
+//  gcodegen.c
+//
+//  Synthetic gcode generator for the throughput benchmark, writes a
+//  repeatable slicer style print of about LINES lines: layers of perimeter
+//  and infill moves with retractions, travel, comments, temperature and fan
+//  changes and, given two tools, tool changes
+//
+//  usage: gcodegen [-n LINES] [-t TOOLS] [-s SEED] [OUTPUT]
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the print is a stack of layers inside a square centered on the origin
+
+#define BED_HALF 50.0
+#define LAYER_HEIGHT 0.2
+#define EXTRUSION_PER_MM 0.0333
+#define RETRACT_LENGTH 1.0
+
+static FILE *out;
+static long lines;
+static long limit;
+static uint64_t state = 88172645463325252ULL;
+
+static double e;        // absolute extruder position
+static double x, y, z;
+
+// xorshift64, the same seed always gives the same file
+
+static double uniform(double lo, double hi)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return lo + (hi - lo) * (double)(state >> 11) / 9007199254740992.0;
+}
+
+static void emit(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(out, fmt, args);
+    va_end(args);
+    fputc('\n', out);
+    lines++;
+}
+
+static void retract(void)
+{
+    e -= RETRACT_LENGTH;
+    emit("G1 F2400 E%.5f", e);
+}
+
+static void unretract(void)
+{
+    e += RETRACT_LENGTH;
+    emit("G1 F2400 E%.5f", e);
+}
+
+static void travel(double tx, double ty)
+{
+    retract();
+    emit("G0 F9000 X%.3f Y%.3f", tx, ty);
+    unretract();
+    x = tx;
+    y = ty;
+}
+
+static void extrude(double tx, double ty, int feedrate)
+{
+    double d = hypot(tx - x, ty - y);
+    e += d * EXTRUSION_PER_MM;
+    if(feedrate) {
+        emit("G1 F%d X%.3f Y%.3f E%.5f", feedrate, tx, ty, e);
+    }
+    else {
+        emit("G1 X%.3f Y%.3f E%.5f", tx, ty, e);
+    }
+    x = tx;
+    y = ty;
+}
+
+// a closed loop of short segments, as a slicer writes a curved perimeter
+
+static void perimeter(const char *type, double r, int segments, int feedrate)
+{
+    double cx = uniform(-BED_HALF / 2, BED_HALF / 2);
+    double cy = uniform(-BED_HALF / 2, BED_HALF / 2);
+    int i;
+    emit(";TYPE:%s", type);
+    travel(cx + r, cy);
+    for(i = 1; i <= segments; i++) {
+        double a = 2 * M_PI * i / segments;
+        extrude(cx + r * cos(a), cy + r * sin(a), i == 1 ? feedrate : 0);
+    }
+}
+
+// back and forth lines across a square
+
+static void infill(double half, double spacing)
+{
+    double cx = uniform(-BED_HALF / 2, BED_HALF / 2);
+    double cy = uniform(-BED_HALF / 2, BED_HALF / 2);
+    double v;
+    int side = 0;
+    emit(";TYPE:FILL");
+    travel(cx - half, cy - half);
+    for(v = -half; v <= half && lines < limit; v += spacing) {
+        extrude(cx + (side ? -half : half), cy + v, v == -half ? 3600 : 0);
+        extrude(x, cy + v + spacing / 2, 0);
+        side = !side;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int tools = 1;
+    int tool = 0;
+    int layer;
+    int i;
+
+    limit = 1000000;
+    out = stdout;
+    for(i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            limit = atol(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            tools = atoi(argv[++i]) > 1 ? 2 : 1;
+        }
+        else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            state = strtoull(argv[++i], NULL, 0) | 1;
+        }
+        else if(argv[i][0] == '-' && argv[i][1]) {
+            fprintf(stderr, "usage: gcodegen [-n LINES] [-t TOOLS] [-s SEED] [OUTPUT]" "\n");
+            return 1;
+        }
+        else if((out = fopen(argv[i], "w")) == NULL) {
+            perror(argv[i]);
+            return 1;
+        }
+    }
+
+    emit(";FLAVOR:RepRap");
+    emit(";Generated by gcodegen, %ld lines, %d tool%s", limit, tools, tools > 1 ? "s" : "");
+    emit("G21 ; set units to millimetres");
+    emit("G90 ; use absolute coordinates");
+    emit("M82 ; use absolute distances for extrusion");
+    emit("M140 S60");
+    for(i = 0; i < tools; i++) emit("M104 S220 T%d", i);
+    emit("G28 ; home all axes");
+    emit("M116 ; wait for temperatures");
+    emit("G92 E0");
+
+    for(layer = 0; lines < limit; layer++) {
+        z = (layer + 1) * LAYER_HEIGHT;
+        emit(";LAYER:%d", layer);
+        retract();
+        emit("G0 F1200 Z%.3f", z);
+        unretract();
+        if(layer == 1) emit("M106 S255");
+        if(layer && layer % 20 == 0) emit("M104 S%d T%d", 210 + (layer / 20) % 3 * 5, tool);
+        if(tools > 1 && layer % 2 == 1) {
+            tool = !tool;
+            emit("T%d", tool);
+            emit("G92 E0");
+            e = 0;
+        }
+        perimeter("WALL-OUTER", uniform(5, 20), 96, 1500);
+        perimeter("WALL-INNER", uniform(4, 18), 64, 2400);
+        if(layer % 4 == 0) emit("(slowing down for a small feature)");
+        infill(uniform(5, 15), 0.4);
+        if(layer % 10 == 0) emit(";MESH:NONMESH");
+    }
+
+    emit("M107");
+    for(i = 0; i < tools; i++) emit("M104 S0 T%d", i);
+    emit("M140 S0");
+    emit("M84");
+    if(out != stdout && fclose(out) != 0) {
+        perror("gcodegen");
+        return 1;
+    }
+    return 0;
+}
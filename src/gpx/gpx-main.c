@@ -32,10 +32,19 @@
 #include <errno.h>
 
 #include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
 
 #include "gpx.h"
 #include "machine_config.h"
 
+#ifdef HAVE_DIRENT_H
+#include <dirent.h>
+#endif
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
 // Global variables
 
 static Gpx gpx;
@@ -124,7 +133,10 @@ static void usage(int err)
 
     fputs(EOL "Usage:" EOL, fp);
     fputs("gpx [-CFIdgilpqr" SERIAL_MSG1 "tvw] " SERIAL_MSG2 "[-L LOGFILE] [-D NEWPORT] [-E EXISTINGPORT] [-c CONFIG] [-e EEPROM] [-f DIAMETER] [-m MACHINE] [-N h|t|ht] [-n SCALE] [-x X] [-y Y] [-z Z] [-W S] IN [OUT]" EOL, fp);
+    fputs("gpx -B [-j JOBS] [options] DIRECTORY|MANIFEST [OUTDIR]" EOL, fp);
     fputs(EOL "Options:" EOL, fp);
+    fputs("\t-B\tbatch mode, convert every gcode file in DIRECTORY or each" EOL, fp);
+    fputs("\t  \tline of MANIFEST (IN [OUT]) using a pool of worker threads" EOL, fp);
     fputs("\t-C\tcreate temporary file with a copy of the machine configuration" EOL, fp);
     fputs("\t-D\trun in daemon mode and create the named virtual port" EOL, fp);
     fputs("\t-E\trun in daemon mode and open the named psuedo-terminal" EOL, fp);
@@ -137,6 +149,7 @@ static void usage(int err)
     fputs("\t-d\tsimulated ditto printing" EOL, fp);
     fputs("\t-g\tMakerbot/ReplicatorG GCODE flavor" EOL, fp);
     fputs("\t-i\tenable stdin and stdout support for command line pipes" EOL, fp);
+    fputs("\t-j\tnumber of batch mode worker threads (default is one per core)" EOL, fp);
     fputs("\t-l\tlog to file" EOL, fp);
     fputs("\t-L\tlog to named [LOGFILE] file" EOL, fp);
     fputs("\t-p\toverride build percentage" EOL, fp);
@@ -148,6 +161,45 @@ static void usage(int err)
     fputs("\t-t\ttruncate filename (DOS 8.3 format)" EOL, fp);
     fputs("\t-v\tverbose mode" EOL, fp);
     fputs("\t-w\trewrite 5d extrusion values" EOL, fp);
+    fputs("\t--coalesce[=MM]" EOL, fp);
+    fputs("\t  \tmerge runs of nearly collinear moves that stay within MM" EOL, fp);
+    fputs("\t  \tof a straight line (default is 0.02 mm)" EOL, fp);
+    fputs("\t--estimate" EOL, fp);
+    fputs("\t  \twrite the filament length, build time, x3g size and command" EOL, fp);
+    fputs("\t  \tcount to stdout as JSON instead of converting to OUTPUT" EOL, fp);
+    fputs("\t--fixed-point" EOL, fp);
+    fputs("\t  \tconvert mm to steps in integer arithmetic, the x3g is then" EOL, fp);
+    fputs("\t  \tthe same whatever the compiler or floating point mode" EOL, fp);
+    fputs("\t--planner[=MOVES]" EOL, fp);
+    fputs("\t  \testimate the build time by simulating the firmware planner" EOL, fp);
+    fputs("\t  \tover a lookahead of MOVES moves (default is 16)" EOL, fp);
+    fputs("\t--resume-z=MM" EOL, fp);
+    fputs("\t  \tresume a failed print from the first move extruding at or" EOL, fp);
+    fputs("\t  \tabove MM, the gcode before it isn't converted" EOL, fp);
+    fputs("\t--resume-line=N" EOL, fp);
+    fputs("\t  \tresume a failed print from line N" EOL, fp);
+    fputs("\t--layer-index" EOL, fp);
+    fputs("\t  \twrite where each layer starts in the x3g, with the build" EOL, fp);
+    fputs("\t  \ttime and filament before it, to OUTPUT.idx" EOL, fp);
+    fputs("\t--no-pipeline" EOL, fp);
+    fputs("\t  \tread INPUT and write OUTPUT on the converting thread rather" EOL, fp);
+    fputs("\t  \tthan reading ahead and writing behind on threads of their own" EOL, fp);
+    fputs("\t--parallel[=THREADS]" EOL, fp);
+    fputs("\t  \tconvert chunks of a large INPUT file on THREADS threads at" EOL, fp);
+    fputs("\t  \tonce (default is one per core), the x3g is unchanged" EOL, fp);
+    fputs("\t--cache=DIR" EOL, fp);
+    fputs("\t  \tkeep the x3g of each conversion in DIR, converting the same" EOL, fp);
+    fputs("\t  \tINPUT with the same settings again copies it from there" EOL, fp);
+    fputs("\t--cache-size=MB" EOL, fp);
+    fputs("\t  \tremove the least recently used x3g beyond MB (default is 1024)" EOL, fp);
+    fputs("\t--checkpoints" EOL, fp);
+    fputs("\t  \talso keep checkpoints in the cache, an edited INPUT is only" EOL, fp);
+    fputs("\t  \tconverted from the edit until the conversion is back in the" EOL, fp);
+    fputs("\t  \tsame state as before, the rest is copied" EOL, fp);
+    fputs("\t--cache-verify" EOL, fp);
+    fputs("\t  \tcheck every x3g in the cache, removing any that are damaged" EOL, fp);
+    fputs("\t--profile[=table|json]" EOL, fp);
+    fputs("\t  \tlog the time spent in each conversion phase" EOL, fp);
 #if defined(SERIAL_SUPPORT)
     fputs(EOL "BAUDRATE: the baudrate for serial I/O (default is 115200)" EOL, fp);
 #endif
@@ -164,17 +216,22 @@ static void usage(int err)
     fputs("\tX = the x axis offset" EOL, fp);
     fputs("\tY = the y axis offset" EOL, fp);
     fputs("\tZ = the z axis offset" EOL, fp);
-    fputs(EOL "IN: the name of the sliced gcode input filename" EOL, fp);
+    fputs(EOL "IN: the name of the sliced gcode input filename, which may be gzipped" EOL, fp);
     fputs("OUT: the name of the X3G output filename"
 #if defined(SERIAL_SUPPORT)
 	  "or the serial I/O port"
 #endif
 	  EOL, fp);
-    fputs("       specify '--' to write to stdout" EOL, fp);
+    fputs("       specify '--' to write to stdout, a name ending in .gz is gzipped" EOL, fp);
+    fputs("DIRECTORY: convert all the .gcode, .gco and .g files it contains, and" EOL, fp);
+    fputs("       those files gzipped as .gz" EOL, fp);
+    fputs("MANIFEST: a text file listing one IN [OUT] conversion per line" EOL, fp);
+    fputs("OUTDIR: directory for batch mode X3G output (default is beside the input)" EOL, fp);
     fputs(EOL "Examples:" EOL, fp);
     fputs("\tgpx -p -m r2 my-sliced-model.gcode" EOL, fp);
     fputs("\tgpx -c custom-tom.ini example.gcode /volumes/things/example.x3g" EOL, fp);
     fputs("\tgpx -x 3 -y -3 offset-model.gcode" EOL, fp);
+    fputs("\tgpx -B -j 8 -p -m r2x sliced-models/ x3g-models/" EOL, fp);
 #if defined(SERIAL_SUPPORT)
     fputs("\tgpx -m c4 -s sio-example.gcode /dev/tty.usbmodem" EOL EOL, fp);
 #endif
@@ -192,95 +249,6 @@ static void sio_open(const char *filename, speed_t baud_rate)
 
 #else
 
-#if !defined(_WIN32) && !defined(_WIN64)
-int gpx_sio_open(Gpx *gpx, const char *filename, speed_t baud_rate,
-		 int *sio_port)
-{
-    struct termios tp;
-    int port;
-
-    if(sio_port)
-	 *sio_port = -1;
-
-    fprintf(gpx->log, "Opening port: %s.\n", filename);
-    // open and configure the serial port
-    if((port = open(filename, O_RDWR | O_NOCTTY | O_NONBLOCK)) < 0) {
-        perror("Error opening port");
-	return 0;
-    }
-
-    if(fcntl(port, F_SETFL, O_RDWR) < 0) {
-        perror("Setting port descriptor flags");
-	return 0;
-    }
-
-    if(tcgetattr(port, &tp) < 0) {
-        fprintf(stderr, "errno = %d", errno);
-        perror("Error getting port attributes");
-	return 0;
-    }
-
-    cfmakeraw(&tp);
-
-    /*
-     // 8N1
-     tp.c_cflag &= ~PARENB;
-     tp.c_cflag &= ~CSTOPB;
-     tp.c_cflag &= ~CSIZE;
-     tp.c_cflag |= CS8;
-
-     // no flow control
-     tp.c_cflag &= ~CRTSCTS;
-
-     // disable hang-up-on-close to avoid reset
-     //tp.c_cflag &= ~HUPCL;
-
-     // turn on READ & ignore ctrl lines
-     tp.c_cflag |= CREAD | CLOCAL;
-
-     // turn off s/w flow ctrl
-     tp.c_cflag &= ~(IXON | IXOFF | IXANY);
-
-     // make raw
-     tp.c_cflag &= ~(ICANON | ECHO | ECHOE | ISIG);
-     tp.c_cflag &= ~OPOST;
-
-     // see: http://unixwiz.net/techtips/termios-vmin-vtime.html
-     tp.c_cc[VMIN]  = 0;
-     tp.c_cc[VTIME] = 0;
-     */
-
-    cfsetspeed(&tp, baud_rate);
-    // cfsetispeed(&tp, baud_rate);
-    // cfsetospeed(&tp, baud_rate);
-
-    // let's ask the i/o system to block for up to a tenth of a second
-    // waiting for at least 255 bytes or whatever we asked for (whichever
-    // is least).
-    tp.c_cc[VMIN] = 255;
-    tp.c_cc[VTIME] = 1;
-
-    if(tcsetattr(port, TCSANOW, &tp) < 0) {
-        perror("Error setting port attributes");
-	return 0;
-    }
-
-    if(gpx->open_delay > 0) {
-		sleep(gpx->open_delay);
-	}
-    if(tcflush(port, TCIOFLUSH) < 0) {
-        perror("Error flushing port");
-	return 0;
-    }
-
-    if(gpx->flag.verboseMode) fprintf(gpx->log, "Communicating via: %s" EOL, filename);
-    if(sio_port)
-	 *sio_port = port;
-
-    return 1;
-}
-#endif
-
 void sio_open(const char *filename, speed_t baud_rate)
 {
     if (!gpx_sio_open(&gpx, filename, baud_rate, &sio_port))
@@ -337,9 +305,442 @@ int gpx_find_ini(Gpx *gpx, char *argv0)
     return gpx_load_config(gpx, fbuf);
 }
 
+// end the conversion, converting any moves still held back, and keep the
+// first failure
+
+static int end_convert(Gpx *gpx, int rval)
+{
+    int end = gpx_end_convert(gpx);
+    return rval == SUCCESS ? end : rval;
+}
+
+// the totals as one line of JSON, length in mm and time in seconds
+
+static void print_estimate(Gpx *gpx, FILE *fp)
+{
+    double length, time;
+    unsigned long bytes, commands;
+
+    gpx_get_totals(gpx, &length, &time, &bytes, &commands);
+    fprintf(fp, "{\"length_mm\": %.3f, \"seconds\": %.3f, \"bytes\": %lu, \"commands\": %lu}" EOL,
+            length, time, bytes, commands);
+}
+
+// write the layer index of the conversion to the x3g to its sidecar, the x3g
+// filename with .idx added
+
+static int write_layer_index(Gpx *gpx, const char *x3g)
+{
+    int rval;
+    FILE *fp;
+    char *filename = malloc(strlen(x3g) + 5);
+    if(filename == NULL) return ERROR;
+    strcpy(filename, x3g);
+    strcat(filename, ".idx");
+    if((fp = fopen(filename, "w")) == NULL) {
+        fprintf(gpx->log, "Error creating layer index %s: %s" EOL, filename, strerror(errno));
+        free(filename);
+        return EOSERROR;
+    }
+    rval = gpx_write_layer_index(gpx, fp);
+    if(fclose(fp) != 0 && rval == SUCCESS) rval = EOSERROR;
+    free(filename);
+    return rval;
+}
+
+// gzip's default compression, for x3g output named .gz
+
+#define GZIP_LEVEL 6
+
+// the length of name without a .gz extension
+
+static size_t gzip_stem(const char *name)
+{
+    size_t l = strlen(name);
+    return l > 3 && !strcasecmp(name + l - 3, ".gz") ? l - 3 : l;
+}
+
+static int is_gzip_filename(const char *name)
+{
+    return gzip_stem(name) < strlen(name);
+}
+
+// the last '.' in the first l characters of name, or NULL
+
+static const char *extension(const char *name, size_t l)
+{
+    while(l > 0 && name[l - 1] != '.') l--;
+    return l ? name + l - 1 : NULL;
+}
+
+// make the x3g output filename from the gcode input filename, optionally
+// in the directory outdir.  Returns an allocated string or NULL
+
+static char *x3g_filename(const char *outdir, const char *filename, int truncate_filename)
+{
+    size_t dl = 0;
+    if(outdir) {
+        const char *leaf = strrchr(filename, PATH_DELIM);
+#ifdef _WIN32
+        const char *otherdelim = strrchr(filename, '/');
+        if(otherdelim > leaf)
+            leaf = otherdelim;
+#endif
+        if(leaf)
+            filename = leaf + 1;
+        dl = strlen(outdir);
+    }
+
+    // foo.gcode.gz is foo.x3g
+    size_t l = gzip_stem(filename);
+    const char *dot = extension(filename, l);
+    if(dot) l = dot - filename;
+    char *x3g = malloc(dl + 1 + l + 5);
+    if(x3g == NULL)
+        return NULL;
+
+    char *s = x3g;
+    if(outdir) {
+        memcpy(s, outdir, dl);
+        s += dl;
+        if(dl > 0 && s[-1] != PATH_DELIM && s[-1] != '/')
+            *s++ = PATH_DELIM;
+    }
+    memcpy(s, filename, l);
+    char *ext = s + l;
+
+    if(truncate_filename) {
+        // truncate, replace all non alnum with '_' and uppercase
+        int i;
+        for(i = 0; s < ext && i < 8; i++) {
+            char c = *s;
+            if(isalnum(c)) {
+                *s++ = toupper(c);
+            }
+            else {
+                *s++ = '_';
+            }
+        }
+        strcpy(s, ".X3G");
+    }
+    else {
+        strcpy(ext, ".x3g");
+    }
+    return x3g;
+}
+
+// BATCH CONVERSION
+
+typedef struct tBatchJob {
+    char *in;
+    char *out;
+    int rval;
+    unsigned long lines;
+    unsigned long bytes_in;
+    unsigned long bytes_out;
+    double seconds;
+} BatchJob;
+
+typedef struct tBatch {
+    const Gpx *gpx;         // configured template, each job converts a clone
+    BatchJob *job;
+    int count;
+    int next;               // next job to hand to a worker
+    int item_code;
+#ifdef HAVE_PTHREAD_H
+    pthread_mutex_t lock;
+#endif
+} Batch;
+
+static double elapsed_seconds(const struct timespec *start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static int batch_add(Batch *batch, char *in, char *out)
+{
+    if((batch->count & 63) == 0) {
+        BatchJob *job = realloc(batch->job, (batch->count + 64) * sizeof(BatchJob));
+        if(job == NULL)
+            return ERROR;
+        batch->job = job;
+    }
+    BatchJob *job = batch->job + batch->count++;
+    memset(job, 0, sizeof(BatchJob));
+    job->in = in;
+    job->out = out;
+    job->rval = ERROR;
+    return SUCCESS;
+}
+
+static int is_gcode_filename(const char *name)
+{
+    size_t l = gzip_stem(name);
+    const char *dot = extension(name, l);
+    if(dot == NULL) return 0;
+    l -= dot - name;
+    return (l == 6 && !strncasecmp(dot, ".gcode", l))
+        || (l == 4 && !strncasecmp(dot, ".gco", l))
+        || (l == 2 && !strncasecmp(dot, ".g", l));
+}
+
+static int compare_jobs(const void *a, const void *b)
+{
+    return strcmp(((const BatchJob *)a)->in, ((const BatchJob *)b)->in);
+}
+
+// queue up every gcode file in the directory, in name order
+
+static int batch_read_directory(Batch *batch, const char *dirname, const char *outdir, int truncate_filename)
+{
+#ifdef HAVE_DIRENT_H
+    DIR *dir = opendir(dirname);
+    struct dirent *entry;
+    size_t dl = strlen(dirname);
+
+    if(dir == NULL) {
+        perror("Error opening batch directory");
+        return ERROR;
+    }
+    while((entry = readdir(dir)) != NULL) {
+        if(!is_gcode_filename(entry->d_name))
+            continue;
+        char *in = malloc(dl + strlen(entry->d_name) + 2);
+        if(in == NULL)
+            break;
+        sprintf(in, "%s%c%s", dirname, PATH_DELIM, entry->d_name);
+        char *out = x3g_filename(outdir ? outdir : dirname, in, truncate_filename);
+        if(out == NULL || batch_add(batch, in, out) != SUCCESS) {
+            free(in);
+            free(out);
+            break;
+        }
+    }
+    closedir(dir);
+    if(entry != NULL) {
+        fputs("Insufficient memory" EOL, stderr);
+        return ERROR;
+    }
+    qsort(batch->job, batch->count, sizeof(BatchJob), compare_jobs);
+    return SUCCESS;
+#else
+    fprintf(stderr, "Command line error: batch directories are not supported by this build of GPX, use a manifest" EOL);
+    return ERROR;
+#endif
+}
+
+// a manifest has one conversion per line: the input filename optionally
+// followed by whitespace and the output filename.  Blank lines and lines that
+// start with # are ignored
+
+static int batch_read_manifest(Batch *batch, const char *manifest, const char *outdir, int truncate_filename)
+{
+    char line[2048];
+    unsigned lineno = 0;
+    FILE *fp = fopen(manifest, "r");
+
+    if(fp == NULL) {
+        perror("Error opening batch manifest");
+        return ERROR;
+    }
+    while(fgets(line, sizeof(line), fp) != NULL) {
+        char *in = line, *out, *end;
+        lineno++;
+        while(isspace(*in)) in++;
+        if(*in == 0 || *in == '#')
+            continue;
+        for(end = in; *end && !isspace(*end); end++);
+        out = end;
+        while(isspace(*out)) out++;
+        *end = 0;
+        for(end = out; *end && !isspace(*end); end++);
+        *end = 0;
+
+        in = strdup(in);
+        out = *out ? strdup(out) : x3g_filename(outdir, in, truncate_filename);
+        if(in == NULL || out == NULL || batch_add(batch, in, out) != SUCCESS) {
+            fprintf(stderr, "(line %u) Insufficient memory reading batch manifest" EOL, lineno);
+            free(in);
+            free(out);
+            fclose(fp);
+            return ERROR;
+        }
+    }
+    fclose(fp);
+    return SUCCESS;
+}
+
+static void batch_convert_job(Batch *batch, BatchJob *job)
+{
+    struct timespec start;
+    FILE *in = NULL, *out = NULL;
+    Gpx *gpx = NULL;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if((in = fopen(job->in, "rb")) == NULL) {
+        fprintf(batch->gpx->log, "Error opening input %s: %s" EOL, job->in, strerror(errno));
+        goto done;
+    }
+    if((out = fopen(job->out, "wb")) == NULL) {
+        fprintf(batch->gpx->log, "Error creating output %s: %s" EOL, job->out, strerror(errno));
+        goto done;
+    }
+    if((gpx = gpx_clone(batch->gpx)) == NULL) {
+        fputs("Insufficient memory" EOL, batch->gpx->log);
+        goto done;
+    }
+    if(gpx_set_compression(gpx, is_gzip_filename(job->out) ? GZIP_LEVEL : 0) != SUCCESS) {
+        fprintf(batch->gpx->log, "Error creating output %s: this build of GPX can't gzip x3g" EOL, job->out);
+        goto done;
+    }
+
+    // build name is the input leaf without its extension
+    char *buildname = strrchr(job->in, PATH_DELIM);
+    buildname = strdup(buildname ? buildname + 1 : job->in);
+    if(buildname) {
+        buildname[gzip_stem(buildname)] = 0;
+        char *dot = strrchr(buildname, '.');
+        if(dot) *dot = 0;
+    }
+    gpx_start_convert(gpx, buildname, batch->item_code, 0);
+    free(buildname);
+    job->rval = gpx_convert(gpx, in, out, NULL);
+    job->rval = end_convert(gpx, job->rval);
+    if(job->rval == SUCCESS && gpx->layerIndex.layers)
+        job->rval = write_layer_index(gpx, job->out);
+
+    job->lines = gpx->lineNumber - 1;
+    job->bytes_in = (unsigned long)ftell(in);
+    job->bytes_out = gpx->total.bytes;
+
+done:
+    if(gpx) gpx_destroy(gpx);
+    if(in) fclose(in);
+    if(out && fclose(out) != 0 && job->rval == SUCCESS)
+        job->rval = EOSERROR;
+    job->seconds = elapsed_seconds(&start);
+}
+
+static void *batch_worker(void *arg)
+{
+    Batch *batch = arg;
+    for(;;) {
+        BatchJob *job = NULL;
+#ifdef HAVE_PTHREAD_H
+        pthread_mutex_lock(&batch->lock);
+#endif
+        if(batch->next < batch->count)
+            job = batch->job + batch->next++;
+#ifdef HAVE_PTHREAD_H
+        pthread_mutex_unlock(&batch->lock);
+#endif
+        if(job == NULL)
+            return NULL;
+        batch_convert_job(batch, job);
+    }
+}
+
+static int batch_worker_count(int jobs)
+{
+    if(jobs > 0)
+        return jobs;
+#if defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if(n > 0)
+        return (int)n;
+#endif
+    return 1;
+}
+
+#define MB(bytes) ((double)(bytes) / (1024.0 * 1024.0))
+#define PER_SECOND(n, seconds) ((seconds) > 0 ? (double)(n) / (seconds) : 0.0)
+
+// convert every file of a directory or manifest, spreading the files across
+// a pool of worker threads that each convert with a copy of gpx
+
+static int gpx_batch(Gpx *gpx, const char *source, const char *outdir, int jobs, int truncate_filename, int item_code)
+{
+    struct stat st;
+    struct timespec start;
+    Batch batch;
+    int i, workers, failed = 0;
+    unsigned long lines = 0, bytes_in = 0, bytes_out = 0;
+    double busy = 0.0, seconds;
+
+    memset(&batch, 0, sizeof(batch));
+    batch.gpx = gpx;
+    batch.item_code = item_code;
+
+    if(stat(source, &st) != 0) {
+        perror("Error opening batch input");
+        return ERROR;
+    }
+    if(S_ISDIR(st.st_mode)) {
+        if(batch_read_directory(&batch, source, outdir, truncate_filename) != SUCCESS)
+            return ERROR;
+    }
+    else if(batch_read_manifest(&batch, source, outdir, truncate_filename) != SUCCESS) {
+        return ERROR;
+    }
+
+    workers = batch_worker_count(jobs);
+    if(workers > batch.count)
+        workers = batch.count > 0 ? batch.count : 1;
+    if(gpx->flag.verboseMode) fprintf(gpx->log, "Batch converting %d files with %d workers" EOL, batch.count, workers);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+#ifdef HAVE_PTHREAD_H
+    pthread_t *thread = malloc(workers * sizeof(pthread_t));
+    pthread_mutex_init(&batch.lock, NULL);
+    for(i = 0; thread && i < workers; i++) {
+        if(pthread_create(thread + i, NULL, batch_worker, &batch) != 0)
+            break;
+    }
+    // the calling thread works too if we couldn't start any
+    if(thread == NULL || i == 0)
+        batch_worker(&batch);
+    while(thread && i-- > 0)
+        pthread_join(thread[i], NULL);
+    pthread_mutex_destroy(&batch.lock);
+    free(thread);
+#else
+    workers = 1;
+    batch_worker(&batch);
+#endif
+    seconds = elapsed_seconds(&start);
+
+    for(i = 0; i < batch.count; i++) {
+        BatchJob *job = batch.job + i;
+        if(job->rval == SUCCESS) {
+            printf("%s -> %s: %lu lines, %0.2f MB in %0.3f s (%0.0f lines/s, %0.2f MB/s)" EOL,
+                job->in, job->out, job->lines, MB(job->bytes_in), job->seconds,
+                PER_SECOND(job->lines, job->seconds), PER_SECOND(MB(job->bytes_in), job->seconds));
+            lines += job->lines;
+            bytes_in += job->bytes_in;
+            bytes_out += job->bytes_out;
+        }
+        else {
+            printf("%s -> %s: failed (%d)" EOL, job->in, job->out, job->rval);
+            failed++;
+        }
+        busy += job->seconds;
+        free(job->in);
+        free(job->out);
+    }
+    free(batch.job);
+
+    printf("Batch: %d files converted, %d failed, %d workers" EOL, batch.count - failed, failed, workers);
+    printf("Batch: %lu lines, %0.2f MB in, %0.2f MB out in %0.3f s (%0.0f lines/s, %0.2f MB/s, %0.1fx parallel)" EOL,
+        lines, MB(bytes_in), MB(bytes_out), seconds,
+        PER_SECOND(lines, seconds), PER_SECOND(MB(bytes_in), seconds), PER_SECOND(busy, seconds));
+    return failed ? ERROR : SUCCESS;
+}
+
 // GPX program entry point
 
-int main(int argc, char * const argv[])
+int main(int argc, char *argv[])
 {
     int c, i, rval = 1;
     int force_framing = 0;
@@ -358,6 +759,23 @@ int main(int argc, char * const argv[])
     speed_t baud_rate = B115200;
     int make_temp_config = 0;
     int create_daemon_port = 0;
+    int batch_mode = 0;
+    int batch_jobs = 0;
+    int profile = PROFILE_OFF;
+    double coalesce = -1.0;
+    int planner = -1;
+    int estimate = 0;
+    int fixed_point = 0;
+    double resume_z = 0.0;
+    unsigned resume_line = 0;
+    int layer_index = 0;
+    char *layer_index_x3g = NULL;
+    int pipeline = 1;
+    int parallel = -1;
+    char *cache_dir = NULL;
+    unsigned long cache_mb = 1024;
+    int cache_verify = 0;
+    int checkpoints = 0;
 
     // Blank the temporary config file name.  If it isn't blank
     //   on exit and an error has occurred, then it is deleted
@@ -373,11 +791,78 @@ int main(int argc, char * const argv[])
     gpx_initialize(&gpx, 1);
     gpx.log = stderr;
 
+    // getopt only takes short options, so take out the long ones first
+    for(i = c = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--") == 0) {
+            while(i < argc) argv[c++] = argv[i++];
+            break;
+        }
+        if(strcmp(argv[i], "--profile") == 0 || strcmp(argv[i], "--profile=table") == 0) {
+            profile = PROFILE_TABLE;
+        }
+        else if(strcmp(argv[i], "--profile=json") == 0) {
+            profile = PROFILE_JSON;
+        }
+        else if(strcmp(argv[i], "--coalesce") == 0) {
+            coalesce = COALESCE_TOLERANCE;
+        }
+        else if(strncmp(argv[i], "--coalesce=", 11) == 0) {
+            coalesce = strtod(argv[i] + 11, NULL);
+        }
+        else if(strcmp(argv[i], "--fixed-point") == 0) {
+            fixed_point = 1;
+        }
+        else if(strcmp(argv[i], "--estimate") == 0) {
+            estimate = 1;
+        }
+        else if(strcmp(argv[i], "--planner") == 0) {
+            planner = PLANNER_WINDOW;
+        }
+        else if(strncmp(argv[i], "--planner=", 10) == 0) {
+            planner = atoi(argv[i] + 10);
+        }
+        else if(strncmp(argv[i], "--resume-z=", 11) == 0) {
+            resume_z = strtod(argv[i] + 11, NULL);
+        }
+        else if(strncmp(argv[i], "--resume-line=", 14) == 0) {
+            resume_line = (unsigned)strtoul(argv[i] + 14, NULL, 10);
+        }
+        else if(strcmp(argv[i], "--layer-index") == 0) {
+            layer_index = 1;
+        }
+        else if(strcmp(argv[i], "--no-pipeline") == 0) {
+            pipeline = 0;
+        }
+        else if(strcmp(argv[i], "--parallel") == 0) {
+            parallel = 0;
+        }
+        else if(strncmp(argv[i], "--parallel=", 11) == 0) {
+            parallel = atoi(argv[i] + 11);
+        }
+        else if(strncmp(argv[i], "--cache=", 8) == 0) {
+            cache_dir = argv[i] + 8;
+        }
+        else if(strncmp(argv[i], "--cache-size=", 13) == 0) {
+            cache_mb = strtoul(argv[i] + 13, NULL, 10);
+        }
+        else if(strcmp(argv[i], "--cache-verify") == 0) {
+            cache_verify = 1;
+        }
+        else if(strcmp(argv[i], "--checkpoints") == 0) {
+            checkpoints = 1;
+        }
+        else {
+            argv[c++] = argv[i];
+        }
+    }
+    argc = c;
+    argv[argc] = NULL;
+
     // we run through getopt twice, the first time is to figure out whether to load
     // the ini file from the default locations and whether to be verbose about it
     // we need to load the ini file before parsing the rest so that the command line
     // overrides the default ini in the standard case
-    while ((c = getopt(argc, argv, "CD:E:FIL:N:W:b:c:de:gf:ilm:n:pqrstu:vwx:y:z:?")) != -1) {
+    while ((c = getopt(argc, argv, "BCD:E:FIL:N:W:b:c:de:gf:ij:lm:n:pqrstu:vwx:y:z:?")) != -1) {
         switch (c) {
             case 'I':
                 ignore_default_ini = 1;
@@ -414,8 +899,11 @@ int main(int argc, char * const argv[])
     // error message should they be attempted when the code
     // is compiled without serial I/O support.
 
-    while ((c = getopt(argc, argv, "CD:E:FIL:N:W:b:c:de:gf:ilm:n:pqrstu:vwx:y:z:?")) != -1) {
+    while ((c = getopt(argc, argv, "BCD:E:FIL:N:W:b:c:de:gf:ij:lm:n:pqrstu:vwx:y:z:?")) != -1) {
         switch (c) {
+            case 'B':
+                batch_mode = 1;
+                break;
 	    case 'C':
 		 // Write config data to a temp file
 		 // Write output to stdout
@@ -530,6 +1018,9 @@ int main(int argc, char * const argv[])
             case 'i':
                 standard_io = 1;
                 break;
+            case 'j':
+                batch_jobs = atoi(optarg);
+                break;
             case 'l':
                 break; // handled in first getopt loop
             case 'm':
@@ -668,9 +1159,79 @@ int main(int argc, char * const argv[])
         if(gpx.flag.verboseMode) fputs("WARNING: a 57600 bps baud rate will cause problems with Repicator 2/2X Mightyboards" EOL, gpx.log);
     }
 
+    // the command line overrides any coalesce_tolerance, planner_window or
+    // fixed_point in the ini files
+    if(coalesce >= 0.0) gpx.coalesce.tolerance = coalesce;
+    if(planner >= 0) gpx_set_planner(&gpx, planner);
+    if(fixed_point) gpx.flag.fixedPoint = 1;
+    if(resume_z > 0.0 || resume_line) gpx_set_resume(&gpx, resume_z, resume_line, gpx.resume.hop);
+    if(!pipeline) gpx_set_pipeline(&gpx, 0);
+    if(parallel >= 0) gpx_set_parallel(&gpx, batch_worker_count(parallel));
+    if(cache_dir && gpx_set_cache(&gpx, cache_dir, (unsigned long long)cache_mb << 20) != SUCCESS) {
+        fputs("Insufficient memory" EOL, stderr);
+        goto done;
+    }
+    if(checkpoints) gpx_set_checkpoints(&gpx, 1);
+
+    if(profile != PROFILE_OFF && gpx_set_profile(&gpx, profile) != SUCCESS) {
+        perror("Error allocating the profile counters");
+        goto done;
+    }
+    if(layer_index && gpx_set_layer_index(&gpx, 1) != SUCCESS) {
+        fputs("Insufficient memory" EOL, stderr);
+        goto done;
+    }
+
+    if(cache_verify) {
+        if(cache_dir == NULL) {
+            fprintf(stderr, "Command line error: provide the cache to verify with --cache=DIR\n");
+            usage(1);
+            goto done;
+        }
+        int removed = gpx_verify_cache(cache_dir, stderr);
+        if(removed < 0) {
+            perror("Error reading the cache");
+            goto done;
+        }
+        printf("Cache: %d damaged entries removed" EOL, removed);
+        rval = SUCCESS;
+        goto done;
+    }
+
     // OPEN FILES AND PORTS FOR INPUT AND OUTPUT
 
-    if(daemon_port != NULL) {
+    if(estimate && (batch_mode || serial_io || daemon_port != NULL)) {
+        fprintf(stderr, "Command line error: estimate mode is incompatible with batch, serial and daemon i/o\n");
+        usage(1);
+        goto done;
+    }
+    if(layer_index && (estimate || serial_io || daemon_port != NULL)) {
+        fprintf(stderr, "Command line error: the layer index needs an x3g output file\n");
+        usage(1);
+        goto done;
+    }
+    if(batch_mode) {
+        if(parallel >= 0) {
+            fprintf(stderr, "Command line error: batch mode already converts in parallel, use -j for its worker threads\n");
+            usage(1);
+            goto done;
+        }
+        if(serial_io || standard_io) {
+            fprintf(stderr, "Command line error: batch mode is incompatible with serial and standard i/o\n");
+            usage(1);
+            goto done;
+        }
+        if(argc == 0) {
+            fprintf(stderr, "Command line error: provide a directory or manifest for batch mode\n");
+            usage(1);
+            goto done;
+        }
+        if(make_temp_config)
+            gpx_set_preamble(&gpx, temp_config_name);
+        rval = gpx_batch(&gpx, argv[0], argc > 1 ? argv[1] : NULL, batch_jobs, truncate_filename, force_framing);
+        goto done;
+    }
+    else if(daemon_port != NULL) {
         if(standard_io) {
             fprintf(stderr, "Command line error: daemon mode incompatible with standard i/o\n");
             usage(1);
@@ -758,45 +1319,36 @@ int main(int argc, char * const argv[])
             }
 
             // or use the input filename with a .x3g extension
-            char *ext = strrchr(filename, '.');
-            size_t l = ext ? ext - filename : strlen(filename);
-            memcpy(gpx.buffer.out, filename, l);
-            filename = gpx.buffer.out;
-            ext = filename + l;
-
-            if(truncate_filename) {
-                // truncate, replace all non alnum with '_' and uppercase
-                char *s = gpx.buffer.out;
-                for(i = 0; s < ext && i < 8; i++) {
-                    char c = *s;
-                    if(isalnum(c)) {
-                        *s++ = toupper(c);
-                    }
-                    else {
-                        *s++ = '_';
-                    }
-                }
-                strcpy(s, ".X3G");
-            }
-            else {
-                strcpy(ext, ".x3g");
+            if((filename = x3g_filename(NULL, filename, truncate_filename)) == NULL) {
+                fputs("Insufficient memory" EOL, stderr);
+                goto done;
             }
         }
 
-        // trim build name extension
+        // trim build name extension, and a .gz after it
+        buildname[gzip_stem(buildname)] = 0;
         char *dot = strrchr(buildname, '.');
         if(dot) *dot = 0;
 
         if(serial_io) {
             sio_open(filename, baud_rate);
         }
-        else {
+        else if(!estimate) {
 	    if(filename[0] != '-' || filename[1] != '-' || filename[2] != '\0') {
+              if(is_gzip_filename(filename) && gpx_set_compression(&gpx, GZIP_LEVEL) != SUCCESS) {
+                  fputs("Error creating output: this build of GPX can't gzip x3g" EOL, stderr);
+                  goto done;
+              }
               if((file_out = fopen(filename, "wb")) == NULL) {
                   perror("Error creating output");
 		  goto done;
               }
               if(gpx.flag.verboseMode) fprintf(gpx.log, "Writing to: %s" EOL, filename);
+              // the filename might be in gpx.buffer.out, which converting overwrites
+              if(layer_index && (layer_index_x3g = strdup(filename)) == NULL) {
+                  fputs("Insufficient memory" EOL, stderr);
+                  goto done;
+              }
               // write a second copy to the SD Card
               if(gpx.sdCardPath) {
                   long sl = strlen(gpx.sdCardPath);
@@ -873,18 +1425,33 @@ int main(int argc, char * const argv[])
 
 	    gpx_start_convert(&gpx, buildname, force_framing, 0);
             rval = gpx_convert_and_send(&gpx, file_in, sio_port, force_framing, 0);
-            gpx_end_convert(&gpx);
+            rval = end_convert(&gpx, rval);
         }
     }
+    else if(estimate) {
+        // READ INPUT AND REPORT THE TOTALS
+
+	gpx_start_convert(&gpx, buildname, force_framing, 0);
+        rval = gpx_estimate(&gpx, file_in);
+        rval = end_convert(&gpx, rval);
+        if(rval == SUCCESS) print_estimate(&gpx, stdout);
+    }
     else {
         // READ INPUT AND CONVERT TO OUTPUT
 
+        if(layer_index && layer_index_x3g == NULL) {
+            fprintf(stderr, "Command line error: the layer index needs an x3g output file\n");
+            usage(1);
+            goto done;
+        }
 	gpx_start_convert(&gpx, buildname, force_framing, 0);
         rval = gpx_convert(&gpx, file_in, file_out, file_out2);
-        gpx_end_convert(&gpx);
+        rval = end_convert(&gpx, rval);
+        if(rval == SUCCESS && layer_index_x3g) rval = write_layer_index(&gpx, layer_index_x3g);
     }
 
 done:
+    free(layer_index_x3g);
     if (temp_config_name[0])
     {
 	 if (rval != SUCCESS)
@@ -39,7 +39,25 @@
 #include <libgen.h>
 
 #include "portable_endian.h"
+#include "crc8.h"
 #include "gpx.h"
+#include "cache.h"
+#include "kinematics.h"
+#include "pipeline.h"
+#include "planner.h"
+#include "scanner.h"
+
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#if defined(HAVE_WRITEV) && defined(HAVE_SYS_UIO_H)
+#include <sys/uio.h>
+#define USE_WRITEV 1
+#endif
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 #define A 0
 #define B 1
@@ -153,6 +171,7 @@ Machine *gpx_find_machine(const char *machine)
 static int ini_parse(Gpx* gpx, const char* filename,
                      int (*handler)(Gpx*, const char*, const char*, char*));
 int gpx_set_property(Gpx *gpx, const char* section, const char* property, char* value);
+static void update_motion(Gpx *gpx);
 
 int gpx_set_machine(Gpx *gpx, const char *machine_type, int init)
 {
@@ -196,6 +215,7 @@ int gpx_set_machine(Gpx *gpx, const char *machine_type, int init)
 
     // update known position mask
     gpx->axis.mask = gpx->machine.extruder_count == 1 ? (XYZ_BIT_MASK | A_IS_SET) : AXES_BIT_MASK;;
+    update_motion(gpx);
     return SUCCESS;
 }
 
@@ -204,16 +224,29 @@ int gpx_set_machine(Gpx *gpx, const char *machine_type, int init)
 static double get_home_feedrate(Gpx *gpx, int flag);
 static int pause_at_zpos(Gpx *gpx, float z_positon);
 
-// initialization of global variables
+static void free_eeprom_mappings(Gpx *gpx)
+{
+    if(gpx->eepromMappingVector != NULL) {
+        int iem;
+        for(iem = 0; iem < gpx->eepromMappingVector->c; iem++) {
+            EepromMapping *pem = vector_get(gpx->eepromMappingVector, iem);
+            free((char *)pem->id);
+        }
+        vector_free(gpx->eepromMappingVector);
+        gpx->eepromMappingVector = NULL;
+    }
+}
+
+// CANNED COMMANDS
 
 // 02 - Get available buffer size
-char buffer_size_query[] = {
-    0xD5,   // start byte
-    1,      // length
-    2,      // query command
-    0       // crc
+// read-only so that concurrent Gpx contexts can share it
+static const char buffer_size_query[] = {
+    (char)0xD5, // start byte
+    1,          // length
+    2,          // query command
+    (char)0xBC  // crc
 };
-static unsigned char calculate_crc(unsigned char *addr, long len);
 
 void gpx_initialize(Gpx *gpx, int firstTime)
 {
@@ -310,6 +343,8 @@ void gpx_initialize(Gpx *gpx, int firstTime)
 #endif
         gpx->tool[i].nozzle_temperature = 0;
         gpx->tool[i].build_platform_temperature = 0;
+        gpx->tool[i].fan = -1;
+        gpx->tool[i].valve = -1;
 
         gpx->override[i].actual_filament_diameter = 0;
         gpx->override[i].filament_scale = 1.0;
@@ -333,6 +368,7 @@ void gpx_initialize(Gpx *gpx, int firstTime)
         gpx->commandAtLength = 0;
     }
     gpx->commandAtZ = 0.0;
+    gpx->commandAtReached = -DBL_MAX;
 
     // SETTINGS
 
@@ -345,12 +381,15 @@ void gpx_initialize(Gpx *gpx, int firstTime)
 	gpx->nostart = 0;
 	gpx->noend = 0;
         gpx->eepromMappingVector = NULL;
+        gpx->progressMarks = NULL;
+        gpx->profile = NULL;
+        gpx->layerIndex.layers = NULL;
+        gpx->cache.dir = NULL;
+        gpx->cache.size = 0;
+        gpx->cache.checkpoints = 0;
     }
 
-    if(gpx->eepromMappingVector != NULL) {
-        free(gpx->eepromMappingVector);
-        gpx->eepromMappingVector = NULL;
-    }
+    free_eeprom_mappings(gpx);
     gpx->eepromMap = NULL;
 
     gpx->flag.relativeCoordinates = 0;
@@ -378,15 +417,42 @@ void gpx_initialize(Gpx *gpx, int firstTime)
         gpx->flag.loadMacros = 1;
         gpx->flag.runMacros = 1;
         gpx->flag.ignoreAbsoluteMoves = 0;
+        gpx->flag.fixedPoint = 0;
+#ifdef HAVE_PIPELINE
+        gpx->flag.pipeline = 1;
+#else
+        gpx->flag.pipeline = 0;
+#endif
+        gpx->parallel = 0;
+        gpx->compression = 0;
     }
+    gpx->flag.prescan = 0;
 
     if(firstTime)
 	gpx->flag.framingEnabled = 0;
 
-    gpx->longestDDA = 0;
     gpx->layerHeight = 0.34;
     gpx->lineNumber = 1;
+    update_motion(gpx);
+
+    if(firstTime) gpx->coalesce.tolerance = 0.0;
+    gpx->coalesce.anchored = 0;
+    gpx->coalesce.count = 0;
+    gpx->coalesce.eliminated = 0;
 
+    if(firstTime) gpx->planner.window = 0;
+    planner_stop(&gpx->planner);
+
+    if(firstTime) {
+        gpx->resume.z = 0.0;
+        gpx->resume.line = 0;
+        gpx->resume.hop = RESUME_HOP;
+    }
+    gpx->flag.fastForward = gpx->resume.z > 0.0 || gpx->resume.line > 0;
+
+    if(gpx->layerIndex.layers) gpx->layerIndex.layers->c = 0;
+    memset(&gpx->layerIndex.start, 0, sizeof(Layer));
+    gpx->layerIndex.z = -DBL_MAX;
 
     // STATISTICS
 
@@ -394,11 +460,13 @@ void gpx_initialize(Gpx *gpx, int firstTime)
     gpx->accumulated.b = 0.0;
     gpx->accumulated.time = 0.0;
     gpx->accumulated.bytes = 0;
+    gpx->accumulated.commands = 0;
 
     if(firstTime) {
         gpx->total.length = 0.0;
         gpx->total.time = 0.0;
         gpx->total.bytes = 0;
+        gpx->total.commands = 0;
     }
 
     // CALLBACK
@@ -412,8 +480,272 @@ void gpx_initialize(Gpx *gpx, int firstTime)
 
     if(firstTime) gpx->log = stderr;
 
-    // CANNED COMMANDS
-    buffer_size_query[3] = calculate_crc((unsigned char *)buffer_size_query + 2, 1);
+    // TRANSLATION
+
+    if(firstTime) gpx->tio = NULL;
+}
+
+// CONTEXT LIFETIME
+
+// allocate and initialize a conversion context, each one is independent of
+// any other so separate threads can each convert with their own
+// returns NULL if out of memory
+
+Gpx *gpx_create(void)
+{
+    Gpx *gpx = calloc(1, sizeof(Gpx));
+    if(gpx != NULL)
+        gpx_initialize(gpx, 1);
+    return gpx;
+}
+
+// copy a configured context, typically one that has already loaded its ini
+// files and machine definition, so each conversion of a batch can start from
+// it without repeating that work.  The copy shares nothing that either one
+// might free or change, it has no callbacks and no serial connection
+// returns NULL if out of memory
+
+Gpx *gpx_clone(const Gpx *gpx)
+{
+    int i;
+    Gpx *clone = malloc(sizeof(Gpx));
+    if(clone == NULL) return NULL;
+
+    memcpy(clone, gpx, sizeof(Gpx));
+    clone->buffer.ptr = clone->buffer.out;
+    clone->command.comment = "";
+    clone->filamentLength = 1;
+    clone->eepromMappingVector = NULL;
+    clone->eepromMap = NULL;
+    clone->progressMarks = NULL;
+    clone->profile = NULL;
+    clone->layerIndex.layers = NULL;
+    clone->sdCardPath = NULL;
+    clone->buildName = NULL;
+    clone->iniPath = NULL;
+    clone->cache.dir = NULL;
+    clone->selectedFilename = NULL;
+    clone->callbackHandler = NULL;
+    clone->callbackData = NULL;
+    clone->resultHandler = NULL;
+    clone->sio = NULL;
+    clone->tio = NULL;
+    clone->flag.sioConnected = 0;
+
+    for(i = 1; i < gpx->filamentLength; i++) {
+        if((clone->filament[i].colour = strdup(gpx->filament[i].colour)) == NULL)
+            goto L_FAIL;
+        clone->filamentLength++;
+    }
+    if(gpx->eepromMappingVector != NULL) {
+        clone->eepromMappingVector = vector_create(sizeof(EepromMapping), gpx->eepromMappingVector->c + 1, 10);
+        if(clone->eepromMappingVector == NULL)
+            goto L_FAIL;
+        for(i = 0; i < gpx->eepromMappingVector->c; i++) {
+            EepromMapping em = *(EepromMapping *)vector_get(gpx->eepromMappingVector, i);
+            if((em.id = strdup(em.id)) == NULL)
+                goto L_FAIL;
+            vector_append(clone->eepromMappingVector, &em);
+        }
+    }
+    if(gpx->profile && gpx_set_profile(clone, gpx->profile->format) != SUCCESS)
+        goto L_FAIL;
+    if(gpx->layerIndex.layers && gpx_set_layer_index(clone, 1) != SUCCESS)
+        goto L_FAIL;
+    if((gpx->sdCardPath && (clone->sdCardPath = strdup(gpx->sdCardPath)) == NULL)
+       || (gpx->buildName && (clone->buildName = strdup(gpx->buildName)) == NULL)
+       || (gpx->iniPath && (clone->iniPath = strdup(gpx->iniPath)) == NULL)
+       || (gpx->cache.dir && (clone->cache.dir = strdup(gpx->cache.dir)) == NULL))
+        goto L_FAIL;
+    return clone;
+
+L_FAIL:
+    gpx_destroy(clone);
+    return NULL;
+}
+
+// release a context from gpx_create along with everything it owns
+
+void gpx_destroy(Gpx *gpx)
+{
+    int i;
+
+    if(!gpx) return;
+
+    if(gpx->tio != NULL) {
+        tio_destroy(gpx->tio);
+        gpx->tio = NULL;
+    }
+    free_eeprom_mappings(gpx);
+    if(gpx->progressMarks != NULL) {
+        vector_free(gpx->progressMarks);
+    }
+    if(gpx->layerIndex.layers != NULL) {
+        vector_free(gpx->layerIndex.layers);
+    }
+    free(gpx->profile);
+    for(i = 1; i < gpx->filamentLength; i++) {
+        free(gpx->filament[i].colour);
+    }
+    free(gpx->sdCardPath);
+    free(gpx->buildName);
+    free(gpx->iniPath);
+    free(gpx->selectedFilename);
+    free(gpx->cache.dir);
+    free(gpx);
+}
+
+// TIME ESTIMATE
+
+void gpx_set_planner(Gpx *gpx, int window)
+{
+    if(window < 0) window = 0;
+    if(window > PLANNER_WINDOW_MAX) window = PLANNER_WINDOW_MAX;
+    gpx->planner.window = window;
+    planner_stop(&gpx->planner);
+}
+
+// LAYER INDEX
+
+int gpx_set_layer_index(Gpx *gpx, int enable)
+{
+    if(!enable) {
+        if(gpx->layerIndex.layers) vector_free(gpx->layerIndex.layers);
+        gpx->layerIndex.layers = NULL;
+    }
+    else if(gpx->layerIndex.layers == NULL) {
+        gpx->layerIndex.layers = vector_create(sizeof(Layer), 1024, 1024);
+        if(gpx->layerIndex.layers == NULL) return ERROR;
+    }
+    return SUCCESS;
+}
+
+int gpx_write_layer_index(Gpx *gpx, FILE *fp)
+{
+    int i;
+    vector *layers = gpx->layerIndex.layers;
+    if(layers == NULL) return ERROR;
+    fputs("; layer z offset seconds filament\n", fp);
+    for(i = 0; i < layers->c; i++) {
+        Layer *layer = vector_get(layers, i);
+        fprintf(fp, "%d %0.3f %lu %0.3f %0.3f\n", i, layer->z, layer->offset, layer->time, layer->filament);
+    }
+    fprintf(fp, "; total %lu %0.3f %0.3f\n", gpx->total.bytes, gpx->total.time, gpx->total.length);
+    return ferror(fp) ? ERROR : SUCCESS;
+}
+
+// RESUME
+
+void gpx_set_resume(Gpx *gpx, double z, unsigned line, double hop)
+{
+    gpx->resume.z = z > 0.0 ? z : 0.0;
+    gpx->resume.line = line;
+    gpx->resume.hop = hop > 0.0 ? hop : 0.0;
+    gpx->flag.fastForward = gpx->resume.z > 0.0 || gpx->resume.line > 0;
+}
+
+// PROFILING
+
+// Each phase is charged the time it runs exclusive of the phases it enters,
+// so the phases add up to the conversion time.  Nothing is timed unless
+// gpx_set_profile was called.
+
+static const char *profile_phase[PROFILE_PHASES] = {
+    "input", "parse", "translate", "target", "queue", "encode", "output"
+};
+
+static double profile_clock(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int gpx_set_profile(Gpx *gpx, int format)
+{
+    if(format == PROFILE_OFF) {
+        free(gpx->profile);
+        gpx->profile = NULL;
+        return SUCCESS;
+    }
+    if(gpx->profile == NULL && (gpx->profile = calloc(1, sizeof(Profile))) == NULL)
+        return ERROR;
+    gpx->profile->format = format;
+    gpx->profile->start = profile_clock();
+    return SUCCESS;
+}
+
+static void profile_enter(Profile *profile, int phase)
+{
+    double now = profile_clock();
+    if(profile->depth) {
+        profile->seconds[profile->stack[profile->depth - 1]] += now - profile->mark;
+    }
+    if(profile->depth < PROFILE_DEPTH) {
+        profile->stack[profile->depth++] = phase;
+    }
+    profile->calls[phase]++;
+    profile->mark = now;
+}
+
+// leave phase along with any phase entered since, an error return can skip
+// the leaving of an inner phase
+
+static void profile_leave(Profile *profile, int phase)
+{
+    int depth = profile->depth;
+    while(depth && profile->stack[depth - 1] != phase) depth--;
+    if(depth) {
+        double now = profile_clock();
+        profile->seconds[profile->stack[profile->depth - 1]] += now - profile->mark;
+        profile->depth = depth - 1;
+        profile->mark = now;
+    }
+}
+
+#define PROFILE_ENTER(PHASE) \
+    do { if(gpx->profile) profile_enter(gpx->profile, PHASE); } while(0)
+#define PROFILE_LEAVE(PHASE) \
+    do { if(gpx->profile) profile_leave(gpx->profile, PHASE); } while(0)
+
+// call FN as CALL would, charging its time to PHASE
+
+#define PROFILE_CALL(PHASE, FN) \
+    do { \
+        PROFILE_ENTER(PHASE); \
+        rval = FN; \
+        PROFILE_LEAVE(PHASE); \
+        if(rval != SUCCESS) return rval; \
+    } while(0)
+
+static void profile_report(Gpx *gpx)
+{
+    Profile *profile = gpx->profile;
+    double elapsed = profile_clock() - profile->start;
+    double other = elapsed;
+    int i;
+    for(i = 0; i < PROFILE_PHASES; i++) other -= profile->seconds[i];
+    if(other < 0.0) other = 0.0;
+    if(profile->format == PROFILE_JSON) {
+        fprintf(gpx->log, "{\"lines\": %lu, \"commands\": %lu, \"bytes\": %lu, \"seconds\": %.6f, \"phases\": {",
+                profile->calls[PROFILE_PARSE], gpx->accumulated.commands, gpx->accumulated.bytes, elapsed);
+        for(i = 0; i < PROFILE_PHASES; i++) {
+            fprintf(gpx->log, "\"%s\": {\"seconds\": %.6f, \"calls\": %lu}, ",
+                    profile_phase[i], profile->seconds[i], profile->calls[i]);
+        }
+        fprintf(gpx->log, "\"other\": {\"seconds\": %.6f}}}" EOL, other);
+        return;
+    }
+    fprintf(gpx->log, "Profile: %lu lines, %lu commands, %lu bytes in %0.3f seconds" EOL,
+            profile->calls[PROFILE_PARSE], gpx->accumulated.commands, gpx->accumulated.bytes, elapsed);
+    fprintf(gpx->log, "%-10s %10s %6s %12s" EOL, "phase", "seconds", "%", "calls");
+    for(i = 0; i <= PROFILE_PHASES; i++) {
+        double seconds = i < PROFILE_PHASES ? profile->seconds[i] : other;
+        fprintf(gpx->log, "%-10s %10.4f %6.1f", i < PROFILE_PHASES ? profile_phase[i] : "other",
+                seconds, elapsed > 0.0 ? 100.0 * seconds / elapsed : 0.0);
+        if(i < PROFILE_PHASES) fprintf(gpx->log, " %12lu", profile->calls[i]);
+        fputs(EOL, gpx->log);
+    }
 }
 
 // PRINT STATE
@@ -560,50 +892,9 @@ static long write_string(Gpx *gpx, const char *string, long length)
 
 // FRAMING
 
-static unsigned char calculate_crc(unsigned char *addr, long len)
-{
-    unsigned char data, crc = 0;
-    while(len--) {
-        data = *addr++;
-        // 8-bit iButton/Maxim/Dallas CRC loop unrolled
-        crc = crc ^ data;
-        // 1
-        if (crc & 0x01) crc = (crc >> 1) ^ 0x8C;
-        else crc >>= 1;
-
-        // 2
-        if (crc & 0x01) crc = (crc >> 1) ^ 0x8C;
-        else crc >>= 1;
-
-        // 3
-        if (crc & 0x01) crc = (crc >> 1) ^ 0x8C;
-        else crc >>= 1;
-
-        // 4
-        if (crc & 0x01) crc = (crc >> 1) ^ 0x8C;
-        else crc >>= 1;
-
-        // 5
-        if (crc & 0x01) crc = (crc >> 1) ^ 0x8C;
-        else crc >>= 1;
-
-        // 6
-        if (crc & 0x01) crc = (crc >> 1) ^ 0x8C;
-        else crc >>= 1;
-
-        // 7
-        if (crc & 0x01) crc = (crc >> 1) ^ 0x8C;
-        else crc >>= 1;
-
-        // 8
-        if (crc & 0x01) crc = (crc >> 1) ^ 0x8C;
-        else crc >>= 1;
-    }
-    return crc;
-}
-
 static void begin_frame(Gpx *gpx)
 {
+    PROFILE_ENTER(PROFILE_ENCODE);
     gpx->buffer.ptr = gpx->buffer.out;
     if(gpx->flag.framingEnabled) {
         gpx->buffer.out[0] = 0xD5;  // synchronization byte
@@ -613,17 +904,25 @@ static void begin_frame(Gpx *gpx)
 
 static int end_frame(Gpx *gpx)
 {
+    // before the resume point or in the prescan nothing is output or counted
+    if(gpx->flag.fastForward || gpx->flag.prescan) {
+        PROFILE_LEAVE(PROFILE_ENCODE);
+        return SUCCESS;
+    }
     if(gpx->flag.framingEnabled) {
         unsigned char *start = (unsigned char *)gpx->buffer.out + 2;
         unsigned char *end = (unsigned char *)gpx->buffer.ptr;
         size_t payload_length = end - start;
         gpx->buffer.out[1] = (unsigned char)payload_length;
-        *gpx->buffer.ptr++ = calculate_crc(start, payload_length);
+        *gpx->buffer.ptr++ = crc8(0, start, payload_length);
     }
     size_t length = gpx->buffer.ptr - gpx->buffer.out;
     gpx->accumulated.bytes += length;
+    gpx->accumulated.commands++;
+    PROFILE_LEAVE(PROFILE_ENCODE);
     if(gpx->callbackHandler) {
-        return gpx->callbackHandler(gpx, gpx->callbackData, gpx->buffer.out, length);
+        int rval;
+        PROFILE_CALL(PROFILE_OUTPUT, gpx->callbackHandler(gpx, gpx->callbackData, gpx->buffer.out, length));
     }
     return SUCCESS;
 }
@@ -631,8 +930,9 @@ static int end_frame(Gpx *gpx)
 // no x3g to emit, but the callback might want to look at the parsed command
 static int empty_frame(Gpx *gpx)
 {
-    if(gpx->callbackHandler) {
-        return gpx->callbackHandler(gpx, gpx->callbackData, gpx->buffer.out, 0);
+    if(gpx->callbackHandler && !gpx->flag.fastForward) {
+        int rval;
+        PROFILE_CALL(PROFILE_OUTPUT, gpx->callbackHandler(gpx, gpx->callbackData, gpx->buffer.out, 0));
     }
     return SUCCESS;
 }
@@ -659,77 +959,75 @@ static void set_filament_scale(Gpx *gpx, unsigned extruder_id, double filament_d
     gpx->override[extruder_id].filament_scale = (nominal_radius * nominal_radius) / (actual_radius * actual_radius);
 }
 
-// return the magnitude (length) of the 5D vector
+// MOTION CONSTANTS
 
-static double magnitude(int flag, Ptr5d vector)
+// the 5D rewrite extrudes packing_scale mm of filament per mm of travel
+
+static void update_packing_scale(Gpx *gpx)
 {
-    double acc = 0.0;
-    if(flag & X_IS_SET) {
-        acc = vector->x * vector->x;
-    }
-    if(flag & Y_IS_SET) {
-        acc += vector->y * vector->y;
-    }
-    if(flag & Z_IS_SET) {
-        acc += vector->z * vector->z;
-    }
-    if(flag & A_IS_SET) {
-        acc += vector->a * vector->a;
-    }
-    if(flag & B_IS_SET) {
-        acc += vector->b * vector->b;
-    }
-    return sqrt(acc);
+    gpx->motion.extruder[A].packing_scale = gpx->machine.nozzle_diameter * gpx->layerHeight / gpx->motion.extruder[A].packing_area;
+    gpx->motion.extruder[B].packing_scale = gpx->machine.nozzle_diameter * gpx->layerHeight / gpx->motion.extruder[B].packing_area;
+}
+
+static double packing_area(double filament_diameter, double packing_density)
+{
+    double filament_radius = filament_diameter / 2;
+    return M_PI * filament_radius * filament_radius * packing_density;
 }
 
-// return the largest axis in the vector
+// rebuild the constants after a change to the machine definition, the
+// overrides or the speed and extrusion factors
 
-static double largest_axis(int flag, Ptr5d vector)
+static void update_motion(Gpx *gpx)
 {
-    double length, result = 0.0;
-    if(flag & X_IS_SET) {
-        result = fabs(vector->x);
-    }
-    if(flag & Y_IS_SET) {
-        length = fabs(vector->y);
-        if(result < length) result = length;
+    Motion *motion = &gpx->motion;
+    int i;
+
+    motion->steps_per_mm.x = gpx->machine.x.steps_per_mm;
+    motion->steps_per_mm.y = gpx->machine.y.steps_per_mm;
+    motion->steps_per_mm.z = gpx->machine.z.steps_per_mm;
+    motion->steps_per_mm.a = gpx->machine.a.steps_per_mm;
+    motion->steps_per_mm.b = gpx->machine.b.steps_per_mm;
+
+    motion->max_feedrate = gpx->machine.x.max_feedrate;
+    if(motion->max_feedrate < gpx->machine.y.max_feedrate) {
+        motion->max_feedrate = gpx->machine.y.max_feedrate;
     }
-    if(flag & Z_IS_SET) {
-        length = fabs(vector->z);
-        if(result < length) result = length;
+    if(motion->max_feedrate < gpx->machine.z.max_feedrate) {
+        motion->max_feedrate = gpx->machine.z.max_feedrate;
     }
-    if(flag & A_IS_SET) {
-        length = fabs(vector->a);
-        if(result < length) result = length;
+    if(motion->max_feedrate < gpx->machine.a.max_feedrate) {
+        motion->max_feedrate = gpx->machine.a.max_feedrate;
     }
-    if(flag & B_IS_SET) {
-        length = fabs(vector->b);
-        if(result < length) result = length;
+    if(motion->max_feedrate < gpx->machine.b.max_feedrate) {
+        motion->max_feedrate = gpx->machine.b.max_feedrate;
     }
-    return result;
-}
-
-// calculate the dda for the longest axis for the current machine definition
+    motion->speed_scale = (double)gpx->current.speed_factor / 100;
 
-static int get_longest_dda(Gpx *gpx)
-{
     // 7 February 2015
     // The DDA here is the microseconds/step.  So a larger value is slower.
     // We want the largest value, not the smallest value.  (Bug in original GPX)
+    motion->longest_dda = (int)(60 * 1000000.0 / (gpx->machine.x.max_feedrate * gpx->machine.x.steps_per_mm));
+    int axisDDA = (int)(60 * 1000000.0 / (gpx->machine.y.max_feedrate * gpx->machine.y.steps_per_mm));
+    if(motion->longest_dda > axisDDA) motion->longest_dda = axisDDA;
+    axisDDA = (int)(60 * 1000000.0 / (gpx->machine.z.max_feedrate * gpx->machine.z.steps_per_mm));
+    if(motion->longest_dda > axisDDA) motion->longest_dda = axisDDA;
 
-    // calculate once
-    int longestDDA = gpx->longestDDA;
-    if(longestDDA == 0) {
-        longestDDA = (int)(60 * 1000000.0 / (gpx->machine.x.max_feedrate * gpx->machine.x.steps_per_mm));
-
-        int axisDDA = (int)(60 * 1000000.0 / (gpx->machine.y.max_feedrate * gpx->machine.y.steps_per_mm));
-        if(longestDDA > axisDDA) longestDDA = axisDDA;
-
-        axisDDA = (int)(60 * 1000000.0 / (gpx->machine.z.max_feedrate * gpx->machine.z.steps_per_mm));
-        if(longestDDA > axisDDA) longestDDA = axisDDA;
-        gpx->longestDDA = longestDDA;
+    for(i = 0; i < 2; i++) {
+        Extruder *extruder = i == A ? &gpx->machine.a : &gpx->machine.b;
+        motion->extruder[i].extrusion_scale = (double)gpx->override[i].extrusion_factor / 100;
+        // the rewrite has always used the A packing density override for both
+        if(gpx->override[i].actual_filament_diameter > 0.0001) {
+            motion->extruder[i].packing_area = packing_area(gpx->override[i].actual_filament_diameter, gpx->override[A].packing_density);
+        }
+        else {
+            motion->extruder[i].packing_area = packing_area(gpx->machine.nominal_filament_diameter, gpx->machine.nominal_packing_density);
+        }
+        motion->extruder[i].max_rpm = extruder->max_feedrate * extruder->steps_per_mm / extruder->motor_steps;
+        // steps/revolution * mm/steps
+        motion->extruder[i].mm_per_revolution = extruder->motor_steps * (1 / extruder->steps_per_mm);
     }
-    return longestDDA;
+    update_packing_scale(gpx);
 }
 
 // return the maximum home feedrate
@@ -752,24 +1050,12 @@ static double get_home_feedrate(Gpx *gpx, int flag) {
 
 static double get_safe_feedrate(Gpx *gpx, int flag, Ptr5d delta) {
 
-    double feedrate = gpx->current.feedrate * ((double)gpx->current.speed_factor / 100);
+    double feedrate = gpx->current.feedrate * gpx->motion.speed_scale;
     if(feedrate == 0.0) {
-        feedrate = gpx->machine.x.max_feedrate;
-        if(feedrate < gpx->machine.y.max_feedrate) {
-            feedrate = gpx->machine.y.max_feedrate;
-        }
-        if(feedrate < gpx->machine.z.max_feedrate) {
-            feedrate = gpx->machine.z.max_feedrate;
-        }
-        if(feedrate < gpx->machine.a.max_feedrate) {
-            feedrate = gpx->machine.a.max_feedrate;
-        }
-        if(feedrate < gpx->machine.b.max_feedrate) {
-            feedrate = gpx->machine.b.max_feedrate;
-        }
+        feedrate = gpx->motion.max_feedrate;
     }
 
-    double distance = magnitude(flag & XYZ_BIT_MASK, delta);
+    double distance = point5d_magnitude(flag & XYZ_BIT_MASK, delta);
     if(flag & X_IS_SET && (feedrate * delta->x / distance) > gpx->machine.x.max_feedrate) {
         feedrate = gpx->machine.x.max_feedrate * distance / delta->x;
     }
@@ -805,54 +1091,48 @@ static double get_safe_feedrate(Gpx *gpx, int flag, Ptr5d delta) {
 
 static Point5d mm_to_steps(Gpx *gpx, Ptr5d mm, Ptr2d excess)
 {
-    double value;
     Point5d result;
-    result.x = round(mm->x * gpx->machine.x.steps_per_mm);
-    result.y = round(mm->y * gpx->machine.y.steps_per_mm);
-    result.z = round(mm->z * gpx->machine.z.steps_per_mm);
-    if(excess) {
-        // accumulate rounding remainder
-        value = (mm->a * gpx->machine.a.steps_per_mm) + excess->a;
-        result.a = round(value);
-        // changes to excess
-        excess->a = value - result.a;
-
-        value = (mm->b * gpx->machine.b.steps_per_mm) + excess->b;
-        result.b = round(value);
-        // changes to excess
-        excess->b = value - result.b;
+    if(gpx->flag.fixedPoint) {
+        point5d_to_steps_fixed(&gpx->motion.steps_per_mm, mm, &result, 1, excess);
     }
     else {
-        result.a = round(mm->a * gpx->machine.a.steps_per_mm);
-        result.b = round(mm->b * gpx->machine.b.steps_per_mm);
+        point5d_to_steps(&gpx->motion.steps_per_mm, mm, &result, 1, excess);
     }
     return result;
 }
 
+// compute the relative distance traveled along each axis
+
 static Point5d delta_mm(Gpx *gpx)
 {
-    Point5d deltaMM;
-    // compute the relative distance traveled along each axis
-    if(gpx->command.flag & X_IS_SET) deltaMM.x = gpx->target.position.x - gpx->current.position.x; else deltaMM.x = 0;
-    if(gpx->command.flag & Y_IS_SET) deltaMM.y = gpx->target.position.y - gpx->current.position.y; else deltaMM.y = 0;
-    if(gpx->command.flag & Z_IS_SET) deltaMM.z = gpx->target.position.z - gpx->current.position.z; else deltaMM.z = 0;
-    if(gpx->command.flag & A_IS_SET) deltaMM.a = (gpx->target.position.a - gpx->current.position.a) * gpx->override[A].extrusion_factor / 100; else deltaMM.a = 0;
-    if(gpx->command.flag & B_IS_SET) deltaMM.b = (gpx->target.position.b - gpx->current.position.b) * gpx->override[B].extrusion_factor / 100; else deltaMM.b = 0;
-    return deltaMM;
+    unsigned percent[2] = { gpx->override[A].extrusion_factor, gpx->override[B].extrusion_factor };
+    return point5d_delta(gpx->command.flag, &gpx->target.position, &gpx->current.position, percent);
 }
 
+// convert the relative distance traveled along each axis from units of mm to steps
+
 static Point5d delta_steps(Gpx *gpx,Point5d deltaMM)
 {
     Point5d deltaSteps;
-    // Convert the relative distance traveled along each axis from units of mm to steps
-    if(gpx->command.flag & X_IS_SET) deltaSteps.x = round(fabs(deltaMM.x) * gpx->machine.x.steps_per_mm); else deltaSteps.x = 0;
-    if(gpx->command.flag & Y_IS_SET) deltaSteps.y = round(fabs(deltaMM.y) * gpx->machine.y.steps_per_mm); else deltaSteps.y = 0;
-    if(gpx->command.flag & Z_IS_SET) deltaSteps.z = round(fabs(deltaMM.z) * gpx->machine.z.steps_per_mm); else deltaSteps.z = 0;
-    if(gpx->command.flag & A_IS_SET) deltaSteps.a = round(fabs(deltaMM.a) * gpx->machine.a.steps_per_mm); else deltaSteps.a = 0;
-    if(gpx->command.flag & B_IS_SET) deltaSteps.b = round(fabs(deltaMM.b) * gpx->machine.b.steps_per_mm); else deltaSteps.b = 0;
+    if(gpx->flag.fixedPoint) {
+        point5d_delta_steps_fixed(gpx->command.flag, &gpx->motion.steps_per_mm, &deltaMM, &deltaSteps, 1);
+    }
+    else {
+        point5d_delta_steps(gpx->command.flag, &gpx->motion.steps_per_mm, &deltaMM, &deltaSteps, 1);
+    }
     return deltaSteps;
 }
 
+// the absolute step count of one extruder's travel
+
+static double extruder_steps(Gpx *gpx, int extruder, double mm)
+{
+    if(gpx->flag.fixedPoint) {
+        return steps_fixed(extruder == A ? gpx->machine.a.steps_per_mm : gpx->machine.b.steps_per_mm, fabs(mm));
+    }
+    return round(fabs(mm) * (extruder == A ? gpx->machine.a.steps_per_mm : gpx->machine.b.steps_per_mm));
+}
+
 static void set_unknown_axes(Gpx *gpx, int flag)
 {
     gpx->axis.positionKnown &= ~(flag & gpx->axis.mask);
@@ -1414,12 +1694,14 @@ static int home_axes(Gpx *gpx, unsigned axes, unsigned direction)
     }
 
     // unit vector distance in mm
-    double distance = magnitude(axes, &unitVector);
+    double distance = point5d_magnitude(axes, &unitVector);
     // move duration in microseconds = distance / feedrate * 60,000,000
     double microseconds = distance / feedrate * 60000000.0;
     // time between steps for longest axis = microseconds / longestStep
     unsigned step_delay = (unsigned)round(microseconds / longestAxis);
 
+    // homing runs to completion before the next move is planned
+    planner_stop(&gpx->planner);
     gpx->accumulated.time += distance / feedrate * 60;
 
     begin_frame(gpx);
@@ -1442,6 +1724,8 @@ static int home_axes(Gpx *gpx, unsigned axes, unsigned direction)
 
 int delay(Gpx *gpx, unsigned milliseconds)
 {
+    planner_stop(&gpx->planner);
+
     begin_frame(gpx);
 
     write_8(gpx, 133);
@@ -1477,6 +1761,8 @@ static int wait_for_extruder(Gpx *gpx, unsigned extruder_id, unsigned timeout)
 {
     assert(extruder_id < gpx->machine.extruder_count);
 
+    planner_stop(&gpx->planner);
+
     begin_frame(gpx);
 
     write_8(gpx, 135);
@@ -1547,6 +1833,7 @@ static int set_fan(Gpx *gpx, unsigned extruder_id, unsigned state)
     // uint8: 1 to enable, 0 to disable
     write_8(gpx, state);
 
+    gpx->tool[extruder_id].fan = state;
     return end_frame(gpx);
 }
 
@@ -1588,6 +1875,7 @@ static int set_valve(Gpx *gpx, unsigned extruder_id, unsigned state)
         // uint8: 1 to enable, 0 to disable
         write_8(gpx, state);
 
+        gpx->tool[extruder_id].valve = state;
         return end_frame(gpx);
     }
     else if(gpx->flag.logMessages) {
@@ -1684,10 +1972,10 @@ static int set_steppers(Gpx *gpx, unsigned axes, unsigned state)
 static int queue_absolute_point(Gpx *gpx)
 {
     double feedrate;
-    long longestDDA = gpx->longestDDA ? gpx->longestDDA : get_longest_dda(gpx);
+    long longestDDA = gpx->motion.longest_dda;
     Point5d steps = mm_to_steps(gpx, &gpx->target.position, &gpx->excess);
 
-    feedrate = gpx->current.feedrate * ((double)gpx->current.speed_factor / 100);
+    feedrate = gpx->current.feedrate * gpx->motion.speed_scale;
 
     // 7 February 2015
     // Fix issue #12 whereby an unaccelerated move may move far too fast
@@ -1785,6 +2073,8 @@ static int wait_for_build_platform(Gpx *gpx, unsigned extruder_id, int timeout)
 {
     assert(extruder_id < gpx->machine.extruder_count);
 
+    planner_stop(&gpx->planner);
+
     begin_frame(gpx);
 
     write_8(gpx, 141);
@@ -1819,33 +2109,31 @@ static int queue_new_point(Gpx *gpx, unsigned milliseconds)
 
     // if we have a G4 dwell and either the a or b motor is on, 'simulate' a 5D extrusion distance
     if(gpx->tool[A].motor_enabled && gpx->tool[A].rpm) {
-        double maxrpm = gpx->machine.a.max_feedrate * gpx->machine.a.steps_per_mm / gpx->machine.a.motor_steps;
+        double maxrpm = gpx->motion.extruder[A].max_rpm;
         double rpm = gpx->tool[A].rpm > maxrpm ? maxrpm : gpx->tool[A].rpm;
         double minutes = milliseconds / 60000.0;
         // minute * revolution/minute
         double numRevolutions = minutes * (gpx->tool[A].motor_enabled > 0 ? rpm : -rpm);
-        // steps/revolution * mm/steps
-        double mmPerRevolution = gpx->machine.a.motor_steps * (1 / gpx->machine.a.steps_per_mm);
-        target.a = -(numRevolutions * mmPerRevolution);
+        target.a = -(numRevolutions * gpx->motion.extruder[A].mm_per_revolution);
         gpx->command.flag |= A_IS_SET;
         gpx->accumulated.a += fabs(target.a);
     }
 
     if(gpx->tool[B].motor_enabled && gpx->tool[B].rpm) {
-        double maxrpm = gpx->machine.b.max_feedrate * gpx->machine.b.steps_per_mm / gpx->machine.b.motor_steps;
+        double maxrpm = gpx->motion.extruder[B].max_rpm;
         double rpm = gpx->tool[B].rpm > maxrpm ? maxrpm : gpx->tool[B].rpm;
         double minutes = milliseconds / 60000.0;
         // minute * revolution/minute
         double numRevolutions = minutes * (gpx->tool[B].motor_enabled > 0 ? rpm : -rpm);
-        // steps/revolution * mm/steps
-        double mmPerRevolution = gpx->machine.b.motor_steps * (1 / gpx->machine.b.steps_per_mm);
-        target.b = -(numRevolutions * mmPerRevolution);
+        target.b = -(numRevolutions * gpx->motion.extruder[B].mm_per_revolution);
         gpx->command.flag |= B_IS_SET;
         gpx->accumulated.b += fabs(target.a);
     }
 
     Point5d steps = mm_to_steps(gpx, &target, &gpx->excess);
 
+    planner_stop(&gpx->planner);
+
     gpx->accumulated.time += (milliseconds / 1000.0) * ACCELERATION_TIME;
 
     begin_frame(gpx);
@@ -2014,6 +2302,8 @@ static int set_beep(Gpx *gpx, unsigned frequency, unsigned milliseconds)
 #ifdef FUTURE
 static int wait_for_button(Gpx *gpx, int button, unsigned timeout, int button_options)
 {
+    planner_stop(&gpx->planner);
+
     begin_frame(gpx);
 
     write_8(gpx, 148);
@@ -2088,11 +2378,30 @@ static int display_message(Gpx *gpx, char *message, unsigned vPos, unsigned hPos
     return SUCCESS;
 }
 
+// remember build progress to be resolved once the total time is known
+
+static int add_progress_mark(Gpx *gpx, int type, unsigned percent, unsigned force)
+{
+    ProgressMark pm;
+    if(gpx->flag.fastForward || gpx->flag.prescan) return SUCCESS;
+    pm.offset = gpx->accumulated.bytes;
+    pm.commands = gpx->accumulated.commands;
+    pm.type = type;
+    pm.percent = percent;
+    pm.force = force;
+    pm.extruder = gpx->current.extruder;
+    pm.time = gpx->accumulated.time;
+    return vector_append(gpx->progressMarks, &pm) < 0 ? ERROR : SUCCESS;
+}
+
 // 150 - Set Build Percentage
 
 int set_build_progress(Gpx *gpx, unsigned percent)
 {
     if(percent > 100) percent = 100;
+    if(gpx->progressMarks && add_progress_mark(gpx, PROGRESS_SET, percent, 0) != SUCCESS) {
+        return ERROR;
+    }
     gpx->current.percent = percent;
 
     begin_frame(gpx);
@@ -2216,52 +2525,33 @@ static int queue_ext_point(Gpx *gpx, double feedrate, Ptr5d delta, int relative)
 
     // check that we have actually moved on at least one axis when the move is
     // rounded down to the nearest step
-    if(magnitude(gpx->command.flag, &deltaSteps) > 0) {
-        double distance = magnitude(gpx->command.flag & XYZ_BIT_MASK, &deltaMM);
+    if(point5d_magnitude(gpx->command.flag, &deltaSteps) > 0) {
+        double distance = point5d_magnitude(gpx->command.flag & XYZ_BIT_MASK, &deltaMM);
         // are we moving and extruding?
         if(gpx->flag.rewrite5D && (gpx->command.flag & (A_IS_SET|B_IS_SET)) && distance > 0.0001) {
-            double filament_radius, packing_area, packing_scale;
             if(A_IS_SET && deltaMM.a > 0.0001) {
-                if(gpx->override[A].actual_filament_diameter > 0.0001) {
-                    filament_radius = gpx->override[A].actual_filament_diameter / 2;
-                    packing_area = M_PI * filament_radius * filament_radius * gpx->override[A].packing_density;
-                }
-                else {
-                    filament_radius = gpx->machine.nominal_filament_diameter / 2;
-                    packing_area = M_PI * filament_radius * filament_radius * gpx->machine.nominal_packing_density;
-                }
-                packing_scale = gpx->machine.nozzle_diameter * gpx->layerHeight / packing_area;
                 if(deltaMM.a > 0) {
-                    deltaMM.a = distance * packing_scale;
+                    deltaMM.a = distance * gpx->motion.extruder[A].packing_scale;
                 }
                 else {
-                    deltaMM.a = -(distance * packing_scale);
+                    deltaMM.a = -(distance * gpx->motion.extruder[A].packing_scale);
                 }
-                deltaMM.a *= ((double)gpx->override[A].extrusion_factor / 100);
+                deltaMM.a *= gpx->motion.extruder[A].extrusion_scale;
                 if(gpx->axis.positionKnown & A_IS_SET)
                     gpx->target.position.a = gpx->current.position.a + deltaMM.a;
-                deltaSteps.a = round(fabs(deltaMM.a) * gpx->machine.a.steps_per_mm);
+                deltaSteps.a = extruder_steps(gpx, A, deltaMM.a);
             }
             if(B_IS_SET && deltaMM.b > 0.0001) {
-                if(gpx->override[B].actual_filament_diameter > 0.0001) {
-                    filament_radius = gpx->override[B].actual_filament_diameter / 2;
-                    packing_area = M_PI * filament_radius * filament_radius * gpx->override[A].packing_density;
-                }
-                else {
-                    filament_radius = gpx->machine.nominal_filament_diameter / 2;
-                    packing_area = M_PI * filament_radius * filament_radius * gpx->machine.nominal_packing_density;
-                }
-                packing_scale = gpx->machine.nozzle_diameter * gpx->layerHeight / packing_area;
                 if(deltaMM.b > 0) {
-                    deltaMM.b = distance * packing_scale;
+                    deltaMM.b = distance * gpx->motion.extruder[B].packing_scale;
                 }
                 else {
-                    deltaMM.b = -(distance * packing_scale);
+                    deltaMM.b = -(distance * gpx->motion.extruder[B].packing_scale);
                 }
-                deltaMM.b *= ((double)gpx->override[B].extrusion_factor / 100);
+                deltaMM.b *= gpx->motion.extruder[B].extrusion_scale;
                 if(gpx->axis.positionKnown & B_IS_SET)
                     gpx->target.position.b = gpx->current.position.b + deltaMM.b;
-                deltaSteps.b = round(fabs(deltaMM.b) * gpx->machine.b.steps_per_mm);
+                deltaSteps.b = extruder_steps(gpx, B, deltaMM.b);
             }
         }
 
@@ -2282,6 +2572,8 @@ static int queue_ext_point(Gpx *gpx, double feedrate, Ptr5d delta, int relative)
         gpx->accumulated.a += deltaMM.a;
         gpx->accumulated.b += deltaMM.b;
 
+        Point5d travel = deltaMM;
+
         deltaMM.x = fabs(deltaMM.x);
         deltaMM.y = fabs(deltaMM.y);
         deltaMM.z = fabs(deltaMM.z);
@@ -2308,15 +2600,13 @@ static int queue_ext_point(Gpx *gpx, double feedrate, Ptr5d delta, int relative)
 #if ENABLE_SIMULATED_RPM
         // if either a or b is 0, but their motor is on and turning, 'simulate' a 5D extrusion distance
         if(deltaMM.a == 0.0 && gpx->tool[A].motor_enabled && gpx->tool[A].rpm) {
-            double maxrpm = gpx->machine.a.max_feedrate * gpx->machine.a.steps_per_mm / gpx->machine.a.motor_steps;
+            double maxrpm = gpx->motion.extruder[A].max_rpm;
             double rpm = gpx->tool[A].rpm > maxrpm ? maxrpm : gpx->tool[A].rpm;
             // minute * revolution/minute
             double numRevolutions = minutes * (gpx->tool[A].motor_enabled > 0 ? rpm : -rpm);
-            // steps/revolution * mm/steps
-            double mmPerRevolution = gpx->machine.a.motor_steps * (1 / gpx->machine.a.steps_per_mm);
             // set distance
-            deltaMM.a = numRevolutions * mmPerRevolution;
-            deltaSteps.a = round(fabs(deltaMM.a) * gpx->machine.a.steps_per_mm);
+            deltaMM.a = numRevolutions * gpx->motion.extruder[A].mm_per_revolution;
+            deltaSteps.a = extruder_steps(gpx, A, deltaMM.a);
             target.a = -deltaMM.a;
         }
         else {
@@ -2324,15 +2614,13 @@ static int queue_ext_point(Gpx *gpx, double feedrate, Ptr5d delta, int relative)
             gpx->tool[A].rpm = 0;
         }
         if(deltaMM.b == 0.0 && gpx->tool[B].motor_enabled && gpx->tool[B].rpm) {
-            double maxrpm = gpx->machine.b.max_feedrate * gpx->machine.b.steps_per_mm / gpx->machine.b.motor_steps;
+            double maxrpm = gpx->motion.extruder[B].max_rpm;
             double rpm = gpx->tool[B].rpm > maxrpm ? maxrpm : gpx->tool[B].rpm;
             // minute * revolution/minute
             double numRevolutions = minutes * (gpx->tool[B].motor_enabled > 0 ? rpm : -rpm);
-            // steps/revolution * mm/steps
-            double mmPerRevolution = gpx->machine.b.motor_steps * (1 / gpx->machine.b.steps_per_mm);
             // set distance
-            deltaMM.b = numRevolutions * mmPerRevolution;
-            deltaSteps.b = round(fabs(deltaMM.b) * gpx->machine.b.steps_per_mm);
+            deltaMM.b = numRevolutions * gpx->motion.extruder[B].mm_per_revolution;
+            deltaSteps.b = extruder_steps(gpx, B, deltaMM.b);
             target.b = -deltaMM.b;
         }
         else {
@@ -2343,20 +2631,28 @@ static int queue_ext_point(Gpx *gpx, double feedrate, Ptr5d delta, int relative)
 
         Point5d steps = mm_to_steps(gpx, &target, &gpx->excess);
 
+        if(gpx->planner.window) {
+            gpx->accumulated.time += planner_add(&gpx->planner, &gpx->machine, &travel, distance, feedrate);
+        }
+        else {
+            gpx->accumulated.time += (minutes * 60) * ACCELERATION_TIME;
+        }
+
+        // the prescan only needs the step remainders and the time
+        if(gpx->flag.prescan) return SUCCESS;
+
 	// Total time required for the motion in units of microseconds
         double usec = (60000000.0L * minutes);
 
 	// Time interval between steps along the axis with the highest step count
 	//   total-time / highest-step-count
 	// Has units of microseconds per step
-        double dda_interval = usec / largest_axis(gpx->command.flag, &deltaSteps);
+        double dda_interval = usec / point5d_largest_axis(gpx->command.flag, &deltaSteps);
 
         // Convert dda_interval into dda_rate (dda steps per second on the longest axis)
 	// steps-per-microsecond * 1000000 us/s = 1000000 * (1 / dda_interval)
         double dda_rate = 1000000.0L / dda_interval;
 
-        gpx->accumulated.time += (minutes * 60) * ACCELERATION_TIME;
-
         begin_frame(gpx);
 
         write_8(gpx, 155);
@@ -2524,6 +2820,10 @@ static int add_command_at(Gpx *gpx, double z, char *filament_id, unsigned nozzle
     if(gpx->commandAtLength < COMMAND_AT_MAX) {
         if(gpx->flag.loadMacros) {
             int i = gpx->commandAtLength;
+            // a single pass has already run the body without this command
+            if(gpx->progressMarks && (gpx->flag.macrosEnabled || gpx->flag.programState == ENDED_STATE)) {
+                gpx->flag.needSecondPass = 1;
+            }
             if(z <= gpx->commandAtZ) {
                 // make a space
                 while(i > 0 && z <= gpx->commandAt[i - 1].z) {
@@ -3105,6 +3405,10 @@ static int calculate_target_position(Gpx *gpx, Ptr5d delta, int *relative)
 
     // CHECK FOR COMMAND @ Z POS
 
+    // a checkpoint needs to know how high a span went to know if a command
+    // it didn't reach would have been
+    if(gpx->target.position.z > gpx->commandAtReached) gpx->commandAtReached = gpx->target.position.z;
+
     // check if there are more commands on the stack
     if(gpx->flag.macrosEnabled && gpx->flag.runMacros && gpx->commandAtIndex < gpx->commandAtLength) {
         // check if the next command will cross the z threshold
@@ -3197,8 +3501,28 @@ static int calculate_target_position(Gpx *gpx, Ptr5d delta, int *relative)
     return SUCCESS;
 }
 
+// a move to a new Z might start a layer, it does once a move extrudes there
+// above the layers indexed before
+
+static void index_layer(Gpx *gpx)
+{
+    LayerIndex *index = &gpx->layerIndex;
+    if(gpx->target.position.z != gpx->current.position.z) {
+        index->start.z = gpx->target.position.z;
+        index->start.offset = gpx->accumulated.bytes;
+        index->start.time = gpx->accumulated.time;
+        index->start.filament = gpx->accumulated.a + gpx->accumulated.b;
+    }
+    if(index->start.z > index->z && !gpx->flag.fastForward
+       && (gpx->target.position.a > gpx->current.position.a || gpx->target.position.b > gpx->current.position.b)
+       && vector_append(index->layers, &index->start) >= 0) {
+        index->z = index->start.z;
+    }
+}
+
 static void update_current_position(Gpx *gpx)
 {
+    if(gpx->layerIndex.layers) index_layer(gpx);
     // the current position to tracks where the print head currently is
     if(gpx->target.position.z != gpx->current.position.z) {
         // calculate layer height
@@ -3207,11 +3531,137 @@ static void update_current_position(Gpx *gpx)
         if(gpx->layerHeight > (gpx->machine.nozzle_diameter * 0.85)) {
             gpx->layerHeight = gpx->machine.nozzle_diameter * 0.85;
         }
+        update_packing_scale(gpx);
     }
     gpx->current.position = gpx->target.position;
     if(!gpx->flag.relativeCoordinates) gpx->axis.positionKnown |= (gpx->command.flag & gpx->axis.mask);
 }
 
+// ARCS
+
+// G2 and G3 are converted as a run of straight moves along the arc in the XY
+// plane.  Each chord strays no further from the arc than ARC_TOLERANCE, or a
+// step where that is coarser, and Z and the extruders move in proportion to
+// the angle turned.
+
+// the centre of an arc given its radius, the shorter arc for a positive
+// radius and the longer for a negative one, as NIST RS274NGC has it
+
+static int arc_centre(Gpx *gpx, int clockwise, double radius, Point2d *offset)
+{
+    double x = gpx->target.position.x - gpx->current.position.x;
+    double y = gpx->target.position.y - gpx->current.position.y;
+    double chord = hypot(x, y);
+    double h = 4.0 * radius * radius - chord * chord;
+    if(chord == 0.0) return ERROR;
+    // a half circle can come out a little short of the chord
+    if(h < 0.0) {
+        if(-h > 4.0 * ARC_TOLERANCE * chord) return ERROR;
+        h = 0.0;
+    }
+    h = -sqrt(h) / chord;
+    if(!clockwise) h = -h;
+    if(radius < 0.0) h = -h;
+    offset->a = 0.5 * (x - y * h);
+    offset->b = 0.5 * (y + x * h);
+    return SUCCESS;
+}
+
+static int convert_arc(Gpx *gpx, int clockwise)
+{
+    int rval, relative;
+    unsigned i, segments;
+    Point5d delta;
+    Point2d offset;
+    double userScale = gpx->flag.macrosEnabled ? gpx->user.scale : 1.0;
+    int known = (gpx->axis.positionKnown & (X_IS_SET | Y_IS_SET)) == (X_IS_SET | Y_IS_SET);
+
+    PROFILE_CALL(PROFILE_TARGET, calculate_target_position(gpx, &delta, &relative));
+
+    if(gpx->command.flag & (I_IS_SET | J_IS_SET)) {
+        offset.a = (gpx->command.flag & I_IS_SET ? gpx->command.i : 0.0) * userScale;
+        offset.b = (gpx->command.flag & J_IS_SET ? gpx->command.j : 0.0) * userScale;
+    }
+    else if(!(gpx->command.flag & R_IS_SET)) {
+        gcodeResult(gpx, "(line %u) Syntax error: G%u is missing the arc centre, use In Jn or Rn" EOL, gpx->lineNumber, gpx->command.g);
+        known = 0;
+    }
+    else if(known && arc_centre(gpx, clockwise, gpx->command.r * userScale, &offset) != SUCCESS) {
+        gcodeResult(gpx, "(line %u) Semantic warning: G%u radius R%g cannot reach the end point" EOL, gpx->lineNumber, gpx->command.g, gpx->command.r);
+        known = 0;
+    }
+
+    // without a start and centre there is no arc, so go straight to the end
+    if(!known) {
+        PROFILE_CALL(PROFILE_QUEUE, queue_ext_point(gpx, 0.0, &delta, relative));
+        update_current_position(gpx);
+        return SUCCESS;
+    }
+
+    Point5d start = gpx->current.position;
+    Point5d end = gpx->target.position;
+    double cx = start.x + offset.a;
+    double cy = start.y + offset.b;
+    double radius = hypot(offset.a, offset.b);
+    double angle = atan2(end.y - cy, end.x - cx) - atan2(-offset.b, -offset.a);
+    // G2 turns clockwise and G3 anti-clockwise, back to the start is a full circle
+    if(clockwise) {
+        if(angle >= -ARC_ANGLE_EPSILON) angle -= 2.0 * M_PI;
+    }
+    else {
+        if(angle <= ARC_ANGLE_EPSILON) angle += 2.0 * M_PI;
+    }
+
+    // the largest angle whose chord keeps within the tolerance
+    double tolerance = ARC_TOLERANCE;
+    double resolution = 1.0 / (gpx->motion.steps_per_mm.x < gpx->motion.steps_per_mm.y ? gpx->motion.steps_per_mm.x : gpx->motion.steps_per_mm.y);
+    if(tolerance < resolution) tolerance = resolution;
+    double step = tolerance < radius ? 2.0 * acos(1.0 - tolerance / radius) : M_PI / 2;
+    if(step > M_PI / 2) step = M_PI / 2;
+    segments = (unsigned)ceil(fabs(angle) / step);
+    if(segments < 1) segments = 1;
+    step = angle / segments;
+
+    // turn the radius by step for each chord, recalculating it outright now
+    // and again so the rounding error can't build up
+    double cosStep = cos(step);
+    double sinStep = sin(step);
+    double rx = -offset.a;
+    double ry = -offset.b;
+    gpx->command.flag |= X_IS_SET | Y_IS_SET;
+    for(i = 1; i <= segments; i++) {
+        if(i == segments) {
+            gpx->target.position = end;
+        }
+        else {
+            double fraction = (double)i / segments;
+            if(i % ARC_CORRECTION == 0) {
+                double a = atan2(-offset.b, -offset.a) + i * step;
+                rx = radius * cos(a);
+                ry = radius * sin(a);
+            }
+            else {
+                double x = rx * cosStep - ry * sinStep;
+                ry = rx * sinStep + ry * cosStep;
+                rx = x;
+            }
+            gpx->target.position.x = cx + rx;
+            gpx->target.position.y = cy + ry;
+            gpx->target.position.z = start.z + (end.z - start.z) * fraction;
+            gpx->target.position.a = start.a + (end.a - start.a) * fraction;
+            gpx->target.position.b = start.b + (end.b - start.b) * fraction;
+        }
+        delta.x = gpx->target.position.x - gpx->current.position.x;
+        delta.y = gpx->target.position.y - gpx->current.position.y;
+        delta.z = gpx->target.position.z - gpx->current.position.z;
+        delta.a = gpx->target.position.a - gpx->current.position.a;
+        delta.b = gpx->target.position.b - gpx->current.position.b;
+        PROFILE_CALL(PROFILE_QUEUE, queue_ext_point(gpx, 0.0, &delta, 0));
+        update_current_position(gpx);
+    }
+    return SUCCESS;
+}
+
 // TOOL CHANGE
 
 static int do_tool_change(Gpx *gpx, int timeout) {
@@ -3263,9 +3713,10 @@ static int do_tool_change(Gpx *gpx, int timeout) {
     //
     // Only gotcha here is that we may only do this when the position is
     // well defined.  For example, we cannot do this for a tool change
-    // immediately after a 'recall home offsets' command.
+    // immediately after a 'recall home offsets' command.  Before the resume
+    // point there's nothing to queue, the resume selects the tool again.
 
-    if(gpx->axis.mask == (gpx->axis.positionKnown & gpx->axis.mask)) {
+    if(!gpx->flag.fastForward && gpx->axis.mask == (gpx->axis.positionKnown & gpx->axis.mask)) {
         gpx->target.position = gpx->current.position;
         VERBOSE( gcodeResult(gpx, "(line %u) queuing an absolute point to ", gpx->lineNumber) );
         VERBOSE( show_current_pos(gpx) );
@@ -3309,62 +3760,20 @@ static long get_filesize(FILE *file)
 }
 #endif // FUTURE
 
-// clean up the gcode command for processing
-
-static char *normalize_word(char* p)
-{
-    // we expect a letter followed by a digit
-    // [ a-zA-Z] [ +-]? [ 0-9]+ ('.' [ 0-9]*)?
-    char *s = p + 1;
-    char *e = p;
-    while(isspace(*s)) s++;
-    if(*s == '+' || *s == '-') {
-        *e++ = *s++;
-    }
-    while(1) {
-        // skip spaces
-        if(isspace(*s)) {
-            s++;
-        }
-        // append digits
-        else if(isdigit(*s)) {
-            *e++ = *s++;
-        }
-        else {
-            break;
-        }
-    }
-    if(*s == '.') {
-        *e++ = *s++;
-        while(1) {
-            // skip spaces
-            if(isspace(*s)) {
-                s++;
-            }
-            // append digits
-            else if(isdigit(*s)) {
-                *e++ = *s++;
-            }
-            else {
-                break;
-            }
-        }
-    }
-    *e = 0;
-    return s;
-}
-
 // clean up the gcode comment for processing
 
-static char *normalize_comment(char *p) {
+static char *trim_comment(char *p, char *e) {
     // strip white space from the end of comment
-    char *e = p + strlen(p);
-    while (e > p && isspace((unsigned char)(*--e))) *e = '\0';
+    while (e > p && IS_SPACE(*--e)) *e = '\0';
     // strip white space from the beginning of comment.
-    while(isspace(*p)) p++;
+    while(IS_SPACE(*p)) p++;
     return p;
 }
 
+static char *normalize_comment(char *p) {
+    return trim_comment(p, p + strlen(p));
+}
+
 // MACRO PARSER
 
 /* format
@@ -4048,8 +4457,11 @@ int gpx_set_property(Gpx *gpx, const char* section, const char* property, char*
      // If there is no section name or the section name has no comma, then
      // just set the property
 
-     if(!section || !(ptr = strchr(section, ',')))
-	  return gpx_set_property_inner(gpx, section, property, value);
+     if(!section || !(ptr = strchr(section, ','))) {
+	  iret = gpx_set_property_inner(gpx, section, property, value);
+	  update_motion(gpx);
+	  return iret;
+     }
 
      // Section name has a comma
      // Strip LWSP and call gpx_set_property_inner() once for each section
@@ -4091,6 +4503,7 @@ done:
      if(tmp0)
 	  free(tmp0);
 
+     update_motion(gpx);
      return iret;
 }
 
@@ -4122,6 +4535,10 @@ int gpx_set_property_inner(Gpx *gpx, const char* section, const char* property,
         else if(PROPERTY_IS("build_progress")) gpx->flag.buildProgress = atoi(value);
         else if(PROPERTY_IS("packing_density")) gpx->machine.nominal_packing_density = strtod(value, NULL);
         else if(PROPERTY_IS("recalculate_5d")) gpx->flag.rewrite5D = atoi(value);
+        else if(PROPERTY_IS("coalesce_tolerance")) gpx->coalesce.tolerance = strtod(value, NULL);
+        else if(PROPERTY_IS("planner_window")) gpx_set_planner(gpx, atoi(value));
+        else if(PROPERTY_IS("fixed_point")) gpx->flag.fixedPoint = atoi(value) != 0;
+        else if(PROPERTY_IS("resume_hop")) gpx->resume.hop = strtod(value, NULL);
         else if(PROPERTY_IS("nominal_filament_diameter")
                 || PROPERTY_IS("slicer_filament_diameter")
                 || PROPERTY_IS("filament_diameter")) {
@@ -4359,6 +4776,13 @@ void gpx_start_convert(Gpx *gpx, char *buildName, int item_code, ...)
     if(buildName)
         set_build_name(gpx, buildName);
 
+    if(gpx->profile) {
+        int format = gpx->profile->format;
+        memset(gpx->profile, 0, sizeof(Profile));
+        gpx->profile->format = format;
+        gpx->profile->start = profile_clock();
+    }
+
     if(gpx->flag.dittoPrinting && gpx->machine.extruder_count == 1) {
         SHOW( fputs("Configuration error: ditto printing cannot access non-existant second extruder" EOL, gpx->log) );
         gpx->flag.dittoPrinting = 0;
@@ -4375,6 +4799,9 @@ void gpx_start_convert(Gpx *gpx, char *buildName, int item_code, ...)
        && gpx->override[B].actual_filament_diameter != gpx->machine.nominal_filament_diameter) {
         set_filament_scale(gpx, B, gpx->override[B].actual_filament_diameter);
     }
+
+    // pick up overrides made directly to the context
+    update_motion(gpx);
 }
 
 // M105: Get Extruder Temperature
@@ -4402,28 +4829,127 @@ static int get_extruder_temperature_extended(Gpx *gpx)
     return SUCCESS;
 }
 
+static int convert_line(Gpx *gpx, char *gcode_line);
+static int convert_command(Gpx *gpx);
+static int coalesce_flush(Gpx *gpx);
+
+// run the macro in s, the macro name up to the first space then its arguments
+
+static int convert_macro(Gpx *gpx, char *s)
+{
+    int rval;
+    char *macro = s;
+    // a macro may emit commands of its own, so convert any held moves first
+    CALL( coalesce_flush(gpx) );
+    // skip any no space characters
+    while(*s && !IS_SPACE(*s)) s++;
+    // null terminate
+    if(*s) *s++ = 0;
+    rval = parse_macro(gpx, macro, normalize_comment(s));
+    update_motion(gpx);
+    return rval;
+}
+
 int gpx_convert_line(Gpx *gpx, char *gcode_line)
 {
-    int i, rval;
+    int rval;
+    if(gpx->profile == NULL) return convert_line(gpx, gcode_line);
+    profile_enter(gpx->profile, PROFILE_PARSE);
+    rval = convert_line(gpx, gcode_line);
+    profile_leave(gpx->profile, PROFILE_PARSE);
+    return rval;
+}
+
+// MOVE STREAM
+
+// set gpx->command from the move, as the parser would from the same line
+
+static int convert_move(Gpx *gpx, const GpxMove *move)
+{
+    char comment[BUFFER_MAX + 1];
+    int rval;
+    gpx->command.x = move->x;
+    gpx->command.y = move->y;
+    gpx->command.z = move->z;
+    gpx->command.a = move->a;
+    gpx->command.b = move->b;
+    gpx->command.e = move->e;
+    gpx->command.f = move->f;
+    gpx->command.i = move->i;
+    gpx->command.j = move->j;
+    gpx->command.p = move->p;
+    gpx->command.r = move->r;
+    gpx->command.s = move->s;
+    gpx->command.g = move->g;
+    gpx->command.m = move->m;
+    gpx->command.t = move->t;
+    gpx->command.flag = move->flag & MOVE_BIT_MASK;
+    if(move->comment) {
+        strncpy(comment, move->comment, BUFFER_MAX);
+        comment[BUFFER_MAX] = 0;
+        // M23 and M28 take the rest of the line as the filename
+        if(gpx->command.flag & M_IS_SET && (gpx->command.m == 23 || gpx->command.m == 28)) {
+            gpx->command.arg = normalize_comment(comment);
+            gpx->command.flag |= ARG_IS_SET;
+        }
+        else if(comment[0] == '@' && IS_ALPHA(comment[1])) {
+            CALL( convert_macro(gpx, comment + 1) );
+        }
+        else {
+            gpx->command.comment = normalize_comment(comment);
+            gpx->command.flag |= COMMENT_IS_SET;
+        }
+    }
+    CALL( convert_command(gpx) );
+    gpx->lineNumber++;
+    return SUCCESS;
+}
+
+// a move is charged to the parse phase as the line it stands for would be,
+// so the profile counts it as a line
+
+int gpx_convert_move(Gpx *gpx, const GpxMove *move)
+{
+    int rval;
+    if(gpx->profile == NULL) return convert_move(gpx, move);
+    profile_enter(gpx->profile, PROFILE_PARSE);
+    rval = convert_move(gpx, move);
+    profile_leave(gpx->profile, PROFILE_PARSE);
+    return rval;
+}
+
+int gpx_convert_moves(Gpx *gpx, const GpxMove *moves, size_t count, size_t *converted)
+{
+    int rval = SUCCESS;
+    size_t i;
+    for(i = 0; i < count; i++) {
+        if((rval = gpx_convert_move(gpx, moves + i)) != SUCCESS) break;
+    }
+    if(converted) *converted = i;
+    return rval;
+}
+
+static int convert_line(Gpx *gpx, char *gcode_line)
+{
+    int rval;
     int next_line = 0;
-    int command_emitted = 0;
 
     // reset flag state
     gpx->command.flag = 0;
-    char *digits;
+    double value;
+    int integer;
     char *p = gcode_line; // current parser location
-    while(isspace(*p)) p++;
+    while(IS_SPACE(*p)) p++;
     VERBOSESIO( if(gpx->flag.sioConnected) fprintf(gpx->log, "gcode_line: %s\n", gcode_line); )
     // check for line number
     if(*p == 'n' || *p == 'N') {
-        digits = p;
-        p = normalize_word(p);
+        p = scan_word(p, &value, &integer);
         if(*p == 0) {
             gcodeResult(gpx, "(line %u) Syntax error: line number command word 'N' is missing digits" EOL, gpx->lineNumber);
             next_line = gpx->lineNumber + 1;
         }
         else {
-            next_line = gpx->lineNumber = atoi(digits);
+            next_line = gpx->lineNumber = integer;
         }
     }
     else {
@@ -4431,10 +4957,9 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
     }
     // parse command words in command line
     while(*p != 0) {
-        if(isalpha(*p)) {
+        if(IS_ALPHA(*p)) {
             int c = *p;
-            digits = p;
-            p = normalize_word(p);
+            p = scan_word(p, &value, &integer);
             switch(c) {
 
                     // PARAMETERS
@@ -4442,70 +4967,84 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
                     // Xnnn	 X coordinate, usually to move to
                 case 'x':
                 case 'X':
-                    gpx->command.x = strtod(digits, NULL);
+                    gpx->command.x = value;
                     gpx->command.flag |= X_IS_SET;
                     break;
 
                     // Ynnn	 Y coordinate, usually to move to
                 case 'y':
                 case 'Y':
-                    gpx->command.y = strtod(digits, NULL);
+                    gpx->command.y = value;
                     gpx->command.flag |= Y_IS_SET;
                     break;
 
                     // Znnn	 Z coordinate, usually to move to
                 case 'z':
                 case 'Z':
-                    gpx->command.z = strtod(digits, NULL);
+                    gpx->command.z = value;
                     gpx->command.flag |= Z_IS_SET;
                     break;
 
                     // Annn	 Length of extrudate in mm.
                 case 'a':
                 case 'A':
-                    gpx->command.a = strtod(digits, NULL);
+                    gpx->command.a = value;
                     gpx->command.flag |= A_IS_SET;
                     break;
 
                     // Bnnn	 Length of extrudate in mm.
                 case 'b':
                 case 'B':
-                    gpx->command.b = strtod(digits, NULL);
+                    gpx->command.b = value;
                     gpx->command.flag |= B_IS_SET;
                     break;
 
                     // Ennn	 Length of extrudate in mm.
                 case 'e':
                 case 'E':
-                    gpx->command.e = strtod(digits, NULL);
+                    gpx->command.e = value;
                     gpx->command.flag |= E_IS_SET;
                     break;
 
                     // Fnnn	 Feedrate in mm per minute.
                 case 'f':
                 case 'F':
-                    gpx->command.f = strtod(digits, NULL);
+                    gpx->command.f = value;
                     gpx->command.flag |= F_IS_SET;
                     break;
 
+                    // Innn	 Arc centre X offset
+                case 'i':
+                case 'I':
+                    gpx->command.i = value;
+                    gpx->command.flag |= I_IS_SET;
+                    break;
+
+                    // Jnnn	 Arc centre Y offset
+                case 'j':
+                case 'J':
+                    gpx->command.j = value;
+                    gpx->command.flag |= J_IS_SET;
+                    break;
+
                     // Pnnn	 Command parameter, such as a time in milliseconds
                 case 'p':
                 case 'P':
-                    gpx->command.p = strtod(digits, NULL);
+                    gpx->command.p = value;
                     gpx->command.flag |= P_IS_SET;
                     break;
 
                     // Rnnn	 Command Parameter, such as RPM
                 case 'r':
                 case 'R':
-                    gpx->command.r = strtod(digits, NULL);
+                    gpx->command.r = value;
                     gpx->command.flag |= R_IS_SET;
                     break;
 
                     // Snnn	 Command parameter, such as temperature
                 case 's':
                 case 'S':
-                    gpx->command.s = strtod(digits, NULL);
+                    gpx->command.s = value;
                     gpx->command.flag |= S_IS_SET;
                     break;
 
@@ -4514,13 +5053,13 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
                     // Gnnn GCode command, such as move to a point
                 case 'g':
                 case 'G':
-                    gpx->command.g = atoi(digits);
+                    gpx->command.g = integer;
                     gpx->command.flag |= G_IS_SET;
                     break;
                     // Mnnn	 RepRap-defined command
                 case 'm':
                 case 'M':
-                    gpx->command.m = atoi(digits);
+                    gpx->command.m = integer;
                     gpx->command.flag |= M_IS_SET;
                     if(gpx->command.m == 23 || gpx->command.m == 28) {
                         char *s = p + 1;
@@ -4534,7 +5073,7 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
                     // Tnnn	 Select extruder nnn.
                 case 't':
                 case 'T':
-                    gpx->command.t = atoi(digits);
+                    gpx->command.t = integer;
                     gpx->command.flag |= T_IS_SET;
                     break;
                     // Nnnn      Line number
@@ -4554,13 +5093,8 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
         else if(*p == ';') {
             if(*(p + 1) == '@') {
                 char *s = p + 2;
-                if(isalpha(*s)) {
-                    char *macro = s;
-                    // skip any no space characters
-                    while(*s && !isspace(*s)) s++;
-                    // null terminate
-                    if(*s) *s++ = 0;
-                    CALL( parse_macro(gpx, macro, normalize_comment(s)) );
+                if(IS_ALPHA(*s)) {
+                    CALL( convert_macro(gpx, s) );
                     *p = 0;
                     break;
                 }
@@ -4574,26 +5108,28 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
         else if(*p == '(') {
             if(*(p + 1) == '@') {
                 char *s = p + 2;
-                if(isalpha(*s)) {
-                    char *macro = s;
+                if(IS_ALPHA(*s)) {
                     char *e = strrchr(p + 1, ')');
-                    // skip any no space characters
-                    while(*s && !isspace(*s)) s++;
-                    // null terminate
-                    if(*s) *s++ = 0;
                     if(e) *e = 0;
-                    CALL( parse_macro(gpx, macro, normalize_comment(s)) );
+                    CALL( convert_macro(gpx, s) );
                     *p = 0;
                     break;
                 }
             }
-            // Comment
-            char *s = strchr(p + 1, '(');
-            char *e = strchr(p + 1, ')');
+            // Comment, find the first ')' noting any '(' on the way
+            int nested = 0;
+            char *e = p + 1;
+            while(*(e = scan_stop(e)) && *e != ')') {
+                if(*e == '(') nested = 1;
+                e++;
+            }
+            if(*e == 0) {
+                e = NULL;
+            }
             // check for nested comment
-            if(s && e && s < e) {
+            else if(nested) {
                 gcodeResult(gpx, "(line %u) Syntax warning: nested comment detected" EOL, gpx->lineNumber);
-                e = strrchr(p + 1, ')');
+                e = strrchr(e, ')');
             }
             if(e) {
                 *e = 0;
@@ -4614,7 +5150,7 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
             *p = 0;
             break;
         }
-        else if(iscntrl(*p)) {
+        else if(IS_CNTRL(*p)) {
             break;
         }
         else {
@@ -4623,6 +5159,133 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
         }
     }
 
+    CALL( convert_command(gpx) );
+    gpx->lineNumber = next_line;
+    return SUCCESS;
+}
+
+// RESUME
+
+// the print picks up here.  The machine is told it is where the gcode before
+// left the nozzle, which lifts clear of the print while the heaters come back
+// to temperature and is lowered again once the tool is selected and the fans
+// are as they were.  The extruders are set to 0, the extruder moves after are
+// all relative.
+
+static int resume_build(Gpx *gpx)
+{
+    int rval;
+    unsigned i;
+    Point5d target = gpx->target.position;
+    Point5d current = gpx->current.position;
+    double feedrate = gpx->current.feedrate;
+
+    gpx->flag.fastForward = 0;
+    gpx->accumulated.a = 0.0;
+    gpx->accumulated.b = 0.0;
+    gpx->accumulated.time = 0.0;
+    gpx->current.percent = 0;
+    gpx->layerIndex.start.time = 0.0;
+    planner_stop(&gpx->planner);
+    VERBOSE( fprintf(gpx->log, "(line %u) Resuming at X%0.3f Y%0.3f Z%0.3f" EOL, gpx->lineNumber,
+                     gpx->current.position.x, gpx->current.position.y, gpx->current.position.z) );
+
+    // the gcode before started the build
+    if(gpx->flag.programState == RUNNING_STATE) {
+        if(!gpx->nostart) {
+            CALL( start_build(gpx, gpx->buildName) );
+        }
+        CALL( set_build_progress(gpx, 0) );
+    }
+
+    gpx->axis.positionKnown = gpx->axis.mask;
+    gpx->current.position.a = 0.0;
+    gpx->current.position.b = 0.0;
+    CALL( set_position(gpx) );
+
+    // heat up while lifting
+    if(gpx->machine.a.has_heated_build_platform && gpx->tool[A].build_platform_temperature) {
+        CALL( set_build_platform_temperature(gpx, A, gpx->tool[A].build_platform_temperature) );
+    }
+    else if(gpx->machine.b.has_heated_build_platform && gpx->tool[B].build_platform_temperature) {
+        CALL( set_build_platform_temperature(gpx, B, gpx->tool[B].build_platform_temperature) );
+    }
+    for(i = 0; i < gpx->machine.extruder_count; i++) {
+        if(gpx->tool[i].nozzle_temperature) {
+            CALL( set_nozzle_temperature(gpx, i, gpx->tool[i].nozzle_temperature) );
+        }
+    }
+    gpx->target.position = gpx->current.position;
+    gpx->target.position.z += gpx->resume.hop;
+    if(gpx->machine.z.length > gpx->current.position.z && gpx->target.position.z > gpx->machine.z.length) {
+        gpx->target.position.z = gpx->machine.z.length;
+    }
+    gpx->current.feedrate = gpx->machine.z.max_feedrate;
+    CALL( queue_absolute_point(gpx) );
+
+    if(gpx->machine.a.has_heated_build_platform && gpx->tool[A].build_platform_temperature) {
+        CALL( wait_for_build_platform(gpx, A, MAX_TIMEOUT) );
+    }
+    else if(gpx->machine.b.has_heated_build_platform && gpx->tool[B].build_platform_temperature) {
+        CALL( wait_for_build_platform(gpx, B, MAX_TIMEOUT) );
+    }
+    for(i = 0; i < gpx->machine.extruder_count; i++) {
+        if(gpx->tool[i].nozzle_temperature) {
+            CALL( wait_for_extruder(gpx, i, MAX_TIMEOUT) );
+        }
+    }
+    CALL( change_extruder_offset(gpx, gpx->current.extruder) );
+
+    // the fans and valves as the gcode before left them
+    for(i = 0; i < gpx->machine.extruder_count; i++) {
+        if(gpx->tool[i].fan >= 0) {
+            CALL( set_fan(gpx, i, gpx->tool[i].fan) );
+        }
+        if(gpx->tool[i].valve >= 0) {
+            CALL( set_valve(gpx, i, gpx->tool[i].valve) );
+        }
+    }
+
+    gpx->target.position = gpx->current.position;
+    CALL( queue_absolute_point(gpx) );
+
+    gpx->current.position = current;
+    gpx->target.position = target;
+    gpx->current.feedrate = feedrate;
+    return SUCCESS;
+}
+
+// before the resume point a move only moves the position on, a resume Z is
+// reached by the first move extruding along X or Y at that height or above,
+// so the lifts and purges of the start gcode don't count
+
+static int resumes_at_move(Gpx *gpx, Ptr5d delta)
+{
+    return gpx->resume.z > 0.0 && gpx->target.position.z >= gpx->resume.z
+        && (delta->a > 0.0 || delta->b > 0.0) && (delta->x != 0.0 || delta->y != 0.0);
+}
+
+static int interpret_command(Gpx *gpx);
+static int coalesce_command(Gpx *gpx);
+
+// convert the command set in gpx->command, by the parser or a move
+
+static int convert_command(Gpx *gpx)
+{
+    if(gpx->flag.fastForward) {
+        int rval;
+        if(!gpx->resume.line || gpx->lineNumber < gpx->resume.line) return interpret_command(gpx);
+        CALL( resume_build(gpx) );
+    }
+    if(gpx->coalesce.tolerance > 0.0) return coalesce_command(gpx);
+    return interpret_command(gpx);
+}
+
+static int interpret_command(Gpx *gpx)
+{
+    int i, rval;
+    int command_emitted = 0;
+
     // revert tool selection to current extruder (Makerbot Tn is not sticky)
     if(!gpx->flag.reprapFlavor || gpx->flag.onlyExplicitToolChange) gpx->target.extruder = gpx->current.extruder;
 
@@ -4654,6 +5317,7 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
 
     // INTERPRET COMMAND
 
+    PROFILE_ENTER(PROFILE_TRANSLATE);
     Point5d delta;
     int relative;
 
@@ -4666,12 +5330,19 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
                 if(!gpx->flag.relativeCoordinates && gpx->flag.ignoreAbsoluteMoves)
                     break;
 
-                CALL( calculate_target_position(gpx, &delta, &relative) );
+                PROFILE_CALL(PROFILE_TARGET, calculate_target_position(gpx, &delta, &relative));
+                if(gpx->flag.fastForward) {
+                    if(!resumes_at_move(gpx, &delta)) {
+                        update_current_position(gpx);
+                        break;
+                    }
+                    CALL( resume_build(gpx) );
+                }
                 if(!(gpx->command.flag & F_IS_SET)) {
                     if(gpx->command.flag & X_IS_SET) delta.x = fabs(delta.x);
                     if(gpx->command.flag & Y_IS_SET) delta.y = fabs(delta.y);
                     if(gpx->command.flag & Z_IS_SET) delta.z = fabs(delta.z);
-                    double length = magnitude(gpx->command.flag & XYZ_BIT_MASK, (Ptr5d)&delta);
+                    double length = point5d_magnitude(gpx->command.flag & XYZ_BIT_MASK, (Ptr5d)&delta);
                     double candidate;
                     feedrate = DBL_MAX;
                     if(gpx->command.flag & X_IS_SET && delta.x != 0.0) {
@@ -4693,7 +5364,7 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
                         feedrate = gpx->machine.x.max_feedrate;
                     }
                 }
-                CALL( queue_ext_point(gpx, feedrate, &delta, relative) );
+                PROFILE_CALL(PROFILE_QUEUE, queue_ext_point(gpx, feedrate, &delta, relative));
                 update_current_position(gpx);
                 command_emitted++;
                 break;
@@ -4703,21 +5374,44 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
             case 1:
                 if(!gpx->flag.relativeCoordinates && gpx->flag.ignoreAbsoluteMoves)
                     break;
-                CALL( calculate_target_position(gpx, &delta, &relative) );
-                CALL( queue_ext_point(gpx, 0.0, &delta, relative) );
+                PROFILE_CALL(PROFILE_TARGET, calculate_target_position(gpx, &delta, &relative));
+                if(gpx->flag.fastForward) {
+                    if(!resumes_at_move(gpx, &delta)) {
+                        update_current_position(gpx);
+                        break;
+                    }
+                    CALL( resume_build(gpx) );
+                }
+                PROFILE_CALL(PROFILE_QUEUE, queue_ext_point(gpx, 0.0, &delta, relative));
                 update_current_position(gpx);
                 command_emitted++;
                 break;
 
                 // G2 - Clockwise Arc
                 // G3 - Counter Clockwise Arc
+            case 2:
+            case 3:
+                if(!gpx->flag.relativeCoordinates && gpx->flag.ignoreAbsoluteMoves)
+                    break;
+                if(gpx->flag.fastForward) {
+                    // only the end of the arc matters, the arc targets it again
+                    PROFILE_CALL(PROFILE_TARGET, calculate_target_position(gpx, &delta, &relative));
+                    if(!resumes_at_move(gpx, &delta)) {
+                        update_current_position(gpx);
+                        break;
+                    }
+                    CALL( resume_build(gpx) );
+                }
+                CALL( convert_arc(gpx, gpx->command.g == 2) );
+                command_emitted++;
+                break;
 
                 // G4 - Dwell
             case 4:
                 if(gpx->command.flag & P_IS_SET) {
 #if ENABLE_SIMULATED_RPM
                     if(gpx->tool[gpx->current.extruder].motor_enabled && gpx->tool[gpx->current.extruder].rpm) {
-                        CALL( calculate_target_position(gpx, &delta, &relative) );
+                        PROFILE_CALL(PROFILE_TARGET, calculate_target_position(gpx, &delta, &relative));
                         CALL( queue_new_point(gpx, gpx->command.p) );
                         command_emitted++;
                     }
@@ -5180,12 +5874,18 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
                     if(percent > 100) percent = 100;
                     if(program_is_ready() && percent < 100) {
                         start_program();
+                        if(gpx->progressMarks) {
+                            CALL( add_progress_mark(gpx, PROGRESS_BUILD, percent, 0) );
+                        }
                         if(!gpx->nostart) {
 			     CALL( start_build(gpx, gpx->buildName) );
 			}
                         CALL( set_build_progress(gpx, percent) );
                         // start extruder in a known state
                         CALL( change_extruder_offset(gpx, gpx->current.extruder) );
+                        if(gpx->progressMarks) {
+                            CALL( add_progress_mark(gpx, PROGRESS_BUILT, 0, 0) );
+                        }
                     }
                     else if(program_is_running()) {
                         if(percent == 100) {
@@ -5207,7 +5907,10 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
                                 }
                                 gpx->flag.macrosEnabled = 1;
                             }
-                            if(gpx->current.percent < percent && (percent == 1 || gpx->total.time == 0.0 || gpx->flag.buildProgress == 0)) {
+                            if(gpx->progressMarks) {
+                                CALL( add_progress_mark(gpx, PROGRESS_M73, percent, percent == 1 || gpx->flag.buildProgress == 0) );
+                            }
+                            else if(gpx->current.percent < percent && (percent == 1 || gpx->total.time == 0.0 || gpx->flag.buildProgress == 0)) {
                                 CALL( set_build_progress(gpx, percent) );
                             }
                         }
@@ -5708,12 +6411,18 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
             case 136:
                 if(program_is_ready()) {
                     start_program();
+                    if(gpx->progressMarks) {
+                        CALL( add_progress_mark(gpx, PROGRESS_BUILD, 0, 0) );
+                    }
 		    if(!gpx->nostart) {
 			 CALL( start_build(gpx, gpx->buildName) );
 		    }
                     CALL( set_build_progress(gpx, 0) );
                     // start extruder in a known state
                     CALL( change_extruder_offset(gpx, gpx->current.extruder) );
+                    if(gpx->progressMarks) {
+                        CALL( add_progress_mark(gpx, PROGRESS_BUILT, 0, 0) );
+                    }
                 }
                 break;
 
@@ -5730,8 +6439,10 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
 
                 // M220 - Set speed factor override percentage
             case 220:
-                if((gpx->command.flag & S_IS_SET) && gpx->command.s > 0)
+                if((gpx->command.flag & S_IS_SET) && gpx->command.s > 0) {
                     gpx->current.speed_factor = (unsigned)gpx->command.s;
+                    update_motion(gpx);
+                }
                 break;
 
                 // M221 - Set extrude factor override percentage
@@ -5741,6 +6452,7 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
                     if(gpx->command.flag & T_IS_SET)
                         tool_id = gpx->target.extruder;
                     gpx->override[tool_id].extrusion_factor = (unsigned)gpx->command.s;
+                    update_motion(gpx);
                 }
                 break;
 
@@ -5822,10 +6534,18 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
     // X,Y,Z,A,B,E,F
     else if(gpx->command.flag & (AXES_BIT_MASK | F_IS_SET)) {
         if(!(gpx->command.flag & COMMENT_IS_SET) && (gpx->flag.relativeCoordinates || !gpx->flag.ignoreAbsoluteMoves)) {
-            CALL( calculate_target_position(gpx, &delta, &relative) );
-            CALL( queue_ext_point(gpx, 0.0, &delta, relative) );
-            update_current_position(gpx);
-            command_emitted++;
+            PROFILE_CALL(PROFILE_TARGET, calculate_target_position(gpx, &delta, &relative));
+            if(gpx->flag.fastForward && !resumes_at_move(gpx, &delta)) {
+                update_current_position(gpx);
+            }
+            else {
+                if(gpx->flag.fastForward) {
+                    CALL( resume_build(gpx) );
+                }
+                PROFILE_CALL(PROFILE_QUEUE, queue_ext_point(gpx, 0.0, &delta, relative));
+                update_current_position(gpx);
+                command_emitted++;
+            }
         }
     }
     // Tn
@@ -5843,7 +6563,19 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
         }
     }
     // update progress
-    if(gpx->total.time > 0.0001 && gpx->accumulated.time > 0.0001 && gpx->flag.buildProgress && command_emitted) {
+    if(gpx->progressMarks) {
+        // the total time isn't known until the end of a single pass, so mark
+        // the spot.  Until the build starts each mark might be where it does
+        if(gpx->accumulated.time > 0.0001 && gpx->flag.buildProgress && command_emitted) {
+            if(program_is_ready()) {
+                CALL( add_progress_mark(gpx, PROGRESS_START, 0, 0) );
+            }
+            else if(program_is_running()) {
+                CALL( add_progress_mark(gpx, PROGRESS_TIME, 0, 0) );
+            }
+        }
+    }
+    else if(gpx->total.time > 0.0001 && gpx->accumulated.time > 0.0001 && gpx->flag.buildProgress && command_emitted) {
         unsigned percent = (unsigned)round(100.0 * gpx->accumulated.time / gpx->total.time);
         if(percent > gpx->current.percent) {
             if(program_is_ready()) {
@@ -5867,171 +6599,2012 @@ int gpx_convert_line(Gpx *gpx, char *gcode_line)
             command_emitted = 0;
         }
     }
-    gpx->lineNumber = next_line;
     return SUCCESS;
 }
 
-typedef struct tFile {
-    FILE *in;
-    FILE *out;
-    FILE *out2;
-} File;
+// MOVE COALESCING
 
-static int file_handler(Gpx *gpx, File *file, char *buffer, size_t length)
-{
-    if(length) {
-        ssize_t bytes = fwrite(buffer, 1, length, file->out);
-        if(bytes != length) return ERROR;
-        if(file->out2) {
-            bytes = fwrite(buffer, 1, length, file->out2);
-            if(bytes != length) return ERROR;
-        }
-    }
-    return SUCCESS;
-}
+// Curved outlines are sliced into many short G1 moves and each one becomes an
+// x3g command of its own.  With a chord tolerance set, a run of nearly
+// collinear moves at the same feedrate is held back and converted as the one
+// move to the end of the run.  No point of the run may be further than the
+// tolerance from the line from its start to its end, and the extrusion at each
+// point must be within what the tolerance would extrude of the extrusion in
+// proportion to the distance along that line.
 
-int gpx_convert(Gpx *gpx, FILE *file_in, FILE *file_out, FILE *file_out2)
+// an absolute G1 in X and Y, perhaps with E and F, can join a run
+
+static int can_coalesce(Gpx *gpx)
 {
-    int i, rval;
-    File file;
-    file.in = stdin;
-    file.out = stdout;
-    file.out2 = NULL;
-    int logMessages = gpx->flag.logMessages;
+    int flag = gpx->command.flag;
+    return (flag & G_IS_SET) && gpx->command.g == 1
+        && (flag & (X_IS_SET | Y_IS_SET)) == (X_IS_SET | Y_IS_SET)
+        && !(flag & (Z_IS_SET | A_IS_SET | B_IS_SET | P_IS_SET | R_IS_SET | S_IS_SET | M_IS_SET | T_IS_SET))
+        && (gpx->axis.positionKnown & (X_IS_SET | Y_IS_SET)) == (X_IS_SET | Y_IS_SET)
+        && !gpx->flag.relativeCoordinates
+        && !gpx->flag.ignoreAbsoluteMoves
+        && !gpx->flag.doPauseAtZPos
+        && gpx->tio == NULL;
+}
 
-    if(file_in && file_in != stdin) {
-        // Multi-pass
-        file.in = file_in;
-        i = 0;
-        gpx->flag.runMacros = 0;
-        gpx->callbackHandler = NULL;
-        gpx->callbackData = NULL;
-    }
-    else {
-        // Single-pass
-        i = 1;
-        gpx->callbackHandler = (int (*)(Gpx*, void*, char*, size_t))file_handler;;
-        gpx->callbackData = &file;
-    }
+// would the run still be within the tolerance if it ended at x, y, e
 
-    if(file_out) {
-        file.out = file_out;
+static int coalesce_fits(Coalesce *c, double x, double y, double e)
+{
+    double dx = x - c->point[0].x;
+    double dy = y - c->point[0].y;
+    double de = e - c->point[0].e;
+    double length2 = dx * dx + dy * dy;
+    double last = 0.0;
+    unsigned i;
+    if(length2 == 0.0) return 0;
+    double length = sqrt(length2);
+    // the extrusion error is measured in the distance that would extrude it
+    double eTolerance = c->tolerance * fabs(de) / length;
+    for(i = 1; i <= c->count; i++) {
+        double px = c->point[i].x - c->point[0].x;
+        double py = c->point[i].y - c->point[0].y;
+        double t = (px * dx + py * dy) / length2;
+        // the points must run in order along the line
+        if(t < last || t > 1.0) return 0;
+        if(fabs(px * dy - py * dx) / length > c->tolerance) return 0;
+        if(c->extruding && fabs(c->point[i].e - c->point[0].e - t * de) > eTolerance) return 0;
+        last = t;
     }
+    return 1;
+}
 
-    file.out2 = file_out2;
+// convert the run held back as the one move to its end
 
-    for(;;) {
-        int overflow = 0;
+static int coalesce_flush(Gpx *gpx)
+{
+    Coalesce *c = &gpx->coalesce;
+    int rval = SUCCESS;
+    if(c->count) {
+        Command command = gpx->command;
+        gpx->command = c->pending;
+        c->point[0] = c->point[c->count];
+        c->count = 0;
+        rval = interpret_command(gpx);
+        gpx->command = command;
+    }
+    return rval;
+}
 
-	if(gpx->preamble)
-	     start_build(gpx, gpx->preamble);
+static int coalesce_command(Gpx *gpx)
+{
+    Coalesce *c = &gpx->coalesce;
+    int rval;
 
-        while(fgets(gpx->buffer.in, BUFFER_MAX, file.in) != NULL) {
-            // detect input buffer overflow and ignore overflow input
-            if(overflow) {
-                if(strlen(gpx->buffer.in) != BUFFER_MAX - 1) {
-                    overflow = 0;
-                }
-                continue;
-            }
-            if(strlen(gpx->buffer.in) == BUFFER_MAX - 1) {
-                overflow = 1;
-                // ignore run-on comments, this is actually a little too permissive
-                // since technically we should ignore ';' contained within a
-                // parenthetical comment
-                if(!strchr(gpx->buffer.in, ';'))
-                    gcodeResult(gpx, "(line %u) Buffer overflow: input exceeds %u character limit, remaining characters in line will be ignored" EOL, gpx->lineNumber, BUFFER_MAX);
+    // comments and blank lines don't end a run
+    if(!(gpx->command.flag & ~COMMENT_IS_SET)) return interpret_command(gpx);
+
+    if(!can_coalesce(gpx)) {
+        CALL( coalesce_flush(gpx) );
+        c->anchored = 0;
+        return interpret_command(gpx);
+    }
+
+    int extruding = !!(gpx->command.flag & E_IS_SET);
+    int relativeE = gpx->flag.extruderIsRelative;
+    double x = gpx->command.x;
+    double y = gpx->command.y;
+    // relative extrusion is summed from the start of the run
+    double e = c->point[c->count].e;
+    if(extruding) e = relativeE ? e + gpx->command.e : gpx->command.e;
+
+    // the comment was only good for the line it came from
+    gpx->command.flag &= ~COMMENT_IS_SET;
+    gpx->command.comment = NULL;
+
+    if(c->count) {
+        Command *pending = &c->pending;
+        if(extruding == c->extruding
+           && c->count < COALESCE_WINDOW
+           && (!(gpx->command.flag & F_IS_SET) || (pending->flag & F_IS_SET && pending->f == gpx->command.f))
+           && coalesce_fits(c, x, y, e)) {
+            Command command = gpx->command;
+            if(pending->flag & F_IS_SET) {
+                command.flag |= F_IS_SET;
+                command.f = pending->f;
             }
+            if(extruding && relativeE) command.e += pending->e;
+            *pending = command;
+            c->count++;
+            c->point[c->count].x = x;
+            c->point[c->count].y = y;
+            c->point[c->count].e = e;
+            c->eliminated++;
+            return SUCCESS;
+        }
+        CALL( coalesce_flush(gpx) );
+    }
+
+    // start a run from the end of the last move
+    if(c->anchored && !gpx->flag.doPauseAtZPos && (!extruding || c->anchorHasE)) {
+        c->pending = gpx->command;
+        c->extruding = extruding;
+        c->count = 1;
+        c->point[1].x = x;
+        c->point[1].y = y;
+        c->point[1].e = e;
+        return SUCCESS;
+    }
 
-            rval = gpx_convert_line(gpx, gpx->buffer.in);
-            // normal exit
-            if(rval == END_OF_FILE) break;
-            // error
-            if(rval < 0) return rval;
-        }
-
-        if(program_is_running()) {
-            end_program();
-	    if(!gpx->noend) {
-		 CALL( set_build_progress(gpx, 100) );
-		 CALL( end_build(gpx) );
-	    }
-        }
-
-        // Ending gcode should disable the heaters and stepper motors
-	// This line of code here in GPX was making it such that people
-	// could not convert gcode utility scripts to x3g with GPX.  For
-	// instance, a script for build plate leveling which wanted to
-	// home the axes and then leave Z enabled
-
-        // CALL( set_steppers(gpx, AXES_BIT_MASK, 0) );
-
-        gpx->total.length = gpx->accumulated.a + gpx->accumulated.b;
-        gpx->total.time = gpx->accumulated.time;
-        gpx->total.bytes = gpx->accumulated.bytes;
-
-        if(++i > 1) break;
+    CALL( interpret_command(gpx) );
+    c->anchored = 1;
+    c->anchorHasE = extruding || relativeE;
+    c->point[0].x = x;
+    c->point[0].y = y;
+    c->point[0].e = extruding && !relativeE ? gpx->command.e : 0.0;
+    return SUCCESS;
+}
 
-        // rewind for second pass
-        fseek(file.in, 0L, SEEK_SET);
-        gpx_initialize(gpx, 0);
-        gpx->flag.loadMacros = 0;
-        gpx->flag.runMacros = 1;
-        gpx->flag.pausePending = (gpx->commandAtLength > 0);
-        //gpx->flag.logMessages = 0;
-        gpx->callbackHandler = (int (*)(Gpx*, void*, char*, size_t))file_handler;
-        gpx->callbackData = &file;
+// X3G OUTPUT
+
+// Encoded commands are collected in one large buffer and written out in big
+// blocks, the same buffer going to every sink.  A write that doesn't fit in
+// what's left of the buffer goes out with it in a single writev.  With the
+// pipeline, once the x3g has outgrown the buffer the rest is handed to a
+// writer thread a block at a time, so a slow disk doesn't hold up the
+// conversion.
+
+#define OUTPUT_BUFFER_SIZE 65536
+
+typedef struct tOutput {
+    FILE *sink[3];
+    int sinks;
+    int required;   // sinks a failed write is an error for, the rest are dropped
+    int dropped;
+    Blake2b *tee;   // hash of what's written to the sink teed off
+    char *buffer;
+    size_t length;
+    int pipeline;
+#ifdef HAVE_PIPELINE
+    int writing;
+    WriteBehind behind;
+#endif
+#ifdef HAVE_ZLIB
+    z_stream *deflate;  // gzips what's written to the required sinks, or NULL
+    char *deflated;
+#endif
+} Output;
+
+static int output_open(Output *output, FILE *out, FILE *out2, int pipeline)
+{
+    output->sinks = 0;
+    output->sink[output->sinks++] = out;
+    if(out2) output->sink[output->sinks++] = out2;
+    output->required = output->sinks;
+    output->dropped = 0;
+    output->tee = NULL;
+    output->length = 0;
+    output->pipeline = pipeline;
+#ifdef HAVE_PIPELINE
+    output->writing = 0;
+#endif
+#ifdef HAVE_ZLIB
+    output->deflate = NULL;
+    output->deflated = NULL;
+#endif
+    output->buffer = malloc(OUTPUT_BUFFER_SIZE);
+    if(output->buffer == NULL) return ERROR;
+#ifdef USE_WRITEV
+    // anything already written through stdio has to go first
+    int i;
+    for(i = 0; i < output->sinks; i++) {
+        if(fflush(output->sink[i]) != 0) return ERROR;
     }
-    gpx->flag.logMessages = logMessages;;
+#endif
     return SUCCESS;
 }
 
-char *sd_status[] = {
-    "operation successful",
-    "SD Card not present",
-    "SD Card initialization failed",
-    "partition table could not be read",
-    "filesystem could not be opened",
-    "root directory could not be opened",
-    "SD Card is locked",
-    "file not found",
-    "general error",
-    "changed working dir",
-    "volume too big",
-    "CRC failure",
-    "SD Card read error",
-    "SD operating at low speeds",
-    "unknown status"
-};
+#ifdef HAVE_ZLIB
+// gzip what's written to the sinks at level, the sinks teed off after are
+// still written the x3g as it is
 
-char *get_sd_status(unsigned int status)
+static int output_compress(Output *output, int level)
 {
-    return sd_status[status < 14 ? status : 14];
+    output->deflate = calloc(1, sizeof(z_stream));
+    output->deflated = malloc(OUTPUT_BUFFER_SIZE);
+    if(output->deflate == NULL || output->deflated == NULL) return ERROR;
+    // 16 writes a gzip header and trailer
+    if(deflateInit2(output->deflate, level, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        free(output->deflate);
+        output->deflate = NULL;
+        return ERROR;
+    }
+    return SUCCESS;
 }
+#endif
 
-char *build_status[] = {
-    "no build initialized (boot state)",
-    "build running",
-    "build finished normally",
-    "build paused",
-    "build cancelled",
-    "build sleeping",
-    "unknown status"
-};
+// also write to out hashing what's written into hash, but carry on without
+// it if a write to it fails
 
-char *get_build_status(unsigned int status)
+static void output_tee(Output *output, FILE *out, Blake2b *hash)
 {
-    return build_status[status < 6 ? status : 6];
+#ifdef USE_WRITEV
+    if(fflush(out) != 0) return;
+#endif
+    output->sink[output->sinks++] = out;
+    output->tee = hash;
 }
 
-static void read_extruder_query_response(Gpx *gpx, Sio *sio, unsigned command, char *buffer)
-{
-    unsigned extruder_id = buffer[EXTRUDER_ID_OFFSET];
+// write buffer followed by data to sink
 
-    switch(command) {
-            // Query 00 - Query firmware version information
-        case 0:
-            // uint16: Firmware Version
+static int sink_write(FILE *sink, char *buffer, size_t buffered, char *data, size_t length)
+{
+#ifdef USE_WRITEV
+    struct iovec iov[2];
+    struct iovec *v = iov;
+    int count = 0;
+    int fd = fileno(sink);
+    if(buffered) {
+        iov[count].iov_base = buffer;
+        iov[count++].iov_len = buffered;
+    }
+    if(length) {
+        iov[count].iov_base = data;
+        iov[count++].iov_len = length;
+    }
+    while(count) {
+        ssize_t bytes = writev(fd, v, count);
+        if(bytes < 0) {
+            if(errno == EINTR) continue;
+            return ERROR;
+        }
+        // carry on after a partial write
+        while(count && (size_t)bytes >= v->iov_len) {
+            bytes -= v->iov_len;
+            v++;
+            count--;
+        }
+        if(count) {
+            v->iov_base = (char *)v->iov_base + bytes;
+            v->iov_len -= bytes;
+        }
+    }
+#else
+    if(buffered && fwrite(buffer, 1, buffered, sink) != buffered) return ERROR;
+    if(length && fwrite(data, 1, length, sink) != length) return ERROR;
+#endif
+    return SUCCESS;
+}
+
+#ifdef HAVE_ZLIB
+// deflate data into the required sinks, flush is Z_FINISH to end the stream
+
+static int output_deflate(Output *output, char *data, size_t length, int flush)
+{
+    z_stream *z = output->deflate;
+    int i, rc;
+    z->next_in = (Bytef *)data;
+    z->avail_in = (uInt)length;
+    do {
+        size_t n;
+        z->next_out = (Bytef *)output->deflated;
+        z->avail_out = OUTPUT_BUFFER_SIZE;
+        rc = deflate(z, flush);
+        if(rc == Z_STREAM_ERROR) return ERROR;
+        n = OUTPUT_BUFFER_SIZE - z->avail_out;
+        for(i = 0; n && i < output->required; i++) {
+            if(sink_write(output->sink[i], output->deflated, n, NULL, 0) != SUCCESS) return ERROR;
+        }
+    } while(z->avail_out == 0 || (flush == Z_FINISH && rc != Z_STREAM_END));
+    return SUCCESS;
+}
+#endif
+
+// write buffer followed by data to every sink
+
+static int output_sinks(Output *output, char *buffer, size_t buffered, char *data, size_t length)
+{
+    int i = 0;
+#ifdef HAVE_ZLIB
+    if(output->deflate) {
+        if(output_deflate(output, buffer, buffered, Z_NO_FLUSH) != SUCCESS
+           || output_deflate(output, data, length, Z_NO_FLUSH) != SUCCESS) return ERROR;
+        i = output->required;
+    }
+#endif
+    for(; i < output->sinks; i++) {
+        if(sink_write(output->sink[i], buffer, buffered, data, length) != SUCCESS) {
+            if(i < output->required) return ERROR;
+            output->sinks = i;
+            output->dropped = 1;
+        }
+    }
+    if(output->tee && output->sinks > output->required) {
+        blake2b_update(output->tee, buffer, buffered);
+        blake2b_update(output->tee, data, length);
+    }
+    return SUCCESS;
+}
+
+// write the buffer followed by data to every sink and empty the buffer
+
+static int output_write(Output *output, char *data, size_t length)
+{
+    int rval;
+    CALL( output_sinks(output, output->buffer, output->length, data, length) );
+    output->length = 0;
+    return SUCCESS;
+}
+
+#ifdef HAVE_PIPELINE
+// the writer thread's write
+
+static int output_block(void *ctx, char *data, size_t length)
+{
+    return output_sinks((Output *)ctx, data, length, NULL, 0) == SUCCESS ? 0 : -1;
+}
+#endif
+
+static int output_handler(Gpx *gpx, Output *output, char *buffer, size_t length)
+{
+#ifdef HAVE_PIPELINE
+    if(output->writing) {
+        return write_behind_append(&output->behind, buffer, length) ? ERROR : SUCCESS;
+    }
+#endif
+    if(length > OUTPUT_BUFFER_SIZE - output->length) {
+#ifdef HAVE_PIPELINE
+        if(output->pipeline && write_behind_start(&output->behind, output_block, output) == 0) {
+            output->writing = 1;
+            if(write_behind_append(&output->behind, output->buffer, output->length)) return ERROR;
+            output->length = 0;
+            return output_handler(gpx, output, buffer, length);
+        }
+#endif
+        return output_write(output, buffer, length);
+    }
+    memcpy(output->buffer + output->length, buffer, length);
+    output->length += length;
+    return SUCCESS;
+}
+
+static int output_flush(Output *output)
+{
+#ifdef HAVE_PIPELINE
+    if(output->writing) {
+        return write_behind_sync(&output->behind) ? ERROR : SUCCESS;
+    }
+#endif
+    if(output->length == 0) return SUCCESS;
+    return output_write(output, NULL, 0);
+}
+
+// flush the output and end a gzip stream
+
+static int output_finish(Output *output)
+{
+    int rval;
+    CALL( output_flush(output) );
+#ifdef HAVE_ZLIB
+    if(output->deflate) return output_deflate(output, NULL, 0, Z_FINISH);
+#endif
+    return SUCCESS;
+}
+
+static void output_close(Output *output)
+{
+    if(output->buffer == NULL) return;
+#ifdef HAVE_PIPELINE
+    if(output->writing) write_behind_stop(&output->behind);
+    output->writing = 0;
+#endif
+    free(output->buffer);
+    output->buffer = NULL;
+#ifdef HAVE_ZLIB
+    if(output->deflate) {
+        deflateEnd(output->deflate);
+        free(output->deflate);
+        output->deflate = NULL;
+    }
+    free(output->deflated);
+    output->deflated = NULL;
+#endif
+}
+
+// GCODE INPUT
+
+// Regular files are memory mapped and each line is taken straight from the
+// map, anything else (pipes, terminals) is read with fgets.  With the
+// pipeline, input that isn't mapped other than a terminal is read ahead on a
+// thread a block at a time.  Gzip compressed input is never mapped, it's
+// inflated as it's read, on the thread reading ahead when there is one.
+// Either way the line ends up in gpx->buffer.in where the parser is free to
+// modify it.
+
+#ifdef HAVE_ZLIB
+#define INFLATE_BUFFER_SIZE 65536
+
+typedef struct tInflate {
+    z_stream z;
+    FILE *in;
+    unsigned char *deflated;    // read from in
+    char *inflated;     // split into lines when not reading ahead
+    size_t length;
+    size_t pos;
+    int member;         // part way through a gzip member
+    int ended;
+} Inflate;
+#endif
+
+typedef struct tInput {
+    FILE *in;
+    FILE *copy;     // copy of the lines read from input that can't be rewound
+    FILE *tmp;      // temporary file holding the copy
+    long start;     // where the conversion started or -1 if it can't be rewound
+    char *map;      // memory mapped input or NULL
+    size_t size;
+    size_t pos;
+    int pipeline;
+#ifdef HAVE_PIPELINE
+    int reading;    // lines come from ahead
+    ReadAhead ahead;
+#endif
+#ifdef HAVE_ZLIB
+    Inflate *inflate;   // of compressed input or NULL
+#endif
+} Input;
+
+#ifdef HAVE_ZLIB
+static Inflate *inflate_open(FILE *in)
+{
+    Inflate *inf = calloc(1, sizeof(Inflate));
+    if(inf == NULL) return NULL;
+    inf->in = in;
+    inf->deflated = malloc(INFLATE_BUFFER_SIZE);
+    inf->inflated = malloc(INFLATE_BUFFER_SIZE);
+    // 32 takes a gzip or zlib header
+    if(inf->deflated && inf->inflated && inflateInit2(&inf->z, MAX_WBITS + 32) == Z_OK) return inf;
+    free(inf->deflated);
+    free(inf->inflated);
+    free(inf);
+    return NULL;
+}
+
+// start again from the first member, in has been positioned there
+
+static void inflate_restart(Inflate *inf)
+{
+    inflateReset(&inf->z);
+    inf->z.avail_in = 0;
+    inf->length = inf->pos = 0;
+    inf->member = inf->ended = 0;
+}
+
+// the ReadProc of compressed input, a file of several gzip members, as cat
+// makes, is read through to the end of the last
+
+static long inflate_read(void *ctx, char *data, size_t length)
+{
+    Inflate *inf = ctx;
+    z_stream *z = &inf->z;
+    z->next_out = (Bytef *)data;
+    z->avail_out = (uInt)length;
+    while(z->avail_out && !inf->ended) {
+        int rc;
+        if(z->avail_in == 0) {
+            size_t n = fread(inf->deflated, 1, INFLATE_BUFFER_SIZE, inf->in);
+            if(n == 0) {
+                // a member cut short is an error
+                if(ferror(inf->in) || inf->member) return -1;
+                inf->ended = 1;
+                break;
+            }
+            z->next_in = inf->deflated;
+            z->avail_in = (uInt)n;
+        }
+        inf->member = 1;
+        rc = inflate(z, Z_NO_FLUSH);
+        if(rc == Z_STREAM_END) {
+            inflateReset(z);
+            inf->member = 0;
+        }
+        else if(rc != Z_OK && rc != Z_BUF_ERROR) {
+            return -1;
+        }
+    }
+    return (long)(length - z->avail_out);
+}
+
+// the next line into buffer, split as fgets would, returns the length, 0 at
+// the end of the input and -1 on an error
+
+static long inflate_line(Inflate *inf, char *buffer, size_t size)
+{
+    size_t n = 0;
+    while(n + 1 < size) {
+        char *line, *eol;
+        size_t length;
+        if(inf->pos == inf->length) {
+            long got = inflate_read(inf, inf->inflated, INFLATE_BUFFER_SIZE);
+            if(got < 0) return -1;
+            if(got == 0) break;
+            inf->length = (size_t)got;
+            inf->pos = 0;
+        }
+        line = inf->inflated + inf->pos;
+        length = inf->length - inf->pos;
+        if(length > size - 1 - n) length = size - 1 - n;
+        eol = memchr(line, '\n', length);
+        if(eol) length = eol - line + 1;
+        memcpy(buffer + n, line, length);
+        n += length;
+        inf->pos += length;
+        if(eol) break;
+    }
+    buffer[n] = 0;
+    return (long)n;
+}
+
+// pass by length bytes of inflated input
+
+static int inflate_skip(Inflate *inf, unsigned long length)
+{
+    while(length) {
+        long got = inflate_read(inf, inf->inflated, length < INFLATE_BUFFER_SIZE ? length : INFLATE_BUFFER_SIZE);
+        if(got <= 0) return ERROR;
+        length -= (unsigned long)got;
+    }
+    return SUCCESS;
+}
+
+static void inflate_close(Inflate *inf)
+{
+    inflateEnd(&inf->z);
+    free(inf->deflated);
+    free(inf->inflated);
+    free(inf);
+}
+#endif
+
+// the ReadProc of input read as it is
+
+static long file_read(void *ctx, char *data, size_t length)
+{
+    FILE *in = ctx;
+    size_t n = fread(data, 1, length, in);
+    return n < length && ferror(in) ? -1 : (long)n;
+}
+
+// read up to length bytes of gcode, inflated if it's compressed
+
+static long input_bytes(Input *input, char *data, size_t length)
+{
+#ifdef HAVE_ZLIB
+    if(input->inflate) return inflate_read(input->inflate, data, length);
+#endif
+    return file_read(input->in, data, length);
+}
+
+// does the input start with the gzip magic number?  Only the first byte of
+// input that can't be rewound can be looked at, which no gcode starts with
+
+static int input_compressed(Input *input)
+{
+    unsigned char magic[2];
+    if(input->start >= 0) {
+        size_t n = fread(magic, 1, 2, input->in);
+        if(fseek(input->in, input->start, SEEK_SET) != 0) return 0;
+        return n == 2 && magic[0] == 0x1f && magic[1] == 0x8b;
+    }
+    else {
+        int c = getc(input->in);
+        if(c == EOF) return 0;
+        ungetc(c, input->in);
+        return c == 0x1f;
+    }
+}
+
+static void input_map(Input *input)
+{
+#ifdef HAVE_MMAP
+    struct stat st;
+    int fd = fileno(input->in);
+    if(fd >= 0 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode)
+       && st.st_size > input->start && (off_t)(size_t)st.st_size == st.st_size) {
+        void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+            input->map = map;
+            input->size = (size_t)st.st_size;
+            input->pos = (size_t)input->start;
+        }
+    }
+#endif
+}
+
+// a terminal is left to fgets, the conversion can end before the input does
+
+static void input_read_ahead(Input *input)
+{
+#ifdef HAVE_PIPELINE
+    int fd = fileno(input->in);
+    ReadProc read = file_read;
+    void *ctx = input->in;
+#ifdef HAVE_ZLIB
+    if(input->inflate) {
+        read = inflate_read;
+        ctx = input->inflate;
+    }
+#endif
+    if(input->pipeline && input->map == NULL && fd >= 0 && !isatty(fd)
+       && read_ahead_start(&input->ahead, read, ctx) == 0) {
+        input->reading = 1;
+    }
+#endif
+}
+
+// ERROR if the input is compressed and can't be inflated
+
+static int input_open(Input *input, FILE *in, int pipeline)
+{
+    int compressed;
+    input->in = in;
+    input->copy = input->tmp = NULL;
+    input->map = NULL;
+    input->size = input->pos = 0;
+    input->pipeline = pipeline;
+#ifdef HAVE_PIPELINE
+    input->reading = 0;
+#endif
+#ifdef HAVE_ZLIB
+    input->inflate = NULL;
+#endif
+    input->start = ftell(in);
+    if(input->start < 0 || fseek(in, input->start, SEEK_SET) != 0) {
+        input->start = -1;
+        input->copy = input->tmp = tmpfile();
+    }
+    compressed = input_compressed(input);
+    if(compressed) {
+#ifdef HAVE_ZLIB
+        if((input->inflate = inflate_open(in)) == NULL) return ERROR;
+#else
+        return ERROR;
+#endif
+    }
+    else if(input->start >= 0) {
+        input_map(input);
+    }
+    input_read_ahead(input);
+    return SUCCESS;
+}
+
+// stop reading ahead, leaving the file positioned after what was read, as
+// fgets would have
+
+static void input_stop(Input *input)
+{
+#ifdef HAVE_PIPELINE
+    if(input->reading) {
+        read_ahead_stop(&input->ahead);
+        input->reading = 0;
+        if(input->start < 0) return;
+#ifdef HAVE_ZLIB
+        // compressed input is inflated again up to there
+        if(input->inflate) {
+            if(fseek(input->in, input->start, SEEK_SET) == 0) {
+                inflate_restart(input->inflate);
+                inflate_skip(input->inflate, input->ahead.consumed);
+            }
+            return;
+        }
+#endif
+        fseek(input->in, input->start + (long)input->ahead.consumed, SEEK_SET);
+    }
+#endif
+}
+
+// can the input be read again by input_rewind?
+
+static int input_can_rewind(Input *input)
+{
+    return input->start >= 0 || input->copy != NULL;
+}
+
+// read the next line into gpx->buffer.in, a line longer than BUFFER_MAX - 1
+// is split just like fgets would
+
+static int input_read(Gpx *gpx, Input *input, size_t *length)
+{
+    if(input->map) {
+        char *line = input->map + input->pos;
+        char *eol;
+        size_t n = input->size - input->pos;
+        if(n == 0) return END_OF_FILE;
+        if(n > BUFFER_MAX - 1) n = BUFFER_MAX - 1;
+        eol = memchr(line, '\n', n);
+        if(eol) n = eol - line + 1;
+        memcpy(gpx->buffer.in, line, n);
+        gpx->buffer.in[n] = 0;
+        input->pos += n;
+        *length = n;
+        return SUCCESS;
+    }
+#ifdef HAVE_PIPELINE
+    if(input->reading) {
+        long n = read_ahead_line(&input->ahead, gpx->buffer.in, BUFFER_MAX);
+        if(n <= 0) return n < 0 ? ERROR : END_OF_FILE;
+        *length = (size_t)n;
+    }
+    else
+#endif
+#ifdef HAVE_ZLIB
+    if(input->inflate) {
+        long n = inflate_line(input->inflate, gpx->buffer.in, BUFFER_MAX);
+        if(n <= 0) return n < 0 ? ERROR : END_OF_FILE;
+        *length = (size_t)n;
+    }
+    else
+#endif
+    {
+        if(fgets(gpx->buffer.in, BUFFER_MAX, input->in) == NULL) return END_OF_FILE;
+        *length = strlen(gpx->buffer.in);
+    }
+    if(input->copy && fwrite(gpx->buffer.in, 1, *length, input->copy) != *length) return ERROR;
+    return SUCCESS;
+}
+
+// go back to where the conversion started for a second pass
+
+static int input_rewind(Input *input)
+{
+    input_stop(input);
+    if(input->map) {
+        input->pos = (size_t)input->start;
+    }
+    else if(input->copy) {
+        if(fflush(input->copy) != 0) return ERROR;
+        rewind(input->copy);
+        input->in = input->copy;
+        input->copy = NULL;
+        input->start = 0;
+#ifdef HAVE_ZLIB
+        // the copy is of the inflated lines
+        if(input->inflate) {
+            inflate_close(input->inflate);
+            input->inflate = NULL;
+        }
+#endif
+        input_map(input);
+    }
+    else if(fseek(input->in, input->start, SEEK_SET) != 0) {
+        return ERROR;
+    }
+#ifdef HAVE_ZLIB
+    else if(input->inflate) {
+        inflate_restart(input->inflate);
+    }
+#endif
+    input_read_ahead(input);
+    return SUCCESS;
+}
+
+static void input_close(Input *input)
+{
+    input_stop(input);
+#ifdef HAVE_MMAP
+    // leave the file positioned after what was read, as fgets would have
+    if(input->map) {
+        fseek(input->in, (long)input->pos, SEEK_SET);
+        munmap(input->map, input->size);
+    }
+#endif
+#ifdef HAVE_ZLIB
+    if(input->inflate) inflate_close(input->inflate);
+#endif
+    if(input->tmp) fclose(input->tmp);
+}
+
+// convert the lines of input up to its end or M2, line_done is called after
+// each whole line converted when given and can end the conversion early by
+// returning END_OF_FILE
+
+static int convert_lines(Gpx *gpx, Input *input, int (*line_done)(Gpx*, Input*, void*), void *data)
+{
+    int rval;
+    int overflow = 0;
+    size_t length;
+
+    while(1) {
+        PROFILE_ENTER(PROFILE_INPUT);
+        rval = input_read(gpx, input, &length);
+        PROFILE_LEAVE(PROFILE_INPUT);
+        if(rval != SUCCESS) {
+            // a read error or compressed input that's damaged or cut short
+            if(rval == ERROR) gcodeResult(gpx, "(line %u) Error reading input" EOL, gpx->lineNumber);
+            break;
+        }
+        // detect input buffer overflow and ignore overflow input
+        if(overflow) {
+            if(length != BUFFER_MAX - 1) {
+                overflow = 0;
+            }
+            continue;
+        }
+        if(length == BUFFER_MAX - 1) {
+            overflow = 1;
+            // ignore run-on comments, this is actually a little too permissive
+            // since technically we should ignore ';' contained within a
+            // parenthetical comment
+            if(!strchr(gpx->buffer.in, ';'))
+                gcodeResult(gpx, "(line %u) Buffer overflow: input exceeds %u character limit, remaining characters in line will be ignored" EOL, gpx->lineNumber, BUFFER_MAX);
+        }
+
+        rval = gpx_convert_line(gpx, gpx->buffer.in);
+        // normal exit
+        if(rval == END_OF_FILE) break;
+        // error
+        if(rval < 0) return rval;
+        if(line_done && !overflow) {
+            rval = line_done(gpx, input, data);
+            if(rval == END_OF_FILE) break;
+            if(rval != SUCCESS) return rval;
+        }
+    }
+    return rval < 0 ? rval : SUCCESS;
+}
+
+// finish the build if the gcode didn't and work out the totals
+
+static int finish_pass(Gpx *gpx)
+{
+    int rval;
+    CALL( coalesce_flush(gpx) );
+
+    if(program_is_running()) {
+        end_program();
+        if(!gpx->noend) {
+            CALL( set_build_progress(gpx, 100) );
+            CALL( end_build(gpx) );
+        }
+    }
+
+    // Ending gcode should disable the heaters and stepper motors
+    // This line of code here in GPX was making it such that people
+    // could not convert gcode utility scripts to x3g with GPX.  For
+    // instance, a script for build plate leveling which wanted to
+    // home the axes and then leave Z enabled
+
+    // CALL( set_steppers(gpx, AXES_BIT_MASK, 0) );
+
+    gpx->total.length = gpx->accumulated.a + gpx->accumulated.b;
+    gpx->total.time = gpx->accumulated.time;
+    gpx->total.bytes = gpx->accumulated.bytes;
+    gpx->total.commands = gpx->accumulated.commands;
+    return SUCCESS;
+}
+
+// convert the gcode from input, finishing the build if the gcode doesn't
+
+static int convert_pass(Gpx *gpx, Input *input)
+{
+    int rval;
+
+    if(gpx->preamble)
+        start_build(gpx, gpx->preamble);
+
+    CALL( convert_lines(gpx, input, NULL, NULL) );
+    return finish_pass(gpx);
+}
+
+// PARALLEL CONVERSION
+
+// A huge file is converted by a prescan on the calling thread and chunks of
+// it on a pool of workers.  The prescan only tracks the state, the positions,
+// tool, temperatures, flags, pause table and build time, without encoding any
+// x3g, and at the first layer change past each chunk's share of the gcode it
+// takes a copy of its state for the next chunk to start from.  A chunk
+// converts its lines of the mapped gcode from that copy into a spool of its
+// own, counting its x3g and keeping its progress marks and layers from its
+// start.  Every chunk must end in the state the next one started from, if one
+// doesn't the build is converted again in a sequential second pass.
+// Otherwise the spools are joined in order, and the marks and layers moved on
+// by the x3g of the chunks before.
+
+#if defined(HAVE_PIPELINE) && defined(HAVE_MMAP)
+#define HAVE_PARALLEL 1
+#define PARALLEL_CHUNK_MIN (256 * 1024)     // bytes of gcode
+#define PARALLEL_CHUNKS 4                   // per thread, so the work evens out
+
+// the offset of a layer that started before its chunk, where the chunk
+// before left it
+#define LAYER_INHERITED ULONG_MAX
+
+// what has to carry over from the end of one chunk to the start of the next
+
+typedef struct tChunkState {
+    double time;
+    double a;
+    double b;
+    Point2d excess;
+    Point5d position;
+    unsigned lineNumber;
+} ChunkState;
+
+typedef struct tChunk {
+    Gpx *gpx;               // the state the chunk starts from, converted in place
+    char *map;
+    size_t start;
+    size_t end;
+    int first;              // runs the preamble
+    int last;               // finishes the build
+    FILE *spool;            // the chunk's x3g
+    unsigned long offset;   // in the spool of the next x3g written
+    char *buffer;
+    size_t length;
+    int rval;
+    unsigned long commands; // x3g commands in the spool
+    vector *marks;          // the progress marks and layers, their offsets
+    vector *layers;         // are from the start of the chunk
+    Layer layerStart;       // of the moves at the latest Z when it ended
+    ChunkState begin;
+    ChunkState state;       // where it ended
+} Chunk;
+
+typedef struct tSplit {
+    Workers workers;
+    vector *chunks;         // of Chunk *
+    Chunk *current;         // started, waiting for its end
+    size_t size;            // of the gcode of a chunk
+    size_t next;            // a chunk ends at the first layer change past next
+    double z;
+    int failed;             // out of memory, fall back to a second pass
+} Split;
+
+static void chunk_state(Gpx *gpx, ChunkState *state)
+{
+    memset(state, 0, sizeof(ChunkState));
+    state->time = gpx->accumulated.time;
+    state->a = gpx->accumulated.a;
+    state->b = gpx->accumulated.b;
+    state->excess = gpx->excess;
+    state->position = gpx->current.position;
+    state->lineNumber = gpx->lineNumber;
+}
+
+static int spool_write(int fd, const char *data, size_t length, unsigned long offset)
+{
+    while(length) {
+        ssize_t bytes = pwrite(fd, data, length, (off_t)offset);
+        if(bytes < 0) {
+            if(errno == EINTR) continue;
+            return ERROR;
+        }
+        data += bytes;
+        length -= bytes;
+        offset += bytes;
+    }
+    return SUCCESS;
+}
+
+static int chunk_flush(Chunk *chunk)
+{
+    int rval;
+    CALL( spool_write(fileno(chunk->spool), chunk->buffer, chunk->length, chunk->offset) );
+    chunk->offset += chunk->length;
+    chunk->length = 0;
+    return SUCCESS;
+}
+
+static int chunk_handler(Gpx *gpx, Chunk *chunk, char *buffer, size_t length)
+{
+    int rval;
+    if(length > OUTPUT_BUFFER_SIZE - chunk->length) {
+        CALL( chunk_flush(chunk) );
+    }
+    memcpy(chunk->buffer + chunk->length, buffer, length);
+    chunk->length += length;
+    return SUCCESS;
+}
+
+// copy the chunk's x3g into the spool at offset
+
+static int chunk_join(Chunk *chunk, int fd, unsigned long offset, char *buffer)
+{
+    int rval;
+    int from = fileno(chunk->spool);
+    unsigned long copied = 0;
+    while(copied < chunk->offset) {
+        size_t length = chunk->offset - copied;
+        ssize_t bytes;
+        if(length > OUTPUT_BUFFER_SIZE) length = OUTPUT_BUFFER_SIZE;
+        bytes = pread(from, buffer, length, (off_t)copied);
+        if(bytes <= 0) {
+            if(bytes < 0 && errno == EINTR) continue;
+            return ERROR;
+        }
+        CALL( spool_write(fd, buffer, bytes, offset + copied) );
+        copied += bytes;
+    }
+    return SUCCESS;
+}
+
+static void chunk_free(Chunk *chunk)
+{
+    gpx_destroy(chunk->gpx);
+    if(chunk->marks) vector_free(chunk->marks);
+    if(chunk->layers) vector_free(chunk->layers);
+    if(chunk->spool) fclose(chunk->spool);
+    free(chunk->buffer);
+    free(chunk);
+}
+
+// a worker converting a chunk
+
+static void chunk_convert(void *item)
+{
+    Chunk *chunk = item;
+    Gpx *gpx = chunk->gpx;
+    Input input;
+    int rval = ERROR;
+
+    memset(&input, 0, sizeof(Input));
+    input.map = chunk->map;
+    input.pos = chunk->start;
+    input.size = chunk->end;
+    chunk->buffer = malloc(OUTPUT_BUFFER_SIZE);
+    if(chunk->buffer) {
+        if(chunk->first && gpx->preamble)
+            start_build(gpx, gpx->preamble);
+        rval = convert_lines(gpx, &input, NULL, NULL);
+        if(rval == SUCCESS && chunk->last) rval = finish_pass(gpx);
+        if(rval == SUCCESS) rval = chunk_flush(chunk);
+    }
+    chunk->rval = rval;
+    chunk_state(gpx, &chunk->state);
+    chunk->commands = gpx->accumulated.commands;
+    chunk->marks = gpx->progressMarks;
+    chunk->layers = gpx->layerIndex.layers;
+    chunk->layerStart = gpx->layerIndex.start;
+    gpx->progressMarks = NULL;
+    gpx->layerIndex.layers = NULL;
+    chunk->gpx = NULL;
+    gpx_destroy(gpx);
+    free(chunk->buffer);
+    chunk->buffer = NULL;
+}
+
+// end the current chunk where the prescan is and start the next from a copy
+// of its state
+
+static void split_chunk(Gpx *gpx, Input *input, Split *split)
+{
+    Chunk *chunk = split->current;
+    Gpx *clone;
+    if(chunk) {
+        chunk->end = input->pos;
+        split->current = NULL;
+        if(workers_add(&split->workers, chunk)) {
+            split->failed = 1;
+            return;
+        }
+    }
+    chunk = calloc(1, sizeof(Chunk));
+    if(chunk == NULL || vector_append(split->chunks, &chunk) < 0) {
+        free(chunk);
+        split->failed = 1;
+        return;
+    }
+    if((clone = gpx_clone(gpx)) == NULL
+       || (clone->progressMarks = vector_create(sizeof(ProgressMark), 256, 4096)) == NULL
+       || (chunk->spool = tmpfile()) == NULL) {
+        gpx_destroy(clone);
+        split->failed = 1;
+        return;
+    }
+    // verbose mode changes the x3g, so only its messages are silenced
+    clone->flag.logMessages = 0;
+    clone->flag.prescan = 0;
+    // the x3g is counted from the start of the chunk
+    clone->accumulated.bytes = 0;
+    clone->accumulated.commands = 0;
+    clone->layerIndex.start.offset = LAYER_INHERITED;
+    clone->callbackHandler = (int (*)(Gpx*, void*, char*, size_t))chunk_handler;
+    clone->callbackData = chunk;
+    chunk->gpx = clone;
+    chunk->map = input->map;
+    chunk->start = input->pos;
+    chunk->first = split->chunks->c == 1;
+    chunk_state(gpx, &chunk->begin);
+    split->current = chunk;
+    split->next = input->pos + split->size;
+}
+
+// the prescan's line_done, a chunk that runs on without a layer change ends
+// anyway once it's twice its size
+
+static int split_line(Gpx *gpx, Input *input, void *data)
+{
+    Split *split = data;
+    double z = gpx->current.position.z;
+    int layer = z != split->z;
+    split->z = z;
+    if(split->failed || gpx->flag.needSecondPass || input->pos < split->next) return SUCCESS;
+    if(layer || input->pos >= split->next + split->size) split_chunk(gpx, input, split);
+    return SUCCESS;
+}
+
+// join the chunks into the spool in order, along with their progress marks
+// and layers
+
+static int join_chunks(Gpx *gpx, vector *chunks, FILE *spool)
+{
+    int i, j;
+    unsigned long offset = 0;
+    unsigned long commands = 0;
+    unsigned long layerStart = 0;
+    vector *layers = gpx->layerIndex.layers;
+    char *buffer = malloc(OUTPUT_BUFFER_SIZE);
+
+    if(buffer == NULL) return ERROR;
+    // the prescan's layers are where the chunks start
+    if(layers) layers->c = 0;
+    for(i = 0; i < chunks->c; i++) {
+        Chunk *chunk = *(Chunk **)vector_get(chunks, i);
+        if(chunk_join(chunk, fileno(spool), offset, buffer) != SUCCESS) {
+            free(buffer);
+            return ERROR;
+        }
+        for(j = 0; j < chunk->marks->c; j++) {
+            ProgressMark pm = *(ProgressMark *)vector_get(chunk->marks, j);
+            pm.offset += offset;
+            pm.commands += commands;
+            if(vector_append(gpx->progressMarks, &pm) < 0) {
+                free(buffer);
+                return ERROR;
+            }
+        }
+        for(j = 0; layers && j < chunk->layers->c; j++) {
+            Layer layer = *(Layer *)vector_get(chunk->layers, j);
+            layer.offset = layer.offset == LAYER_INHERITED ? layerStart : layer.offset + offset;
+            if(vector_append(layers, &layer) < 0) {
+                free(buffer);
+                return ERROR;
+            }
+        }
+        if(chunk->layerStart.offset != LAYER_INHERITED) layerStart = chunk->layerStart.offset + offset;
+        offset += chunk->offset;
+        commands += chunk->commands;
+    }
+    free(buffer);
+    gpx->accumulated.bytes = gpx->total.bytes = offset;
+    gpx->accumulated.commands = gpx->total.commands = commands;
+    return SUCCESS;
+}
+
+// the single pass of convert_file spread across threads, the x3g goes to
+// spool as the sequential pass would have written it
+
+static int convert_parallel(Gpx *gpx, Input *input, FILE *spool)
+{
+    int (*handler)(Gpx*, void*, char*, size_t) = gpx->callbackHandler;
+    int rval, i, diverged = 0;
+    Split split;
+    ChunkState end;
+
+    memset(&split, 0, sizeof(Split));
+    split.size = (input->size - input->pos) / (gpx->parallel * PARALLEL_CHUNKS);
+    if(split.size < PARALLEL_CHUNK_MIN) split.size = PARALLEL_CHUNK_MIN;
+    split.z = gpx->current.position.z;
+    split.chunks = vector_create(sizeof(Chunk *), 64, 64);
+    if(split.chunks == NULL || workers_start(&split.workers, gpx->parallel, chunk_convert) < 0) {
+        if(split.chunks) vector_free(split.chunks);
+        return convert_pass(gpx, input);
+    }
+
+    gpx->callbackHandler = NULL;
+    gpx->flag.prescan = 1;
+    split_chunk(gpx, input, &split);
+    if(gpx->preamble)
+        start_build(gpx, gpx->preamble);
+    rval = convert_lines(gpx, input, split_line, &split);
+    if(rval == SUCCESS) rval = finish_pass(gpx);
+    gpx->flag.prescan = 0;
+    chunk_state(gpx, &end);
+    // the last chunk runs to the end of the gcode or M2
+    if(split.current) {
+        split.current->end = input->size;
+        split.current->last = 1;
+        if(rval != SUCCESS || split.failed || workers_add(&split.workers, split.current)) {
+            split.failed = 1;
+        }
+    }
+    workers_finish(&split.workers);
+    gpx->callbackHandler = handler;
+
+    for(i = 0; i < split.chunks->c; i++) {
+        Chunk *chunk = *(Chunk **)vector_get(split.chunks, i);
+        if(rval == SUCCESS && !split.failed && !diverged) {
+            ChunkState *next = i + 1 < split.chunks->c ? &(*(Chunk **)vector_get(split.chunks, i + 1))->begin : &end;
+            if(chunk->rval != SUCCESS) {
+                rval = chunk->rval;
+            }
+            else if(memcmp(&chunk->state, next, sizeof(ChunkState)) != 0) {
+                VERBOSE( fprintf(gpx->log, "Parallel conversion diverged at line %u, converting again" EOL, next->lineNumber) );
+                diverged = 1;
+            }
+        }
+    }
+    if(rval == SUCCESS && !split.failed && !diverged) {
+        rval = join_chunks(gpx, split.chunks, spool);
+    }
+    for(i = 0; i < split.chunks->c; i++) {
+        chunk_free(*(Chunk **)vector_get(split.chunks, i));
+    }
+    VERBOSE( fprintf(gpx->log, "Parallel conversion in %d chunks on %d threads" EOL, split.chunks->c, split.workers.threads) );
+    vector_free(split.chunks);
+    if(rval == SUCCESS && (split.failed || diverged)) gpx->flag.needSecondPass = 1;
+    return rval;
+}
+#endif
+
+// copy the spooled x3g to the callback, writing the build progress at each
+// mark now that the total time is known.  Without a spool only the build
+// progress is written, to count its bytes.  The layer index moves with the
+// x3g the progress is written into or skipped from.
+
+static int write_progress(Gpx *gpx, vector *marks, FILE *spool)
+{
+    int i, rval;
+    char buffer[4096];
+    unsigned long offset = 0;
+    unsigned long spooled = gpx->accumulated.bytes;
+    int started = 0;
+    int layer = 0;
+    vector *layers = gpx->layerIndex.layers;
+
+    if(spool) rewind(spool);
+    for(i = 0; i <= marks->c; i++) {
+        ProgressMark *pm = i < marks->c ? vector_get(marks, i) : NULL;
+        while(layers && layer < layers->c) {
+            Layer *l = vector_get(layers, layer);
+            if(pm && l->offset >= pm->offset) break;
+            l->offset += gpx->accumulated.bytes - spooled;
+            layer++;
+        }
+        while(spool && (pm == NULL || offset < pm->offset)) {
+            size_t length = sizeof(buffer);
+            if(pm && pm->offset - offset < length) length = pm->offset - offset;
+            length = fread(buffer, 1, length, spool);
+            if(length == 0) break;
+            PROFILE_CALL(PROFILE_OUTPUT, gpx->callbackHandler(gpx, gpx->callbackData, buffer, length));
+            offset += length;
+        }
+        if(pm == NULL) break;
+        switch(pm->type) {
+            case PROGRESS_SET:
+                gpx->current.percent = pm->percent;
+                break;
+            case PROGRESS_M73:
+                if(gpx->current.percent < pm->percent && (pm->force || gpx->total.time == 0.0)) {
+                    CALL( set_build_progress(gpx, pm->percent) );
+                }
+                break;
+            case PROGRESS_BUILD:
+                // the time based progress already started the build, in which
+                // case the M73 P0 or M136 didn't
+                if(started) {
+                    ProgressMark *build = pm;
+                    while(i + 1 < marks->c && ((ProgressMark *)vector_get(marks, i + 1))->type != PROGRESS_BUILT) i++;
+                    if(++i < marks->c) {
+                        pm = vector_get(marks, i);
+                        // the commands skipped aren't part of the output
+                        gpx->accumulated.bytes -= pm->offset - build->offset;
+                        gpx->accumulated.commands -= pm->commands - build->commands;
+                        if(spool && fseek(spool, pm->offset, SEEK_SET) != 0) return ERROR;
+                        offset = pm->offset;
+                    }
+                }
+                started = 1;
+                break;
+            case PROGRESS_BUILT:
+                break;
+            case PROGRESS_START:
+                if(!started) {
+                    if(gpx->total.time > 0.0001 && round(100.0 * pm->time / gpx->total.time) > gpx->current.percent) {
+                        if(!gpx->nostart) {
+                            CALL( start_build(gpx, gpx->buildName) );
+                        }
+                        CALL( set_build_progress(gpx, 0) );
+                        // start extruder in a known state
+                        CALL( change_extruder_offset(gpx, pm->extruder) );
+                        started = 1;
+                    }
+                    break;
+                }
+                // fall through
+            case PROGRESS_TIME:
+                if(gpx->total.time > 0.0001) {
+                    unsigned percent = (unsigned)round(100.0 * pm->time / gpx->total.time);
+                    if(percent > gpx->current.percent && percent < 100) {
+                        // force 1%
+                        CALL( set_build_progress(gpx, gpx->current.percent ? percent : 1) );
+                    }
+                }
+                break;
+        }
+    }
+    if(spool && ferror(spool)) return ERROR;
+    gpx->total.bytes = gpx->accumulated.bytes;
+    gpx->total.commands = gpx->accumulated.commands;
+    return SUCCESS;
+}
+
+// CONVERSION CACHE
+
+// hash the gcode from where the conversion starts in chunks, input that
+// isn't mapped is read to the end and has to be rewound to be converted
+
+static int input_hash(Input *input, Chunker *chunker)
+{
+    char buffer[8192];
+    long n = 0;
+    if(input->map) {
+        chunker_update(chunker, input->map + input->start, input->size - input->start);
+    }
+    else {
+        input_stop(input);
+        while((n = input_bytes(input, buffer, sizeof(buffer))) > 0) {
+            chunker_update(chunker, buffer, (size_t)n);
+        }
+    }
+    chunker_final(chunker);
+    return n < 0 ? ERROR : SUCCESS;
+}
+
+// look up the conversion of input with the state gpx is in, see cache_open
+
+static int cache_lookup(Gpx *gpx, Input *input, CacheEntry *entry, int create)
+{
+    unsigned char key[HASH_SIZE];
+    unsigned char base[HASH_SIZE];
+    Blake2b b2, config;
+    Chunker chunker;
+    int rval;
+    blake2b_init(&b2);
+    cache_hash_config(&b2, gpx);
+    config = b2;
+    blake2b_final(&config, base);
+    chunker_init(&chunker, &b2);
+    if(input_hash(input, &chunker) != SUCCESS) {
+        free(chunker.end);
+        return ERROR;
+    }
+    blake2b_final(&b2, key);
+    rval = cache_open(gpx, key, entry, create);
+    memcpy(entry->base, base, HASH_SIZE);
+    entry->chunk = chunker.end;
+    entry->chunks = chunker.count;
+    return rval;
+}
+
+static int copy_cached(Gpx *gpx, Output *output, FILE *fp)
+{
+    int rval = SUCCESS;
+    char *buffer = malloc(OUTPUT_BUFFER_SIZE);
+    size_t length;
+    if(buffer == NULL) return ERROR;
+    while(rval == SUCCESS && (length = fread(buffer, 1, OUTPUT_BUFFER_SIZE, fp)) > 0) {
+        rval = output_handler(gpx, output, buffer, length);
+    }
+    free(buffer);
+    if(ferror(fp)) return ERROR;
+    return rval;
+}
+
+// INCREMENTAL CONVERSION
+
+// The single pass of a conversion through the cache can take checkpoints as
+// it goes and keep them with its x3g in a sidecar, see cache.h.  When the
+// sidecar of an earlier conversion with the same settings is found, a span
+// of gcode that is the same as one of its spans and is reached in the same
+// state isn't converted again: its x3g and progress marks are copied and the
+// conversion carries on from the state it ended in.  A change to the end
+// gcode only converts the last span, a change to the start gcode or a macro
+// converts up to the first span that is reached in the same state as
+// before, which never happens if the change altered the build time or the
+// filament used.
+
+typedef struct tSpanLine {
+    uint64_t line;
+    unsigned index;
+} SpanLine;
+
+typedef struct tIncremental {
+    Checkpoints *now;       // being taken
+    Checkpoints *then;      // of the earlier conversion, or NULL
+    SpanLine *order;        // then's checkpoints by the hash of their line
+    unsigned lines;
+    const ChunkEnd *chunk;  // of the gcode
+    unsigned chunks;
+    unsigned next;          // the next chunk to end
+    char *buffer;           // for copying x3g
+    Blake2b x3g;            // of the span being converted
+    int (*handler)(Gpx*, void*, char*, size_t);     // of the spooled x3g
+    void *data;
+    unsigned copied;        // spans
+    int finished;           // the last span copied was the earlier conversion's last
+    int failed;             // out of memory, the checkpoints can't be kept
+} Incremental;
+
+static int compare_span_lines(const void *a, const void *b)
+{
+    const SpanLine *x = a, *y = b;
+    if(x->line != y->line) return x->line < y->line ? -1 : 1;
+    return x->index < y->index ? -1 : x->index > y->index;
+}
+
+// hash the gcode from from to to, by the hashes of its chunks when it is
+// whole chunks
+
+static void hash_gcode(Incremental *inc, Input *input, unsigned long from, unsigned long to, unsigned char digest[HASH_SIZE])
+{
+    unsigned lo = 0, hi = inc->chunks;
+    Blake2b b2;
+    blake2b_init(&b2);
+    // the first chunk ending after from
+    while(lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+        if(inc->chunk[mid].input <= from) lo = mid + 1;
+        else hi = mid;
+    }
+    if(from == 0 || (lo && inc->chunk[lo - 1].input == from)) {
+        for(; lo < inc->chunks && inc->chunk[lo].input <= to; lo++) {
+            blake2b_update(&b2, inc->chunk[lo].gcode, HASH_SIZE);
+            if(inc->chunk[lo].input == to) {
+                blake2b_final(&b2, digest);
+                return;
+            }
+        }
+        blake2b_init(&b2);
+    }
+    blake2b_update(&b2, input->map + input->start + from, to - from);
+    blake2b_final(&b2, digest);
+}
+
+// can span k of the earlier conversion be copied from here?  The state has
+// already been found the same.
+
+static int span_matches(Gpx *gpx, Input *input, Incremental *inc, unsigned k)
+{
+    Checkpoints *then = inc->then;
+    Checkpoint *from, *to;
+    unsigned char digest[HASH_SIZE];
+    unsigned long pos = (unsigned long)(input->pos - input->start);
+    size_t left = input->size - input->pos;
+    unsigned first = (unsigned)gpx->commandAtIndex;
+    if(k + 1 >= then->count) return 0;
+    from = then->checkpoint + k;
+    to = from + 1;
+    if(!from->reusable || to->commandAtIndex < from->commandAtIndex
+       || to->bytes < from->bytes || to->marks < from->marks
+       || to->input < from->input || to->input - from->input != from->length) return 0;
+    // the input after the last span has to run out where it did before
+    if(left < from->length || (k + 2 == then->count && !to->ended && left != from->length)) return 0;
+    // the commands still to come are this conversion's own, the span has to
+    // reach the same ones
+    checkpoint_hash_pauses(gpx, first, first + (to->commandAtIndex - from->commandAtIndex), from->pending, digest);
+    if(memcmp(digest, from->pauses, HASH_SIZE) != 0) return 0;
+    // a command the span didn't get to before it mustn't get to now
+    if(!from->pending && first < (unsigned)gpx->commandAtLength
+       && gpx->commandAt[first].z <= from->reached) return 0;
+    hash_gcode(inc, input, pos, pos + from->length, digest);
+    return memcmp(digest, from->gcode, HASH_SIZE) == 0;
+}
+
+// take a checkpoint of where the conversion is, the span before it is
+// copied from span or worked out.  Returns NULL if out of memory.
+
+static Checkpoint *add_checkpoint(Gpx *gpx, Input *input, Incremental *inc, uint64_t line, const Checkpoint *span)
+{
+    Checkpoints *now = inc->now;
+    Checkpoint *cp;
+    unsigned char settings[HASH_SIZE];
+    unsigned long pos = (unsigned long)(input->pos - input->start);
+    unsigned long state = (unsigned long)now->state.length;
+    Blake2b b2;
+
+    blake2b_init(&b2);
+    cache_hash_settings(&b2, gpx);
+    blake2b_final(&b2, settings);
+    if(now->count) {
+        cp = now->checkpoint + now->count - 1;
+        if(span) {
+            cp->length = span->length;
+            memcpy(cp->gcode, span->gcode, HASH_SIZE);
+            memcpy(cp->pauses, span->pauses, HASH_SIZE);
+            memcpy(cp->x3g, span->x3g, HASH_SIZE);
+            cp->reached = span->reached;
+            cp->pending = span->pending;
+            cp->reusable = span->reusable;
+        }
+        else {
+            cp->length = pos - cp->input;
+            hash_gcode(inc, input, cp->input, pos, cp->gcode);
+            cp->reached = gpx->commandAtReached;
+            cp->pending = cp->pending || cp->commandAtIndex < (unsigned)gpx->commandAtIndex;
+            checkpoint_hash_pauses(gpx, cp->commandAtIndex, gpx->commandAtIndex, cp->pending, cp->pauses);
+            blake2b_final(&inc->x3g, cp->x3g);
+            // a macro in the span changed what isn't in the snapshot
+            cp->reusable = memcmp(cp->settings, settings, HASH_SIZE) == 0
+                && cp->commandAtLength == (unsigned)gpx->commandAtLength;
+        }
+    }
+    blake2b_init(&inc->x3g);
+    checkpoint_snapshot(&now->state, gpx);
+    if(now->state.failed || (cp = checkpoint_add(now)) == NULL) {
+        inc->failed = 1;
+        return NULL;
+    }
+    cp->input = pos;
+    cp->line = line;
+    cp->bytes = gpx->accumulated.bytes;
+    cp->commands = gpx->accumulated.commands;
+    cp->lineNumber = gpx->lineNumber;
+    cp->eliminated = gpx->coalesce.eliminated;
+    cp->marks = (unsigned)gpx->progressMarks->c;
+    cp->state = state;
+    cp->size = (unsigned long)now->state.length - state;
+    memcpy(cp->settings, settings, HASH_SIZE);
+    cp->commandAtIndex = (unsigned)gpx->commandAtIndex;
+    cp->commandAtLength = (unsigned)gpx->commandAtLength;
+    cp->pending = gpx->flag.doPauseAtZPos != 0;
+    gpx->commandAtReached = -DBL_MAX;
+    return cp;
+}
+
+// copy span k of the earlier conversion and carry on from the state it
+// ended in, END_OF_FILE once that was the end of the conversion
+
+static int copy_span(Gpx *gpx, Input *input, Incremental *inc, unsigned k)
+{
+    Checkpoints *then = inc->then;
+    Checkpoint *from = then->checkpoint + k;
+    Checkpoint *to = from + 1;
+    Checkpoint *cp = inc->now->checkpoint + inc->now->count - 1;
+    unsigned long bytes = cp->bytes;
+    unsigned long commands = cp->commands;
+    unsigned long left = to->bytes - from->bytes;
+    unsigned i;
+    int rval;
+
+    if(fseek(then->file, (long)from->bytes, SEEK_SET) != 0) return ERROR;
+    while(left) {
+        size_t length = left < OUTPUT_BUFFER_SIZE ? left : OUTPUT_BUFFER_SIZE;
+        if(fread(inc->buffer, 1, length, then->file) != length) return ERROR;
+        PROFILE_CALL(PROFILE_OUTPUT, inc->handler(gpx, inc->data, inc->buffer, length));
+        left -= length;
+    }
+    CALL( checkpoint_restore(gpx, then->state.data + to->state, to->size) );
+    gpx->commandAtIndex += to->commandAtIndex - from->commandAtIndex;
+    gpx->accumulated.bytes = bytes + (to->bytes - from->bytes);
+    gpx->accumulated.commands = commands + (to->commands - from->commands);
+    gpx->lineNumber += to->lineNumber - from->lineNumber;
+    gpx->coalesce.eliminated += to->eliminated - from->eliminated;
+    for(i = from->marks; i < to->marks; i++) {
+        ProgressMark pm = then->mark[i];
+        pm.offset = pm.offset - from->bytes + bytes;
+        pm.commands = pm.commands - from->commands + commands;
+        if(vector_append(gpx->progressMarks, &pm) < 0) return ERROR;
+    }
+    input->pos += from->length;
+    if((cp = add_checkpoint(gpx, input, inc, to->line, from)) != NULL) {
+        cp->ended = to->ended;
+    }
+    inc->copied++;
+    if(k + 2 == then->count) {
+        inc->finished = 1;
+        return END_OF_FILE;
+    }
+    return SUCCESS;
+}
+
+// copy every span of the earlier conversion that can be from the checkpoint
+// just taken
+
+static int copy_spans(Gpx *gpx, Input *input, Incremental *inc)
+{
+    Checkpoints *then = inc->then;
+    Checkpoints *now = inc->now;
+    Checkpoint *cp = now->checkpoint + now->count - 1;
+    const unsigned char *state = now->state.data + cp->state;
+    unsigned first = 0, last = 1, k = 0;
+    int rval;
+
+    // the first checkpoint is only ever the first, any other by its line
+    if(now->count > 1) {
+        unsigned lo = 0, hi = inc->lines;
+        while(lo < hi) {
+            unsigned mid = (lo + hi) / 2;
+            if(inc->order[mid].line < cp->line) lo = mid + 1;
+            else hi = mid;
+        }
+        for(hi = lo; hi < inc->lines && inc->order[hi].line == cp->line; hi++);
+        first = lo;
+        last = hi;
+    }
+    for(; first < last; first++) {
+        Checkpoint *old;
+        k = now->count > 1 ? inc->order[first].index : 0;
+        old = then->checkpoint + k;
+        if(old->size == cp->size
+           && memcmp(then->state.data + old->state, state, cp->size) == 0
+           && memcmp(old->settings, cp->settings, HASH_SIZE) == 0
+           && span_matches(gpx, input, inc, k)) break;
+    }
+    if(first == last) return SUCCESS;
+    do {
+        CALL( copy_span(gpx, input, inc, k) );
+        if(inc->failed) break;
+    } while(span_matches(gpx, input, inc, ++k));
+    return SUCCESS;
+}
+
+// the x3g converted is hashed on its way to the spool, what's copied already
+// has been
+
+static int incremental_handler(Gpx *gpx, Incremental *inc, char *buffer, size_t length)
+{
+    blake2b_update(&inc->x3g, buffer, length);
+    return inc->handler(gpx, inc->data, buffer, length);
+}
+
+// convert_lines' line_done, a checkpoint is taken where a chunk of the gcode
+// ends, other than the last
+
+static int checkpoint_line(Gpx *gpx, Input *input, void *data)
+{
+    Incremental *inc = data;
+    unsigned long pos = (unsigned long)(input->pos - input->start);
+    const ChunkEnd *end;
+    // a chunk ending within a line too long for the buffer is passed by
+    while(inc->next < inc->chunks && inc->chunk[inc->next].input < pos) inc->next++;
+    if(inc->failed || inc->next + 1 >= inc->chunks || inc->chunk[inc->next].input != pos) return SUCCESS;
+    end = inc->chunk + inc->next++;
+    if(add_checkpoint(gpx, input, inc, end->line, NULL) == NULL) return SUCCESS;
+    return inc->then ? copy_spans(gpx, input, inc) : SUCCESS;
+}
+
+// the single pass of convert_file taking checkpoints into now and copying
+// what it can from then
+
+static int convert_incremental(Gpx *gpx, Input *input, const CacheEntry *entry, Checkpoints *now, Checkpoints *then)
+{
+    int rval = SUCCESS;
+    unsigned i;
+    Incremental inc;
+
+    memset(&inc, 0, sizeof(Incremental));
+    inc.now = now;
+    inc.chunk = entry->chunk;
+    inc.chunks = entry->chunks;
+    inc.handler = gpx->callbackHandler;
+    inc.data = gpx->callbackData;
+    if(then && then->count > 1 && (inc.buffer = malloc(OUTPUT_BUFFER_SIZE)) != NULL) {
+        inc.order = malloc(then->count * sizeof(SpanLine));
+        if(inc.order) {
+            inc.then = then;
+            // not the first or the last, they don't end a chunk
+            for(i = 1; i + 1 < then->count; i++) {
+                inc.order[inc.lines].line = then->checkpoint[i].line;
+                inc.order[inc.lines++].index = i;
+            }
+            qsort(inc.order, inc.lines, sizeof(SpanLine), compare_span_lines);
+        }
+    }
+    gpx->callbackHandler = (int (*)(Gpx*, void*, char*, size_t))incremental_handler;
+    gpx->callbackData = &inc;
+
+    if(gpx->preamble)
+        start_build(gpx, gpx->preamble);
+    if(add_checkpoint(gpx, input, &inc, 0, NULL) && inc.then) rval = copy_spans(gpx, input, &inc);
+    if(rval == SUCCESS && !inc.finished) rval = convert_lines(gpx, input, checkpoint_line, &inc);
+    if(rval == SUCCESS && !inc.finished && !inc.failed) {
+        Checkpoint *cp = add_checkpoint(gpx, input, &inc, 0, NULL);
+        if(cp) cp->ended = input->pos < input->size;
+    }
+    if(rval == SUCCESS || rval == END_OF_FILE) rval = finish_pass(gpx);
+    gpx->callbackHandler = inc.handler;
+    gpx->callbackData = inc.data;
+    if(inc.failed) now->count = 0;
+    now->bytes = gpx->accumulated.bytes;
+    if(inc.then) VERBOSE( fprintf(gpx->log, "Copied %u of %u spans from the last conversion" EOL, inc.copied, now->count ? now->count - 1 : 0) );
+    free(inc.order);
+    free(inc.buffer);
+    return rval;
+}
+
+// convert the file, or with estimate only work out the totals the
+// conversion would have without writing any x3g
+
+static int convert_file(Gpx *gpx, FILE *file_in, FILE *file_out, FILE *file_out2, int estimate)
+{
+    int (*handler)(Gpx*, void*, char*, size_t) = estimate ? NULL : (int (*)(Gpx*, void*, char*, size_t))output_handler;
+    int rval;
+    Input input;
+    Output output;
+    Output spooled;
+    FILE *spool = NULL;
+    vector *marks = NULL;
+    int (*resultHandler)(Gpx*, void*, const char*, va_list);
+    int logMessages = gpx->flag.logMessages;
+    CacheEntry entry;
+    int cached = ERROR;
+    Checkpoints now, then;
+    int checkpoints = 0;
+
+    output.buffer = spooled.buffer = NULL;
+    memset(&entry, 0, sizeof(CacheEntry));
+    memset(&now, 0, sizeof(Checkpoints));
+    memset(&then, 0, sizeof(Checkpoints));
+    if((rval = input_open(&input, file_in ? file_in : stdin, gpx->flag.pipeline)) != SUCCESS) {
+#ifdef HAVE_ZLIB
+        fputs("Insufficient memory to inflate the gcode" EOL, gpx->log);
+#else
+        fputs("Compressed gcode isn't supported by this build of GPX" EOL, gpx->log);
+#endif
+        goto L_DONE;
+    }
+    if(!estimate && (rval = output_open(&output, file_out ? file_out : stdout, file_out2, gpx->flag.pipeline)) != SUCCESS) goto L_DONE;
+#ifdef HAVE_ZLIB
+    if(!estimate && gpx->compression && (rval = output_compress(&output, gpx->compression)) != SUCCESS) goto L_DONE;
+#endif
+
+    // start from the same state the second pass would, with the first pause
+    // @ zPos the ini or the caller set up issued at the start of the body
+    resultHandler = gpx->resultHandler;
+    gpx_initialize(gpx, 0);
+    gpx->resultHandler = resultHandler;
+    gpx->commandAtIndex = 0;
+    gpx->flag.pausePending = (gpx->commandAtLength > 0);
+
+    // the same gcode converted from the same state before is copied, the
+    // layer index and a resumed build aren't kept so are always converted
+    if(gpx->cache.dir && input.start >= 0 && gpx->layerIndex.layers == NULL && !gpx->flag.fastForward) {
+        cached = cache_lookup(gpx, &input, &entry, !estimate);
+        if(cached == SUCCESS) {
+            VERBOSE( fputs("Copied from the cache" EOL, gpx->log) );
+            if(input.map) input.pos = input.size;
+            rval = estimate ? SUCCESS : copy_cached(gpx, &output, entry.file);
+            goto L_DONE;
+        }
+        if(cached == END_OF_FILE && entry.file) output_tee(&output, entry.file, &entry.x3g);
+        if((rval = input_rewind(&input)) != SUCCESS) goto L_DONE;
+    }
+
+    // Single-pass, the x3g is spooled so the time based build progress can be
+    // filled in once the total time is known.  Input that can't be rewound is
+    // copied as it's read in case a second pass turns out to be needed.  A
+    // mapped file going into the cache spools into the sidecar of its
+    // checkpoints.
+    if(estimate) {
+        if(input_can_rewind(&input)) {
+            marks = vector_create(sizeof(ProgressMark), 1024, 65536);
+        }
+    }
+    else if(input_can_rewind(&input)) {
+        if(cached == END_OF_FILE && entry.file && entry.chunk && input.map && gpx->cache.checkpoints) {
+            spool = checkpoint_spool(gpx, &entry, &now);
+            if(spool) checkpoint_open(gpx, &entry, &then);
+        }
+        if(spool == NULL) spool = tmpfile();
+        if(spool && output_open(&spooled, spool, NULL, gpx->flag.pipeline) == SUCCESS) {
+            marks = vector_create(sizeof(ProgressMark), 1024, 65536);
+        }
+    }
+
+    gpx->flag.needSecondPass = 0;
+    if(marks) {
+        gpx->progressMarks = marks;
+        gpx->flag.runMacros = 1;
+        gpx->callbackHandler = handler;
+        gpx->callbackData = &spooled;
+    }
+    else if(input_can_rewind(&input)) {
+        // Multi-pass
+        gpx->flag.runMacros = 0;
+        gpx->flag.needSecondPass = 1;
+        gpx->callbackHandler = NULL;
+        gpx->callbackData = NULL;
+    }
+    else {
+        // Single-pass without build progress or pause @ zPos
+        gpx->callbackHandler = handler;
+        gpx->callbackData = &output;
+    }
+
+    if(marks && now.file)
+        rval = convert_incremental(gpx, &input, &entry, &now, then.count ? &then : NULL);
+    else
+#ifdef HAVE_PARALLEL
+    if(marks && spool && gpx->parallel > 1 && input.map)
+        rval = convert_parallel(gpx, &input, spool);
+    else
+#endif
+    rval = convert_pass(gpx, &input);
+    gpx->progressMarks = NULL;
+    if(rval != SUCCESS) goto L_DONE;
+
+    // if the time based progress would have started the build before the
+    // gcode did, the gcode after that was converted in the wrong state
+    if(marks && gpx->total.time > 0.0001) {
+        int i, started = 0;
+        for(i = 0; i < marks->c; i++) {
+            ProgressMark *pm = vector_get(marks, i);
+            if(pm->type == PROGRESS_START && round(100.0 * pm->time / gpx->total.time) > 0) {
+                started = 1;
+            }
+            else if(pm->type == PROGRESS_BUILD) {
+                // dropping a later M73 P0 or M136 is fine, but any other M73
+                // would have been converted as build progress
+                if(started && pm->percent) gpx->flag.needSecondPass = 1;
+                break;
+            }
+        }
+    }
+
+    if(!gpx->flag.needSecondPass) {
+        if(marks && (estimate || (rval = output_flush(&spooled)) == SUCCESS)) {
+            gpx->callbackHandler = handler;
+            gpx->callbackData = &output;
+            gpx->current.percent = 0;
+            rval = write_progress(gpx, marks, spool);
+            checkpoints = now.file != NULL;
+        }
+        goto L_DONE;
+    }
+
+    // rewind for second pass
+    if((rval = input_rewind(&input)) != SUCCESS) goto L_DONE;
+    gpx_initialize(gpx, 0);
+    gpx->resultHandler = resultHandler;
+    gpx->commandAtIndex = 0;
+    gpx->flag.loadMacros = 0;
+    gpx->flag.runMacros = 1;
+    gpx->flag.pausePending = (gpx->commandAtLength > 0);
+    //gpx->flag.logMessages = 0;
+    gpx->callbackHandler = handler;
+    gpx->callbackData = &output;
+    rval = convert_pass(gpx, &input);
+
+L_DONE:
+    PROFILE_ENTER(PROFILE_OUTPUT);
+    if(rval == SUCCESS && !estimate) rval = output_finish(&output);
+    PROFILE_LEAVE(PROFILE_OUTPUT);
+    output_close(&spooled);
+    // the spool is closed with the checkpoints
+    if(spool == now.file) spool = NULL;
+    checkpoint_close(&then);
+    // a failed write to the cache only loses the entry
+    if(cached == END_OF_FILE && entry.file && rval == SUCCESS && !output.dropped) {
+        if(checkpoints && checkpoint_store(gpx, &entry, &now, marks) != SUCCESS) VERBOSE( fputs("Unable to keep the checkpoints in the cache" EOL, gpx->log) );
+        if(cache_store(gpx, &entry) != SUCCESS) VERBOSE( fputs("Unable to keep the x3g in the cache" EOL, gpx->log) );
+    }
+    checkpoint_close(&now);
+    cache_close(&entry);
+    output_close(&output);
+    if(marks) vector_free(marks);
+    if(spool) fclose(spool);
+    input_close(&input);
+    gpx->flag.logMessages = logMessages;
+    return rval;
+}
+
+int gpx_convert(Gpx *gpx, FILE *file_in, FILE *file_out, FILE *file_out2)
+{
+    return convert_file(gpx, file_in, file_out, file_out2, 0);
+}
+
+int gpx_estimate(Gpx *gpx, FILE *file_in)
+{
+    return convert_file(gpx, file_in, NULL, NULL, 1);
+}
+
+void gpx_get_totals(Gpx *gpx, double *length, double *time, unsigned long *bytes, unsigned long *commands)
+{
+    if(length) *length = gpx->total.length;
+    if(time) *time = gpx->total.time;
+    if(bytes) *bytes = gpx->total.bytes;
+    if(commands) *commands = gpx->total.commands;
+}
+
+void gpx_set_pipeline(Gpx *gpx, int enable)
+{
+#ifdef HAVE_PIPELINE
+    gpx->flag.pipeline = enable ? 1 : 0;
+#endif
+}
+
+int gpx_set_cache(Gpx *gpx, const char *dir, unsigned long long size)
+{
+    char *copy = NULL;
+    if(dir && (copy = strdup(dir)) == NULL) return ERROR;
+    free(gpx->cache.dir);
+    gpx->cache.dir = copy;
+    gpx->cache.size = size;
+    return SUCCESS;
+}
+
+void gpx_set_checkpoints(Gpx *gpx, int enable)
+{
+    gpx->cache.checkpoints = enable ? 1 : 0;
+}
+
+int gpx_verify_cache(const char *dir, FILE *log)
+{
+    return cache_verify(dir, log);
+}
+
+void gpx_set_parallel(Gpx *gpx, unsigned threads)
+{
+#ifdef HAVE_PARALLEL
+    gpx->parallel = threads;
+#endif
+}
+
+int gpx_set_compression(Gpx *gpx, int level)
+{
+    if(level < 0 || level > 9) return ERROR;
+#ifndef HAVE_ZLIB
+    if(level) return ERROR;
+#endif
+    gpx->compression = level;
+    return SUCCESS;
+}
+
+char *sd_status[] = {
+    "operation successful",
+    "SD Card not present",
+    "SD Card initialization failed",
+    "partition table could not be read",
+    "filesystem could not be opened",
+    "root directory could not be opened",
+    "SD Card is locked",
+    "file not found",
+    "general error",
+    "changed working dir",
+    "volume too big",
+    "CRC failure",
+    "SD Card read error",
+    "SD operating at low speeds",
+    "unknown status"
+};
+
+char *get_sd_status(unsigned int status)
+{
+    return sd_status[status < 14 ? status : 14];
+}
+
+char *build_status[] = {
+    "no build initialized (boot state)",
+    "build running",
+    "build finished normally",
+    "build paused",
+    "build cancelled",
+    "build sleeping",
+    "unknown status"
+};
+
+char *get_build_status(unsigned int status)
+{
+    return build_status[status < 6 ? status : 6];
+}
+
+static void read_extruder_query_response(Gpx *gpx, Sio *sio, unsigned command, char *buffer)
+{
+    unsigned extruder_id = buffer[EXTRUDER_ID_OFFSET];
+
+    switch(command) {
+            // Query 00 - Query firmware version information
+        case 0:
+            // uint16: Firmware Version
             sio->response.firmware.version = read_16(gpx);
             VERBOSE( fprintf(gpx->log, "Extruder T%u firmware v%u.%u" EOL,
                         extruder_id,
@@ -6436,7 +9009,7 @@ int port_handler(Gpx *gpx, Sio *sio, char *buffer, size_t length)
             }
             // check CRC
             unsigned crc = (unsigned char)gpx->buffer.in[2 + payload_length];
-            if(crc != calculate_crc((unsigned char*)gpx->buffer.in + 2, payload_length)) {
+            if(crc != crc8(0, gpx->buffer.in + 2, payload_length)) {
                 fprintf(gpx->log, "(retry %u) Input CRC mismatch: packet discarded" EOL, retry_count);
                 rval = ESIOCRC;
                 goto L_RETRY;
@@ -6477,7 +9050,7 @@ int port_handler(Gpx *gpx, Sio *sio, char *buffer, size_t length)
                         short_sleep(NS_10MS);
 
                         // query buffer size
-                        CALL( port_handler(gpx, sio, buffer_size_query, 4) );
+                        CALL( port_handler(gpx, sio, (char *)buffer_size_query, 4) );
 
                         // if we now have room, let's go again
                         if (sio->response.bufferSize >= length)
@@ -6494,8 +9067,7 @@ int port_handler(Gpx *gpx, Sio *sio, char *buffer, size_t length)
                     do {
                         short_sleep(NS_100MS);
                         // query buffer size
-                        buffer_size_query[3] = calculate_crc((unsigned char *)buffer_size_query + 2, 1);
-                        CALL( port_handler(gpx, sio, buffer_size_query, 4) );
+                        CALL( port_handler(gpx, sio, (char *)buffer_size_query, 4) );
                         i++;
                         // loop until buffer has space for the next command
                     } while(sio->response.bufferSize < length);
@@ -6651,6 +9223,7 @@ int gpx_convert_and_send(Gpx *gpx, FILE *file_in, int sio_port,
         gpx->total.length = gpx->accumulated.a + gpx->accumulated.b;
         gpx->total.time = gpx->accumulated.time;
         gpx->total.bytes = gpx->accumulated.bytes;
+        gpx->total.commands = gpx->accumulated.commands;
 
         if(++i > 1) break;
 
@@ -6669,8 +9242,13 @@ int gpx_convert_and_send(Gpx *gpx, FILE *file_in, int sio_port,
     return SUCCESS;
 }
 
-void gpx_end_convert(Gpx *gpx)
+int gpx_end_convert(Gpx *gpx)
 {
+    // convert any moves still held back for a caller converting by line
+    int rval = coalesce_flush(gpx);
+    if(gpx->flag.fastForward && gpx->flag.logMessages) {
+        fputs("Resume point not reached: no x3g output" EOL, gpx->log);
+    }
     if(gpx->flag.verboseMode && gpx->flag.logMessages) {
         long seconds = round(gpx->accumulated.time);
         long minutes = seconds / 60;
@@ -6684,6 +9262,11 @@ void gpx_end_convert(Gpx *gpx)
         fprintf(gpx->log, "%lu seconds" EOL, seconds);
         fprintf(gpx->log, "X3G output filesize: %lu bytes" EOL, gpx->accumulated.bytes);
     }
+    if(gpx->coalesce.tolerance > 0.0 && gpx->flag.logMessages) {
+        fprintf(gpx->log, "Coalesced moves: %lu x3g commands eliminated" EOL, gpx->coalesce.eliminated);
+    }
+    if(gpx->profile) profile_report(gpx);
+    return rval;
 }
 
 // EEPROM
@@ -37,6 +37,7 @@ extern "C" {
 #include <time.h>
 #include "vector.h"
 #include "config.h"
+#include "libgpx.h"
 
 #if defined(SERIAL_SUPPORT)
 #if !defined(_WIN32) && !defined(_WIN64)
@@ -55,23 +56,6 @@ typedef long speed_t;
 
 #define HOST_VERSION 50
 
-#define END_OF_FILE 1
-#define SUCCESS 0
-#define ERROR -1
-
-#define ESIOWRITE -2
-#define ESIOREAD -3
-#define ESIOFRAME -4
-#define ESIOCRC -5
-// EOSERROR means error code is in errno
-#define EOSERROR -6
-#define ESIOTIMEOUT -7
-#define ESIOBADBAUD -8
-
-// Item codes for passing control options
-#define ITEM_FRAMING_ENABLE 1
-#define ITEM_FRAMING_DISABLE 2
-
 #define STREAM_VERSION_HIGH 0
 #define STREAM_VERSION_LOW 0
 
@@ -135,7 +119,9 @@ typedef long speed_t;
 
 #define E_IS_SET 0x20
 #define F_IS_SET 0x40
+#define I_IS_SET 0x80
 #define P_IS_SET 0x100
+#define J_IS_SET 0x200
 #define R_IS_SET 0x400
 #define S_IS_SET 0x800
 
@@ -148,6 +134,18 @@ typedef long speed_t;
 #define COMMENT_IS_SET 0x8000
 #define ARG_IS_SET 0x10000
 
+// a GpxMove flags its words with the same bits, these are the ones it may set
+
+#define MOVE_BIT_MASK (AXES_BIT_MASK | E_IS_SET | F_IS_SET | I_IS_SET | J_IS_SET | P_IS_SET | R_IS_SET | S_IS_SET | G_IS_SET | M_IS_SET | T_IS_SET)
+
+#if GPX_MOVE_X != X_IS_SET || GPX_MOVE_Y != Y_IS_SET || GPX_MOVE_Z != Z_IS_SET \
+    || GPX_MOVE_A != A_IS_SET || GPX_MOVE_B != B_IS_SET || GPX_MOVE_E != E_IS_SET \
+    || GPX_MOVE_F != F_IS_SET || GPX_MOVE_I != I_IS_SET || GPX_MOVE_J != J_IS_SET \
+    || GPX_MOVE_P != P_IS_SET || GPX_MOVE_R != R_IS_SET || GPX_MOVE_S != S_IS_SET \
+    || GPX_MOVE_G != G_IS_SET || GPX_MOVE_M != M_IS_SET || GPX_MOVE_T != T_IS_SET
+#error "the GpxMove word flags must match the command flags"
+#endif
+
     typedef struct tPoint2d {
         double a;
         double b;
@@ -178,6 +176,9 @@ typedef long speed_t;
         double e;
         double f;
 
+        double i;
+        double j;
+
         double p;
         double r;
         double s;
@@ -218,6 +219,8 @@ typedef long speed_t;
 #endif
         unsigned nozzle_temperature;
         unsigned build_platform_temperature;
+        int fan;                // last fan and valve state set, -1 until
+        int valve;              // the gcode sets one
     } Tool;
 
     typedef struct tOverride {
@@ -248,13 +251,156 @@ typedef long speed_t;
 
 #define COMMAND_AT_MAX 128
 
+    // build progress that can't be calculated until the total time is known
+
+#define PROGRESS_SET 0  // percent written by the gcode, tracks current.percent
+#define PROGRESS_M73 1  // M73 Pn, written unless the time based progress is in use
+#define PROGRESS_TIME 2 // time based progress after a command
+#define PROGRESS_START 3 // time based progress before the build has started
+#define PROGRESS_BUILD 4 // build started by the gcode
+#define PROGRESS_BUILT 5 // end of the gcode build start
+
+    typedef struct tProgressMark {
+        unsigned long offset;   // x3g byte offset the progress belongs at
+        unsigned long commands; // x3g commands before the offset
+        int type;
+        unsigned percent;
+        unsigned force;         // write the M73 regardless of total time
+        unsigned extruder;      // current extruder when the build might start
+        double time;            // accumulated time at the mark
+    } ProgressMark;
+
+    // MOTION CONSTANTS
+
+    // derived from the machine definition and the overrides, rebuilt by
+    // update_motion whenever one of their inputs changes so the per move
+    // calculations don't have to
+
+    typedef struct tMotion {
+        Point5d steps_per_mm;       // of every axis, for the kinematics
+        double max_feedrate;        // fastest axis in mm/min
+        double speed_scale;         // speed_factor / 100
+        int longest_dda;            // slowest of the x, y and z DDAs at max_feedrate
+        struct {
+            double extrusion_scale;     // extrusion_factor / 100
+            double packing_area;        // filament cross section * packing density
+            double packing_scale;       // nozzle_diameter * layerHeight / packing_area
+            double max_rpm;             // max_feedrate in revolutions per minute
+            double mm_per_revolution;
+        } extruder[2];
+    } Motion;
+
+    // ARCS
+
+#define ARC_TOLERANCE 0.01      // furthest a chord may stray from the arc in mm
+#define ARC_ANGLE_EPSILON 5E-7  // smaller turns than this are taken as none
+#define ARC_CORRECTION 16       // chords between exact recalculations
+
+    // MOVE COALESCING
+
+#define COALESCE_TOLERANCE 0.02 // default chord tolerance in mm
+#define COALESCE_WINDOW 32      // most moves merged into one
+
+    typedef struct tCoalesce {
+        double tolerance;       // chord tolerance in mm, 0 disables coalescing
+        int anchored;           // the last move converted can start a run
+        int anchorHasE;         // and the extruder position at its end is known
+        int extruding;          // the moves of the run set E
+        unsigned count;         // moves in the run, point[0] is where it starts
+        struct {
+            double x;
+            double y;
+            double e;
+        } point[COALESCE_WINDOW + 1];
+        Command pending;        // the run as one move, not yet converted
+        unsigned long eliminated;   // moves merged away
+    } Coalesce;
+
+    // MOTION PLANNER
+
+#define PLANNER_WINDOW 16       // default lookahead in moves
+#define PLANNER_WINDOW_MAX 64   // largest lookahead allowed
+
+    typedef struct tSegment {
+        Point5d unit;           // signed axis travel per mm along the move
+        double length;          // mm
+        double nominal;         // requested speed in mm/s
+        double acceleration;    // mm/s^2 within every axis limit, 0 for none
+        double max_entry;       // fastest junction into the move in mm/s
+        double bound;           // max_entry limited by the moves after it
+        double entry;           // planned entry speed in mm/s
+        double time;            // seconds booked to accumulated.time
+    } Segment;
+
+    typedef struct tPlanner {
+        unsigned window;        // lookahead in moves, 0 disables the planner
+        unsigned head;          // oldest move in the ring
+        unsigned count;         // moves in the ring
+        Segment segment[PLANNER_WINDOW_MAX];
+    } Planner;
+
+    // RESUME
+
+#define RESUME_HOP 5.0          // default lift clear of the print in mm
+
+    typedef struct tResume {
+        double z;               // resume at the first move to this Z or above
+        unsigned line;          // or at this line, 0 for neither
+        double hop;             // mm the nozzle lifts while the heaters recover
+    } Resume;
+
+    // LAYER INDEX
+
+    typedef struct tLayer {
+        double z;               // mm
+        unsigned long offset;   // bytes into the x3g where the layer starts
+        double time;            // seconds of the build before the layer
+        double filament;        // mm of filament extruded before the layer
+    } Layer;
+
+    typedef struct tLayerIndex {
+        vector *layers;         // of Layer, NULL unless the index is kept
+        Layer start;            // where the moves at the latest Z began
+        double z;               // of the last layer indexed
+    } LayerIndex;
+
+    // CONVERSION CACHE
+
+    typedef struct tCache {
+        char *dir;              // where converted x3g is kept, NULL for nowhere
+        unsigned long long size;    // bytes kept before the least recently used go
+        int checkpoints;        // keep checkpoints to reconvert an edited file from
+    } Cache;
+
+    // PROFILING
+
+#define PROFILE_INPUT 0         // reading gcode lines
+#define PROFILE_PARSE 1         // lexing the line into command words
+#define PROFILE_TRANSLATE 2     // interpreting the command
+#define PROFILE_TARGET 3        // calculate_target_position
+#define PROFILE_QUEUE 4         // queue_ext_point, excluding its encoding
+#define PROFILE_ENCODE 5        // packing x3g commands
+#define PROFILE_OUTPUT 6        // the callback handler and output flushing
+#define PROFILE_PHASES 7
+
+#define PROFILE_DEPTH 8
+
+    typedef struct tProfile {
+        int format;             // PROFILE_TABLE or PROFILE_JSON
+        int depth;
+        int stack[PROFILE_DEPTH];   // phases entered, the top one is being timed
+        double start;           // when the conversion started
+        double mark;            // when the top phase was last charged
+        double seconds[PROFILE_PHASES];
+        unsigned long calls[PROFILE_PHASES];
+    } Profile;
+
 #define BUFFER_MAX 1023
 
 #define PROTOCOL_FILENAME_MAX 65
 
     // GPX CONTEXT
 
-    typedef struct tGpx Gpx;
     typedef struct tSio Sio;
 
     struct tGpx {
@@ -310,6 +456,7 @@ typedef long speed_t;
         int commandAtIndex;
         int commandAtLength;
         double commandAtZ;
+        double commandAtReached; // highest Z moved to since the last checkpoint
 
         // vector (dynamic array) of eeprom mappings defined by @eeprom macro
         vector *eepromMappingVector;
@@ -317,6 +464,10 @@ typedef long speed_t;
         // builtin eeprom map
         EepromMap *eepromMap;
 
+        // vector of deferred build progress, non-NULL during a single pass conversion
+        vector *progressMarks;
+        Profile *profile;           // per phase timing, NULL unless profiling
+
 	const char *preamble;
 	int nostart, noend;
 
@@ -346,16 +497,28 @@ typedef long speed_t;
             unsigned macrosEnabled:1;   // M73 P1 or ;@body encountered signalling body start (so we don't pause during homing)
             unsigned loadMacros:1;      // used by the multi-pass converter to maintain state
             unsigned runMacros:1;       // used by the multi-pass converter to maintain state
+            unsigned needSecondPass:1;  // single pass conversion can't resolve the build progress or macros alone
             unsigned framingEnabled:1;  // enable framming of packets with header and crc
             unsigned sioConnected:1;    // connected to the bot
             unsigned sd_paused:1;       // printing from sd paused
             unsigned ignoreAbsoluteMoves:1; // until a coordinate system is defined via G92 or M132
+            unsigned fixedPoint:1;      // convert mm to steps in integer arithmetic
+            unsigned fastForward:1;     // before the resume point, track the state without output
+            unsigned pipeline:1;        // read the gcode ahead and write the x3g behind on threads
+            unsigned prescan:1;         // the prescan of a parallel conversion, track the state without any x3g
         } flag;
 
 
         double layerHeight;     // the current layer height
         unsigned lineNumber;    // the current line number
-        int longestDDA;
+        Motion motion;          // constants derived from the machine and overrides
+        Coalesce coalesce;      // nearly collinear moves held back to merge
+        Planner planner;        // lookahead window for the build time estimate
+        Resume resume;          // where a restarted print picks up
+        LayerIndex layerIndex;  // where each layer starts in the x3g
+        unsigned parallel;      // threads converting chunks of one file at once, 0 or 1 for none
+        int compression;        // zlib level the x3g is gzipped at, 0 for none
+        Cache cache;            // x3g of earlier conversions
         char *selectedFilename; // parameter from M23 - allocated, so free before replace
 
         // STATISTICS
@@ -365,12 +528,14 @@ typedef long speed_t;
             double b;
             double time;
             unsigned long bytes;
+            unsigned long commands;
         } accumulated;
 
         struct {
             double length;
             double time;
             unsigned long bytes;
+            unsigned long commands;
         } total;
 
         // CALLBACK
@@ -379,6 +544,7 @@ typedef long speed_t;
         void *callbackData;
         int (*resultHandler)(Gpx *gpx, void *callbackData, const char *fmt, va_list ap);
         struct tSio *sio;
+        struct tTio *tio;       // reprap response translation, see tio_initialize
 
         // LOGGING
 
@@ -598,36 +764,16 @@ typedef long speed_t;
     };
 
     void gpx_initialize(Gpx *gpx, int firstTime);
-    int gpx_set_machine(Gpx *gpx, const char *machine, int init);
-
-    int gpx_set_property(Gpx *gpx, const char* section, const char* property, char* value);
-    int gpx_load_config(Gpx *gpx, const char *filename);
 
     int gpx_sio_open(Gpx *gpx, const char *filename, speed_t baud_rate, int *sio_port);
     int ready_to_read(int fd);
     int port_handler(Gpx *gpx, Sio *sio, char *buffer, size_t length);
 
-    void gpx_register_callback(Gpx *gpx, int (*callbackHandler)(Gpx *gpx, void *callbackData, char *buffer, size_t length), void *callbackData);
-
-    void gpx_start_convert(Gpx *gpx, char *buildName, int item_code, ...);
-
     int gpx_daemon(Gpx *gpx, int create_daemon_port, const char *daemon_port, const char *printer_port, speed_t baudrate);
-    int gpx_convert_line(Gpx *gpx, char *gcode_line);
-    int gpx_convert(Gpx *gpx, FILE *file_in, FILE *file_out, FILE *file_out2);
     int gpx_convert_and_send(Gpx *gpx, FILE *file_in, int sio_port, int item_code, ...);
 
-    void gpx_end_convert(Gpx *gpx);
-
-    void gpx_list_machines(FILE *fp);
-
     int eeprom_load_config(Gpx *gpx, const char *filename);
 
-    void gpx_set_preamble(Gpx *gpx, const char *preamble);
-
-    void gpx_set_start(Gpx *gpx, int head);
-
-    void gpx_set_end(Gpx *gpx, int tail);
-
     int get_next_filename(Gpx *gpx, unsigned restart);
     int get_advanced_version_number(Gpx *gpx);
     char *get_build_status(unsigned int status);
@@ -666,6 +812,7 @@ typedef long speed_t;
 
     Tio *tio_initialize(Gpx *gpx);
     void tio_cleanup(Tio *tio);
+    void tio_destroy(Tio *tio);
     void tio_clear_state_for_cancel(Tio *tio);
     int tio_printf(Tio *tio, char const* fmt, ...);
     int tio_log_printf(Tio *tio, char const* fmt, ...);
@@ -673,8 +820,9 @@ typedef long speed_t;
     int gpx_return_translation(Gpx *gpx, int rval);
     int gpx_write_string_core(Gpx *gpx, const char *s);
     int gpx_write_string(Gpx *gpx, const char *s);
+    int gpx_write_moves_core(Gpx *gpx, const GpxMove *moves, size_t count, size_t *converted);
     int gcodeResult(Gpx *gpx, const char *fmt, ...);
-    speed_t speed_from_long(long *baudrate);
+    speed_t speed_from_long(Gpx *gpx, long *baudrate);
 
     void short_sleep(long nsec);
     void long_sleep(time_t sec);
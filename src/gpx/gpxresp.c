@@ -115,8 +115,6 @@ long sttb_find_nocase(Sttb *psttb, char *s)
     return -1;
 }
 
-static Tio tio;
-
 int tio_vprintf(Tio *tio, const char *fmt, va_list ap)
 {
     size_t result;
@@ -157,18 +155,27 @@ int tio_log_printf(Tio *tio, char const* fmt, ...)
 
 Tio *tio_initialize(Gpx *gpx)
 {
-    tio.cur = 0;
-    tio.translation[0] = 0;
-    tio.sio.port = -1;
-    tio.flags = 0;
-    tio.waiting = 0;
-    tio.sec = 0;
-    tio.gpx = gpx;
-    sttb_init(&tio.sttb, 10);
+    Tio *tio = gpx->tio;
+    if (tio == NULL) {
+        // one per Gpx context, released by gpx_destroy
+        if ((tio = calloc(1, sizeof(Tio))) == NULL)
+            return NULL;
+        gpx->tio = tio;
+    }
+    else if (tio->sttb.rgs != NULL)
+        sttb_cleanup(&tio->sttb);
+    tio->cur = 0;
+    tio->translation[0] = 0;
+    tio->sio.port = -1;
+    tio->flags = 0;
+    tio->waiting = 0;
+    tio->sec = 0;
+    tio->gpx = gpx;
+    sttb_init(&tio->sttb, 10);
     gpx->axis.positionKnown = 0;
     gpx->flag.M106AlwaysValve = 1;
-    tio.upstream = -1;
-    return &tio;
+    tio->upstream = -1;
+    return tio;
 }
 
 void tio_cleanup(Tio *tio)
@@ -193,6 +200,17 @@ void tio_cleanup(Tio *tio)
 }
 
 
+// release everything tio_initialize acquired, used by gpx_destroy
+void tio_destroy(Tio *tio)
+{
+    if (tio->sio.port > -1)
+        close(tio->sio.port);
+    if (tio->upstream > -1)
+        close(tio->upstream);
+    sttb_cleanup(&tio->sttb);
+    free(tio);
+}
+
 void tio_clear_state_for_cancel(Tio *tio)
 {
     tio->gpx->flag.programState = READY_STATE;
@@ -751,7 +769,8 @@ static int translate_result(Gpx *gpx, Tio *tio, const char *fmt, va_list ap)
 
 int gpx_return_translation(Gpx *gpx, int rval)
 {
-    int waiting = tio.waiting;
+    Tio *tio = gpx->tio;
+    int waiting = tio->waiting;
 
     // ENDED -> READY
     if (gpx->flag.programState > RUNNING_STATE)
@@ -760,7 +779,7 @@ int gpx_return_translation(Gpx *gpx, int rval)
 
     // if we're waiting for something and we haven't produced any output
     // give back current temps
-    if (rval == SUCCESS && tio.waiting && tio.cur == 0) {
+    if (rval == SUCCESS && tio->waiting && tio->cur == 0) {
         if(gpx->flag.verboseMode)
             fprintf(gpx->log, "implicit M105\n");
         strncpy(gpx->buffer.in, "M105", sizeof(gpx->buffer.in));
@@ -778,58 +797,58 @@ int gpx_return_translation(Gpx *gpx, int rval)
             break;
 
         case EOSERROR:
-            tio.cur = 0;
-            tio_printf(&tio, "Error: OS error trying to access X3G port");
+            tio->cur = 0;
+            tio_printf(tio, "Error: OS error trying to access X3G port");
             break;
         case ERROR:
-            tio.cur = 0;
-            tio_printf(&tio, "Error: GPX error");
+            tio->cur = 0;
+            tio_printf(tio, "Error: GPX error");
             break;
         case ESIOWRITE:
         case ESIOREAD:
         case ESIOFRAME:
         case ESIOCRC:
-            tio.cur = 0;
-            tio_printf(&tio, "Error: Serial communication error on X3G port. code = %d", rval);
+            tio->cur = 0;
+            tio_printf(tio, "Error: Serial communication error on X3G port. code = %d", rval);
             break;
         case ESIOTIMEOUT:
-            tio.cur = 0;
-            tio_printf(&tio, "Error: Timeout on X3G port");
+            tio->cur = 0;
+            tio_printf(tio, "Error: Timeout on X3G port");
             break;
         case 0x80:
-            tio.cur = 0;
-            tio_printf(&tio, "Error: X3G generic packet error");
+            tio->cur = 0;
+            tio_printf(tio, "Error: X3G generic packet error");
             break;
         case 0x82: // Action buffer overflow
-            tio.waitflag.waitForBuffer = 1;
-            tio.cur = 0;
-            tio_printf(&tio, "Status: Buffer full");
+            tio->waitflag.waitForBuffer = 1;
+            tio->cur = 0;
+            tio_printf(tio, "Status: Buffer full");
             break;
         case 0x83:
             // TODO resend?
-            tio.cur = 0;
-            tio_printf(&tio, "Error: X3G checksum mismatch");
+            tio->cur = 0;
+            tio_printf(tio, "Error: X3G checksum mismatch");
             break;
         case 0x84:
-            tio.cur = 0;
-            tio_printf(&tio, "Error: X3G query packet too big");
+            tio->cur = 0;
+            tio_printf(tio, "Error: X3G query packet too big");
             break;
         case 0x85:
-            tio.cur = 0;
-            tio_printf(&tio, "Error: X3G command not supported or recognized");
+            tio->cur = 0;
+            tio_printf(tio, "Error: X3G command not supported or recognized");
             break;
         case 0x87:
-            tio.cur = 0;
-            tio_printf(&tio, "Error: X3G timeout downstream");
+            tio->cur = 0;
+            tio_printf(tio, "Error: X3G timeout downstream");
             break;
         case 0x88:
-            tio.cur = 0;
-            tio_printf(&tio, "Error: X3G timeout for tool lock");
+            tio->cur = 0;
+            tio_printf(tio, "Error: X3G timeout for tool lock");
             break;
         case 0x89:
-            if (tio.waitflag.waitForBotCancel) {
+            if (tio->waitflag.waitForBotCancel) {
                 // ah, we told the bot to abort, and this 0x89 means that it did
-                tio.waitflag.waitForBotCancel = 0;
+                tio->waitflag.waitForBotCancel = 0;
                 if(gpx->flag.verboseMode)
                     fprintf(gpx->log, "cleared waitForBotCancel\n");
                 rval = SUCCESS;
@@ -842,49 +861,70 @@ int gpx_return_translation(Gpx *gpx, int rval)
             // we'll only get a @clear_cancel from the host loop, an M112
             // won't come through because the event layer will eat the next
             // event (because it's anticipating this event)
-            tio.flag.cancelPending = 1;
-            tio_clear_state_for_cancel(&tio);
-            tio_printf(&tio, "\nBuild cancelled");
+            tio->flag.cancelPending = 1;
+            tio_clear_state_for_cancel(tio);
+            tio_printf(tio, "\nBuild cancelled");
             break;
         case 0x8A:
-            tio.cur = 0;
-            tio_printf(&tio, "SD printing");
+            tio->cur = 0;
+            tio_printf(tio, "SD printing");
             break;
         case 0x8B:
-            tio.cur = 0;
-            tio_printf(&tio, "Error: RC_BOT_OVERHEAT Printer reports overheat condition");
+            tio->cur = 0;
+            tio_printf(tio, "Error: RC_BOT_OVERHEAT Printer reports overheat condition");
             break;
         case 0x8C:
-            tio.cur = 0;
-            tio_printf(&tio, "Error: timeout");
+            tio->cur = 0;
+            tio_printf(tio, "Error: timeout");
             break;
 
         default:
             if (gpx->flag.verboseMode)
                 fprintf(gpx->log, "Error: Unknown error code: %d", rval);
-            tio.cur = 0;
-            tio_printf(&tio, "Error: Unknown error code: %d", rval);
+            tio->cur = 0;
+            tio_printf(tio, "Error: Unknown error code: %d", rval);
             break;
     }
 
     // if the rval cleared the wait state, we need an ok
-    if(waiting && !tio.waiting) {
+    if(waiting && !tio->waiting) {
         if(gpx->flag.verboseMode)
             fprintf(gpx->log, "add ok for wait cleared\n");
-        if (tio.cur > 0 && tio.translation[tio.cur - 1] != '\n')
-            tio_printf(&tio, "\n");
-        tio_printf(&tio, "ok");
+        if (tio->cur > 0 && tio->translation[tio->cur - 1] != '\n')
+            tio_printf(tio, "\n");
+        tio_printf(tio, "ok");
     }
-    else if (tio.cur > 0 && tio.translation[tio.cur - 1] == '\n')
-        tio.translation[--tio.cur] = 0;
+    else if (tio->cur > 0 && tio->translation[tio->cur - 1] == '\n')
+        tio->translation[--tio->cur] = 0;
+
+    fflush(gpx->log);
+    return rval;
+}
+
+// answer the host once a line or a batch of moves has been converted
 
+static int write_answer(Gpx *gpx, unsigned waiting, int rval)
+{
+    Tio *tio = gpx->tio;
+    if (tio->flag.okPending) {
+        tio_printf(tio, "ok");
+        // ok means: I'm ready for another command, not necessarily that everything worked
+    }
+    // if we were waiting, but now we're not, throw an ok on there
+    else if (!tio->waiting && waiting)
+        tio_printf(tio, "\nok");
+    tio->flag.okPending = 0;
+    if (waiting && gpx->flag.verboseMode)
+        fprintf(gpx->log, "leaving gpx_write with waiting = %d\n", tio->waiting);
     fflush(gpx->log);
+
     return rval;
 }
 
 int gpx_write_string_core(Gpx *gpx, const char *s)
 {
-    unsigned waiting = tio.waiting;
+    Tio *tio = gpx->tio;
+    unsigned waiting = tio->waiting;
     if (waiting && gpx->flag.verboseMode)
         fprintf(gpx->log, "waiting in gpx_write_string\n");
 
@@ -895,19 +935,7 @@ int gpx_write_string_core(Gpx *gpx, const char *s)
     if (gpx->flag.verboseMode)
         fprintf(gpx->log, "gpx_write_string_core rval = %d\n", rval);
 
-    if (tio.flag.okPending) {
-        tio_printf(&tio, "ok");
-        // ok means: I'm ready for another command, not necessarily that everything worked
-    }
-    // if we were waiting, but now we're not, throw an ok on there
-    else if (!tio.waiting && waiting)
-        tio_printf(&tio, "\nok");
-    tio.flag.okPending = 0;
-    if (waiting && gpx->flag.verboseMode)
-        fprintf(gpx->log, "leaving gpx_write_string_core %d\n", tio.waiting);
-    fflush(gpx->log);
-
-    return rval;
+    return write_answer(gpx, waiting, rval);
 }
 
 int gpx_write_string(Gpx *gpx, const char *s)
@@ -915,9 +943,26 @@ int gpx_write_string(Gpx *gpx, const char *s)
     return gpx_return_translation(gpx, gpx_write_string_core(gpx, s));
 }
 
+// the moves are answered as one line would be, with a single ok
+
+int gpx_write_moves_core(Gpx *gpx, const GpxMove *moves, size_t count, size_t *converted)
+{
+    Tio *tio = gpx->tio;
+    unsigned waiting = tio->waiting;
+    if (waiting && gpx->flag.verboseMode)
+        fprintf(gpx->log, "waiting in gpx_write_moves\n");
+
+    int rval = gpx_convert_moves(gpx, moves, count, converted);
+
+    if (gpx->flag.verboseMode)
+        fprintf(gpx->log, "gpx_write_moves_core rval = %d\n", rval);
+
+    return write_answer(gpx, waiting, rval);
+}
+
 // convert from a long int value to a speed_t constant
 // returns B0 on failure
-speed_t speed_from_long(long *baudrate)
+speed_t speed_from_long(Gpx *gpx, long *baudrate)
 {
     speed_t speed = B0;
 
@@ -963,7 +1008,10 @@ speed_t speed_from_long(long *baudrate)
 #endif
             break;
         default:
-            tio_log_printf(&tio, "Error: Unsupported baud rate '%ld'\n", *baudrate);
+            if (gpx->tio != NULL)
+                tio_log_printf(gpx->tio, "Error: Unsupported baud rate '%ld'\n", *baudrate);
+            else
+                fprintf(gpx->log, "Error: Unsupported baud rate '%ld'\n", *baudrate);
             break;
     }
     return speed;
@@ -971,76 +1019,170 @@ speed_t speed_from_long(long *baudrate)
 
 int gpx_do_wait(Gpx *gpx)
 {
+    Tio *tio = gpx->tio;
     int rval = SUCCESS;
 
     if (gpx->flag.verboseMode)
-        fprintf(gpx->log, "tio.waiting = %u\n", tio.waiting);
-    if (!tio.waitflag.waitForCancelSync) {
-        if (tio.waitflag.waitForUnpause)
+        fprintf(gpx->log, "tio->waiting = %u\n", tio->waiting);
+    if (!tio->waitflag.waitForCancelSync) {
+        if (tio->waitflag.waitForUnpause)
             rval = get_build_statistics(gpx);
         // if we're waiting for the queue to drain, do that before checking on
         // anything else
-        if (rval == SUCCESS && (tio.waitflag.waitForEmptyQueue || tio.waitflag.waitForButton))
+        if (rval == SUCCESS && (tio->waitflag.waitForEmptyQueue || tio->waitflag.waitForButton))
             rval = is_ready(gpx);
-        if (rval == SUCCESS && !tio.waitflag.waitForEmptyQueue) {
-            if (tio.waitflag.waitForStart || tio.waitflag.waitForBotCancel) {
+        if (rval == SUCCESS && !tio->waitflag.waitForEmptyQueue) {
+            if (tio->waitflag.waitForStart || tio->waitflag.waitForBotCancel) {
                 struct timespec ts;
 
-                if (tio.secWaitForClearCancel && clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
-                    if ((tio.secWaitForClearCancel - ts.tv_sec) > 5) {
-                        tio.secWaitForClearCancel = ts.tv_sec;
-                        tio.cur = 0;
-                        tio_printf(&tio, "// echo: GPX forcing an ok due to timeout waiting for clear_cancel");
-                        tio_printf(&tio, "ok");
+                if (tio->secWaitForClearCancel && clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+                    if ((tio->secWaitForClearCancel - ts.tv_sec) > 5) {
+                        tio->secWaitForClearCancel = ts.tv_sec;
+                        tio->cur = 0;
+                        tio_printf(tio, "// echo: GPX forcing an ok due to timeout waiting for clear_cancel");
+                        tio_printf(tio, "ok");
                         return SUCCESS;
                     }
                 }
                 rval = get_build_statistics(gpx);
             }
-            if (rval == SUCCESS && tio.waitflag.waitForPlatform)
+            if (rval == SUCCESS && tio->waitflag.waitForPlatform)
                 rval = is_build_platform_ready(gpx, 0);
-            if (rval == SUCCESS && tio.waitflag.waitForExtruderA)
+            if (rval == SUCCESS && tio->waitflag.waitForExtruderA)
                 rval = is_extruder_ready(gpx, 0);
-            if (rval == SUCCESS && tio.waitflag.waitForExtruderB)
+            if (rval == SUCCESS && tio->waitflag.waitForExtruderB)
                 rval = is_extruder_ready(gpx, 1);
         }
     }
     if (gpx->flag.verboseMode)
-        fprintf(gpx->log, "tio.waiting = %u and rval = %d\n", tio.waiting, rval);
+        fprintf(gpx->log, "tio->waiting = %u and rval = %d\n", tio->waiting, rval);
     if (rval == SUCCESS) {
-        if (tio.waiting) {
+        if (tio->waiting) {
             if (gpx->flag.verboseMode) {
-                tio_printf(&tio, "// echo: tio.waiting = 0x%x\n", tio.waiting);
+                tio_printf(tio, "// echo: tio->waiting = 0x%x\n", tio->waiting);
             }
             return gpx_write_string_core(gpx, "M105");
         }
-        tio.cur = 0;
-        tio_printf(&tio, "ok");
+        tio->cur = 0;
+        tio_printf(tio, "ok");
     }
     return rval;
 }
 
+#if !defined(_WIN32) && !defined(_WIN64)
+int gpx_sio_open(Gpx *gpx, const char *filename, speed_t baud_rate,
+		 int *sio_port)
+{
+    struct termios tp;
+    int port;
+
+    if(sio_port)
+	 *sio_port = -1;
+
+    fprintf(gpx->log, "Opening port: %s.\n", filename);
+    // open and configure the serial port
+    if((port = open(filename, O_RDWR | O_NOCTTY | O_NONBLOCK)) < 0) {
+        perror("Error opening port");
+	return 0;
+    }
+
+    if(fcntl(port, F_SETFL, O_RDWR) < 0) {
+        perror("Setting port descriptor flags");
+	return 0;
+    }
+
+    if(tcgetattr(port, &tp) < 0) {
+        fprintf(stderr, "errno = %d", errno);
+        perror("Error getting port attributes");
+	return 0;
+    }
+
+    cfmakeraw(&tp);
+
+    /*
+     // 8N1
+     tp.c_cflag &= ~PARENB;
+     tp.c_cflag &= ~CSTOPB;
+     tp.c_cflag &= ~CSIZE;
+     tp.c_cflag |= CS8;
+
+     // no flow control
+     tp.c_cflag &= ~CRTSCTS;
+
+     // disable hang-up-on-close to avoid reset
+     //tp.c_cflag &= ~HUPCL;
+
+     // turn on READ & ignore ctrl lines
+     tp.c_cflag |= CREAD | CLOCAL;
+
+     // turn off s/w flow ctrl
+     tp.c_cflag &= ~(IXON | IXOFF | IXANY);
+
+     // make raw
+     tp.c_cflag &= ~(ICANON | ECHO | ECHOE | ISIG);
+     tp.c_cflag &= ~OPOST;
+
+     // see: http://unixwiz.net/techtips/termios-vmin-vtime.html
+     tp.c_cc[VMIN]  = 0;
+     tp.c_cc[VTIME] = 0;
+     */
+
+    cfsetspeed(&tp, baud_rate);
+    // cfsetispeed(&tp, baud_rate);
+    // cfsetospeed(&tp, baud_rate);
+
+    // let's ask the i/o system to block for up to a tenth of a second
+    // waiting for at least 255 bytes or whatever we asked for (whichever
+    // is least).
+    tp.c_cc[VMIN] = 255;
+    tp.c_cc[VTIME] = 1;
+
+    if(tcsetattr(port, TCSANOW, &tp) < 0) {
+        perror("Error setting port attributes");
+	return 0;
+    }
+
+    if(gpx->open_delay > 0) {
+		sleep(gpx->open_delay);
+	}
+    if(tcflush(port, TCIOFLUSH) < 0) {
+        perror("Error flushing port");
+	return 0;
+    }
+
+    if(gpx->flag.verboseMode) fprintf(gpx->log, "Communicating via: %s" EOL, filename);
+    if(sio_port)
+	 *sio_port = port;
+
+    return 1;
+}
+#endif
+
 int gpx_connect(Gpx *gpx, const char *printer_port, speed_t speed)
 {
+    Tio *tio = gpx->tio;
+    if (tio == NULL && (tio = tio_initialize(gpx)) == NULL)
+        return ERROR;
+
     // open the port
     if (speed == B0)
         return ESIOBADBAUD;
-    if (!gpx_sio_open(gpx, printer_port, speed, &tio.sio.port))
+    if (!gpx_sio_open(gpx, printer_port, speed, &tio->sio.port))
         return EOSERROR;
 
     // initialize tio
-    tio.gpx = gpx;
-    tio.sio.in = NULL;
-    tio.sio.bytes_out = tio.sio.bytes_in = 0;
-    tio.sio.flag.retryBufferOverflow = 1;
-    tio.sio.flag.shortRetryBufferOverflowOnly = 0;
+    tio->gpx = gpx;
+    tio->sio.in = NULL;
+    tio->sio.bytes_out = tio->sio.bytes_in = 0;
+    tio->sio.flag.retryBufferOverflow = 1;
+    tio->sio.flag.shortRetryBufferOverflowOnly = 0;
 
     // set up gpx
     gpx_start_convert(gpx, "", 0);
     gpx->flag.framingEnabled = 1;
     gpx->flag.sioConnected = 1;
-    gpx->sio = &tio.sio;
-    gpx_register_callback(gpx, (int (*)(Gpx*, void*, char*, size_t))translate_handler, &tio);
+    gpx->sio = &tio->sio;
+    gpx_register_callback(gpx, (int (*)(Gpx*, void*, char*, size_t))translate_handler, tio);
     gpx->resultHandler = (int (*)(Gpx*, void*, const char*, va_list))translate_result;
 
     fprintf(gpx->log, "gpx connected to %s\n", printer_port);
@@ -1048,7 +1190,7 @@ int gpx_connect(Gpx *gpx, const char *printer_port, speed_t speed)
     // if the user has CLEAR_FOR_ESTOP set, then we shouldn't send absolute moves
     // to the bot after cancel (ESTOP) until a new coordinate system is defined
     // with G92 or M132.
-    tio.flag.clear_on_estop_set = 0;
+    tio->flag.clear_on_estop_set = 0;
     EepromMap *map = find_eeprom_map(gpx);
     if (map != NULL) {
         gpx->eepromMap = map;
@@ -1058,36 +1200,37 @@ int gpx_connect(Gpx *gpx, const char *printer_port, speed_t speed)
             unsigned char b = 0;
             int rval = read_eeprom_8(gpx, gpx->sio, mapping->address, &b);
             if (rval == SUCCESS) {
-                tio.flag.clear_on_estop_set = 1;
+                tio->flag.clear_on_estop_set = 1;
             }
         }
     }
 
-    tio.cur = 0;
-    tio_printf(&tio, "start\n");
+    tio->cur = 0;
+    tio_printf(tio, "start\n");
     return SUCCESS;
 }
 
 static int gpx_create_daemon_port(Gpx *gpx, const char *daemon_port)
 {
+    Tio *tio = gpx->tio;
 #ifdef HAVE_POSIX_OPENPT
     // create the master/slave psuedo-terminal pair
-    if ((tio.upstream = posix_openpt(O_RDWR|O_NOCTTY)) < 0) {
+    if ((tio->upstream = posix_openpt(O_RDWR|O_NOCTTY)) < 0) {
         fprintf(gpx->log, "Error: Unable to create psuedo terminal (posix_openpt failed). errno = %d\n", errno);
         return EOSERROR;
     }
 
     // grant and unlock
-    if (grantpt(tio.upstream) < 0) {
+    if (grantpt(tio->upstream) < 0) {
         fprintf(gpx->log, "Warning: Unable to grant psuedo terminal. errno = %d\n", errno);
     }
-    if (unlockpt(tio.upstream) < 0) {
+    if (unlockpt(tio->upstream) < 0) {
         fprintf(gpx->log, "Warning: Unable to unlock psuedo terminal. errno = %d\n", errno);
     }
 
     // figure out the slave end's name
     char *pn = NULL;
-    if ((pn = ptsname(tio.upstream)) == NULL) {
+    if ((pn = ptsname(tio->upstream)) == NULL) {
         fprintf(gpx->log, "Error: Unable to create virtual port (ptsname returned NULL). errno = %d\n", errno);
         return EOSERROR;
     }
@@ -1115,12 +1258,12 @@ static int gpx_create_daemon_port(Gpx *gpx, const char *daemon_port)
 
     // attempt to set it to raw
     struct termios ti;
-    if(tcgetattr(tio.upstream, &ti) < 0) {
+    if(tcgetattr(tio->upstream, &ti) < 0) {
         fprintf(gpx->log, "Warn: Unable to get virtual port attributes. errno = %d\n", errno);
     }
     else {
         cfmakeraw(&ti);
-        if(tcsetattr(tio.upstream, TCSANOW, &ti) < 0) {
+        if(tcsetattr(tio->upstream, TCSANOW, &ti) < 0) {
             fprintf(gpx->log, "Warn: Unable to set virtual port attributes. errno = %d\n", errno);
         }
     }
@@ -1134,13 +1277,14 @@ static int gpx_create_daemon_port(Gpx *gpx, const char *daemon_port)
 
 static void gpx_write_upstream_translation(Gpx *gpx)
 {
-    tio_printf(&tio, "\n");
-    VERBOSE( fprintf(gpx->log, "write: %s", tio.translation); )
-    int len = strlen(tio.translation);
-    if(len != write(tio.upstream, tio.translation, strlen(tio.translation))) {
+    Tio *tio = gpx->tio;
+    tio_printf(tio, "\n");
+    VERBOSE( fprintf(gpx->log, "write: %s", tio->translation); )
+    int len = strlen(tio->translation);
+    if(len != write(tio->upstream, tio->translation, strlen(tio->translation))) {
         VERBOSE( fprintf(gpx->log, "write on upstream failed to write all bytes.  errno = %d.\n", errno) );
     }
-    tio.translation[tio.cur = 0] = 0;
+    tio->translation[tio->cur = 0] = 0;
     fflush(gpx->log);
 }
 
@@ -1161,7 +1305,7 @@ static int wait_for_hup_clear(Gpx *gpx, int fd)
         short_sleep(250000000L);
     }
     if (send_ok) {
-        tio_printf(&tio, "ok");
+        tio_printf(gpx->tio, "ok");
         gpx_write_upstream_translation(gpx);
     }
     return SUCCESS;
@@ -1179,13 +1323,13 @@ int ready_to_read(int fd)
 {
     fd_set rfds;
     FD_ZERO(&rfds);
-    FD_SET(tio.upstream, &rfds);
+    FD_SET(fd, &rfds);
 
     struct timeval timeout;
     timeout.tv_sec = 1;
     timeout.tv_usec = 0;
 
-    return (select(tio.upstream + 1, &rfds, NULL, NULL, &timeout) > 0);
+    return (select(fd + 1, &rfds, NULL, NULL, &timeout) > 0);
 }
 #endif
 
@@ -1194,14 +1338,16 @@ int gpx_daemon(Gpx *gpx, int create_port, const char *daemon_port, const char *p
     int rval = SUCCESS;
     int overflow = 0;
 
-    tio_initialize(gpx);
+    Tio *tio = tio_initialize(gpx);
+    if (tio == NULL)
+        return ERROR;
 
     if (create_port) {
         if ((rval = gpx_create_daemon_port(gpx, daemon_port)) != SUCCESS)
             return rval;
     }
     else {
-        if ((tio.upstream = open(daemon_port, O_RDWR)) < 0) {
+        if ((tio->upstream = open(daemon_port, O_RDWR)) < 0) {
             fprintf(gpx->log, "Error: Unable to open psuedo terminal (%s). errno = %d\n", daemon_port, errno);
             return EOSERROR;
         }
@@ -1218,24 +1364,24 @@ int gpx_daemon(Gpx *gpx, int create_port, const char *daemon_port, const char *p
         int remaining = BUFFER_MAX;
 
         // simulate wait loop, if we are waiting
-        tio.waitflag.waitForBuffer = 0;
-        while (tio.waiting) {
+        tio->waitflag.waitForBuffer = 0;
+        while (tio->waiting) {
             rval = gpx_return_translation(gpx, gpx_do_wait(gpx));
             if(rval != SUCCESS)
                 fprintf(gpx->log, "wait test failed. gpx_do_wait returned %d.", rval);
-            if(tio.cur > 0)
+            if(tio->cur > 0)
                 gpx_write_upstream_translation(gpx);
-            if(ready_to_read(tio.upstream))
+            if(ready_to_read(tio->upstream))
                 break;
         }
 
         // read a line
         for(; remaining; remaining--, p++) {
-            while ((bytes_read = read(tio.upstream, p, 1)) != 1) {
+            while ((bytes_read = read(tio->upstream, p, 1)) != 1) {
                 if (bytes_read < 0) {
                     switch (errno) {
                         case EIO:
-                            wait_for_hup_clear(gpx, tio.upstream);
+                            wait_for_hup_clear(gpx, tio->upstream);
                             break;
                         case EINTR:
                             break;
@@ -1268,28 +1414,28 @@ int gpx_daemon(Gpx *gpx, int create_port, const char *daemon_port, const char *p
             // since technically we should ignore ';' contained within a
             // parenthetical comment
             if(!strchr(gpx->buffer.in, ';'))
-                tio_printf(&tio, "(line %u) Buffer overflow: input exceeds %u character limit, remaining characters in line will be ignored" EOL, gpx->lineNumber, BUFFER_MAX);
+                tio_printf(tio, "(line %u) Buffer overflow: input exceeds %u character limit, remaining characters in line will be ignored" EOL, gpx->lineNumber, BUFFER_MAX);
         }
 
-        tio.flag.okPending = !tio.waiting;
+        tio->flag.okPending = !tio->waiting;
         rval = gpx_write_string(gpx, gpx->buffer.in);
         gpx_write_upstream_translation(gpx);
 
         if(rval == EOSERROR && access(printer_port, R_OK)) {
-            tio_printf(&tio, "Error: GPX shutting down, printer disconnected.\n");
+            tio_printf(tio, "Error: GPX shutting down, printer disconnected.\n");
             break;
         }
 
-        while(tio.flag.listingFiles) {
+        while(tio->flag.listingFiles) {
             get_next_filename(gpx, 0);
             gpx_write_upstream_translation(gpx);
         }
 
-        if (tio.flag.waitClearedByCancel) {
+        if (tio->flag.waitClearedByCancel) {
             if(gpx->flag.verboseMode)
                 fprintf(gpx->log, "adding ok for wait cleared by cancel\n");
-            tio.flag.waitClearedByCancel = 0;
-            tio_printf(&tio, "ok");
+            tio->flag.waitClearedByCancel = 0;
+            tio_printf(tio, "ok");
             gpx_write_upstream_translation(gpx);
         }
     }
@@ -0,0 +1,412 @@
+//  kinematics.c
+//
+//  Branch free 5D vector arithmetic for the move conversion
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <math.h>
+#include <stdint.h>
+
+#include "kinematics.h"
+
+#ifdef HAVE_KINEMATICS_SSE2
+#include <immintrin.h>
+#endif
+
+// the lanes are loaded straight from a Point5d
+typedef char point5d_is_five_doubles[sizeof(Point5d) == 5 * sizeof(double) ? 1 : -1];
+
+#if defined(__GNUC__)
+#define LANES_ALIGNED __attribute__((aligned(64)))
+#else
+#define LANES_ALIGNED
+#endif
+
+// lane masks for each combination of the X_IS_SET to B_IS_SET flags
+
+#define M(f, bit) ((f) & (bit) ? ~(uint64_t)0 : 0)
+#define MASK(f) { M(f, X_IS_SET), M(f, Y_IS_SET), M(f, Z_IS_SET), M(f, A_IS_SET), M(f, B_IS_SET), 0, 0, 0 }
+
+static const uint64_t axis_mask[AXES_BIT_MASK + 1][AXIS_LANES] LANES_ALIGNED = {
+    MASK(0), MASK(1), MASK(2), MASK(3), MASK(4), MASK(5), MASK(6), MASK(7),
+    MASK(8), MASK(9), MASK(10), MASK(11), MASK(12), MASK(13), MASK(14), MASK(15),
+    MASK(16), MASK(17), MASK(18), MASK(19), MASK(20), MASK(21), MASK(22), MASK(23),
+    MASK(24), MASK(25), MASK(26), MASK(27), MASK(28), MASK(29), MASK(30), MASK(31)
+};
+
+#undef M
+#undef MASK
+
+#ifdef HAVE_KINEMATICS_SSE2
+
+// SSE2 is part of x86-64, the lanes are worked on in the x y, z a and b pad
+// register pairs and each pair is masked by the matching pair of the row
+
+#define PAIR_MASK(flag) ((const __m128d *)axis_mask[(flag) & AXES_BIT_MASK])
+
+// VECTOR FUNCTIONS
+
+double point5d_magnitude(int flag, const Point5d *v)
+{
+    const __m128d *mask = PAIR_MASK(flag);
+    __m128d xy = _mm_loadu_pd(&v->x);
+    __m128d za = _mm_loadu_pd(&v->z);
+    __m128d b = _mm_load_sd(&v->b);
+    xy = _mm_and_pd(_mm_mul_pd(xy, xy), mask[0]);
+    za = _mm_and_pd(_mm_mul_pd(za, za), mask[1]);
+    b = _mm_and_pd(_mm_mul_sd(b, b), mask[2]);
+    // a masked axis adds +0.0, which leaves the sum as it was
+    __m128d sum = _mm_add_sd(xy, _mm_unpackhi_pd(xy, xy));
+    sum = _mm_add_sd(sum, za);
+    sum = _mm_add_sd(sum, _mm_unpackhi_pd(za, za));
+    sum = _mm_add_sd(sum, b);
+    return sqrt(_mm_cvtsd_f64(sum));
+}
+
+double point5d_largest_axis(int flag, const Point5d *v)
+{
+    const __m128d *mask = PAIR_MASK(flag);
+    __m128d sign = _mm_set1_pd(-0.0);
+    __m128d xy = _mm_and_pd(_mm_andnot_pd(sign, _mm_loadu_pd(&v->x)), mask[0]);
+    __m128d za = _mm_and_pd(_mm_andnot_pd(sign, _mm_loadu_pd(&v->z)), mask[1]);
+    __m128d b = _mm_and_pd(_mm_andnot_pd(sign, _mm_load_sd(&v->b)), mask[2]);
+    // max_sd(l, r) keeps r unless l > r, the same as if(r < l) r = l
+    __m128d result = _mm_max_sd(_mm_unpackhi_pd(xy, xy), xy);
+    result = _mm_max_sd(za, result);
+    result = _mm_max_sd(_mm_unpackhi_pd(za, za), result);
+    result = _mm_max_sd(b, result);
+    return _mm_cvtsd_f64(result);
+}
+
+Point5d point5d_delta(int flag, const Point5d *to, const Point5d *from, const unsigned percent[2])
+{
+    const __m128d *mask = PAIR_MASK(flag);
+    Point5d delta;
+    __m128d xy = _mm_sub_pd(_mm_loadu_pd(&to->x), _mm_loadu_pd(&from->x));
+    __m128d za = _mm_sub_pd(_mm_loadu_pd(&to->z), _mm_loadu_pd(&from->z));
+    __m128d b = _mm_sub_sd(_mm_load_sd(&to->b), _mm_load_sd(&from->b));
+    // z * 1 / 1 is exactly z, so it can share the extruder scaling with a
+    za = _mm_div_pd(_mm_mul_pd(za, _mm_set_pd(percent[0], 1.0)), _mm_set_pd(100.0, 1.0));
+    b = _mm_div_sd(_mm_mul_sd(b, _mm_set_sd(percent[1])), _mm_set_sd(100.0));
+    _mm_storeu_pd(&delta.x, _mm_and_pd(xy, mask[0]));
+    _mm_storeu_pd(&delta.z, _mm_and_pd(za, mask[1]));
+    _mm_store_sd(&delta.b, _mm_and_pd(b, mask[2]));
+    return delta;
+}
+
+#else
+
+// without SSE2 the lanes are a union the compiler can vectorize as it sees fit
+
+typedef union {
+    double d[AXIS_LANES];
+    uint64_t u[AXIS_LANES];
+} Lanes;
+
+#define SIGN_BIT ((uint64_t)1 << 63)
+
+static void load(Lanes *lanes, const Point5d *p)
+{
+    lanes->d[0] = p->x;
+    lanes->d[1] = p->y;
+    lanes->d[2] = p->z;
+    lanes->d[3] = p->a;
+    lanes->d[4] = p->b;
+    lanes->d[5] = 0.0;
+    lanes->d[6] = 0.0;
+    lanes->d[7] = 0.0;
+}
+
+static Point5d store(const Lanes *lanes)
+{
+    Point5d p;
+    p.x = lanes->d[0];
+    p.y = lanes->d[1];
+    p.z = lanes->d[2];
+    p.a = lanes->d[3];
+    p.b = lanes->d[4];
+    return p;
+}
+
+// VECTOR FUNCTIONS
+
+double point5d_magnitude(int flag, const Point5d *v)
+{
+    const uint64_t *mask = axis_mask[flag & AXES_BIT_MASK];
+    Lanes lanes;
+    int i;
+    load(&lanes, v);
+    for(i = 0; i < AXIS_LANES; i++) {
+        lanes.d[i] *= lanes.d[i];
+        lanes.u[i] &= mask[i];
+    }
+    // a masked axis adds +0.0, which leaves the sum as it was
+    return sqrt((((lanes.d[0] + lanes.d[1]) + lanes.d[2]) + lanes.d[3]) + lanes.d[4]);
+}
+
+double point5d_largest_axis(int flag, const Point5d *v)
+{
+    const uint64_t *mask = axis_mask[flag & AXES_BIT_MASK];
+    Lanes lanes;
+    double result;
+    int i;
+    load(&lanes, v);
+    for(i = 0; i < AXIS_LANES; i++) {
+        lanes.u[i] &= mask[i] & ~SIGN_BIT;
+    }
+    result = lanes.d[0];
+    for(i = 1; i < 5; i++) {
+        if(result < lanes.d[i]) result = lanes.d[i];
+    }
+    return result;
+}
+
+Point5d point5d_delta(int flag, const Point5d *to, const Point5d *from, const unsigned percent[2])
+{
+    const uint64_t *mask = axis_mask[flag & AXES_BIT_MASK];
+    // x * 1 / 1 is exactly x, so every lane can take the extruder scaling
+    const double scale[AXIS_LANES] = { 1, 1, 1, percent[0], percent[1], 1, 1, 1 };
+    static const double divisor[AXIS_LANES] = { 1, 1, 1, 100, 100, 1, 1, 1 };
+    Lanes t, f;
+    int i;
+    load(&t, to);
+    load(&f, from);
+    for(i = 0; i < AXIS_LANES; i++) {
+        t.d[i] = (t.d[i] - f.d[i]) * scale[i] / divisor[i];
+        t.u[i] &= mask[i];
+    }
+    return store(&t);
+}
+
+#endif
+
+// BATCH CONVERSION
+
+void point5d_to_steps_scalar(const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count, Point2d *excess)
+{
+    double value;
+    size_t n;
+    for(n = 0; n < count; n++) {
+        steps[n].x = round(mm[n].x * steps_per_mm->x);
+        steps[n].y = round(mm[n].y * steps_per_mm->y);
+        steps[n].z = round(mm[n].z * steps_per_mm->z);
+        if(excess) {
+            // accumulate rounding remainder
+            value = (mm[n].a * steps_per_mm->a) + excess->a;
+            steps[n].a = round(value);
+            excess->a = value - steps[n].a;
+
+            value = (mm[n].b * steps_per_mm->b) + excess->b;
+            steps[n].b = round(value);
+            excess->b = value - steps[n].b;
+        }
+        else {
+            steps[n].a = round(mm[n].a * steps_per_mm->a);
+            steps[n].b = round(mm[n].b * steps_per_mm->b);
+        }
+    }
+}
+
+void point5d_delta_steps_scalar(int flag, const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count)
+{
+    size_t n;
+    for(n = 0; n < count; n++) {
+        steps[n].x = flag & X_IS_SET ? round(fabs(mm[n].x) * steps_per_mm->x) : 0;
+        steps[n].y = flag & Y_IS_SET ? round(fabs(mm[n].y) * steps_per_mm->y) : 0;
+        steps[n].z = flag & Z_IS_SET ? round(fabs(mm[n].z) * steps_per_mm->z) : 0;
+        steps[n].a = flag & A_IS_SET ? round(fabs(mm[n].a) * steps_per_mm->a) : 0;
+        steps[n].b = flag & B_IS_SET ? round(fabs(mm[n].b) * steps_per_mm->b) : 0;
+    }
+}
+
+#ifdef HAVE_KINEMATICS_SSE41
+
+// round half away from zero, as round() does: truncate and step away from
+// zero when the dropped fraction is at least a half.  v - trunc(v) is exact,
+// and the lanes that don't step keep trunc(v) itself, sign of zero included.
+
+__attribute__((target("sse4.1")))
+static inline __m128d sse41_round(__m128d v)
+{
+    __m128d t = _mm_round_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m128d f = _mm_sub_pd(v, t);
+    __m128d one = _mm_set1_pd(1.0);
+    t = _mm_blendv_pd(t, _mm_add_pd(t, one), _mm_cmpge_pd(f, _mm_set1_pd(0.5)));
+    t = _mm_blendv_pd(t, _mm_sub_pd(t, one), _mm_cmple_pd(f, _mm_set1_pd(-0.5)));
+    return t;
+}
+
+__attribute__((target("sse4.1")))
+void point5d_to_steps_sse41(const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count, Point2d *excess)
+{
+    __m128d s_xy = _mm_loadu_pd(&steps_per_mm->x);
+    __m128d s_za = _mm_loadu_pd(&steps_per_mm->z);
+    __m128d s_b = _mm_load_sd(&steps_per_mm->b);
+    size_t n;
+    if(excess) {
+        // the remainders ride in the a and b lanes, only the a lane of the z a
+        // pair takes the add so z rounds exactly as it would without it
+        __m128d e_za = _mm_set_pd(excess->a, 0.0);
+        __m128d e_b = _mm_load_sd(&excess->b);
+        for(n = 0; n < count; n++) {
+            __m128d za = _mm_mul_pd(_mm_loadu_pd(&mm[n].z), s_za);
+            __m128d b = _mm_add_sd(_mm_mul_sd(_mm_load_sd(&mm[n].b), s_b), e_b);
+            za = _mm_blend_pd(za, _mm_add_pd(za, e_za), 0x2);
+            __m128d r_za = sse41_round(za);
+            __m128d r_b = sse41_round(b);
+            e_za = _mm_blend_pd(_mm_setzero_pd(), _mm_sub_pd(za, r_za), 0x2);
+            e_b = _mm_sub_sd(b, r_b);
+            _mm_storeu_pd(&steps[n].x, sse41_round(_mm_mul_pd(_mm_loadu_pd(&mm[n].x), s_xy)));
+            _mm_storeu_pd(&steps[n].z, r_za);
+            _mm_store_sd(&steps[n].b, r_b);
+        }
+        _mm_storeh_pd(&excess->a, e_za);
+        _mm_store_sd(&excess->b, e_b);
+    }
+    else {
+        for(n = 0; n < count; n++) {
+            _mm_storeu_pd(&steps[n].x, sse41_round(_mm_mul_pd(_mm_loadu_pd(&mm[n].x), s_xy)));
+            _mm_storeu_pd(&steps[n].z, sse41_round(_mm_mul_pd(_mm_loadu_pd(&mm[n].z), s_za)));
+            _mm_store_sd(&steps[n].b, sse41_round(_mm_mul_sd(_mm_load_sd(&mm[n].b), s_b)));
+        }
+    }
+}
+
+__attribute__((target("sse4.1")))
+void point5d_delta_steps_sse41(int flag, const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count)
+{
+    const __m128d *mask = PAIR_MASK(flag);
+    __m128d s_xy = _mm_loadu_pd(&steps_per_mm->x);
+    __m128d s_za = _mm_loadu_pd(&steps_per_mm->z);
+    __m128d s_b = _mm_load_sd(&steps_per_mm->b);
+    __m128d sign = _mm_set1_pd(-0.0);
+    size_t n;
+    for(n = 0; n < count; n++) {
+        __m128d xy = _mm_mul_pd(_mm_andnot_pd(sign, _mm_loadu_pd(&mm[n].x)), s_xy);
+        __m128d za = _mm_mul_pd(_mm_andnot_pd(sign, _mm_loadu_pd(&mm[n].z)), s_za);
+        __m128d b = _mm_mul_sd(_mm_andnot_pd(sign, _mm_load_sd(&mm[n].b)), s_b);
+        _mm_storeu_pd(&steps[n].x, _mm_and_pd(sse41_round(xy), mask[0]));
+        _mm_storeu_pd(&steps[n].z, _mm_and_pd(sse41_round(za), mask[1]));
+        _mm_store_sd(&steps[n].b, _mm_and_pd(sse41_round(b), mask[2]));
+    }
+}
+
+#endif
+
+void point5d_to_steps(const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count, Point2d *excess)
+{
+#if defined(HAVE_KINEMATICS_SSE41)
+    if(__builtin_cpu_supports("sse4.1")) {
+        point5d_to_steps_sse41(steps_per_mm, mm, steps, count, excess);
+        return;
+    }
+#endif
+    point5d_to_steps_scalar(steps_per_mm, mm, steps, count, excess);
+}
+
+void point5d_delta_steps(int flag, const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count)
+{
+#if defined(HAVE_KINEMATICS_SSE41)
+    if(__builtin_cpu_supports("sse4.1")) {
+        point5d_delta_steps_sse41(flag, steps_per_mm, mm, steps, count);
+        return;
+    }
+#endif
+    point5d_delta_steps_scalar(flag, steps_per_mm, mm, steps, count);
+}
+
+// FIXED POINT CONVERSION
+
+#define STEP_ONE ((double)((int64_t)1 << STEP_FRACTION_BITS))
+#define STEP_HALF ((int64_t)1 << (STEP_FRACTION_BITS - 1))
+
+// the nearest integer, half away from zero as llround but inline, v - t is
+// exact so the comparisons are too
+
+static int64_t nearest(double v)
+{
+    int64_t t = (int64_t)v;
+    double fraction = v - (double)t;
+    if(fraction >= 0.5) return t + 1;
+    if(fraction <= -0.5) return t - 1;
+    return t;
+}
+
+// mm in step fractions, scaling by a power of two is exact so the only
+// rounding is that of the one multiplication
+
+static int64_t fixed_fractions(double steps_per_mm, double mm)
+{
+    return nearest(mm * steps_per_mm * STEP_ONE);
+}
+
+// the nearest whole step, half away from zero
+
+static int64_t fixed_round(int64_t fractions)
+{
+    if(fractions < 0) return -((STEP_HALF - fractions) >> STEP_FRACTION_BITS);
+    return (fractions + STEP_HALF) >> STEP_FRACTION_BITS;
+}
+
+// the whole steps of fractions plus the carried remainder, the remainder is
+// kept in a double as the step fractions, which it holds exactly
+
+static double fixed_carry(int64_t fractions, double *excess)
+{
+    int64_t value = fractions + (int64_t)*excess;
+    int64_t steps = fixed_round(value);
+    *excess = (double)(value - steps * ((int64_t)1 << STEP_FRACTION_BITS));
+    return (double)steps;
+}
+
+// the nearest whole step of the same product the double path rounds, taking
+// it to step fractions first could round twice
+
+double steps_fixed(double steps_per_mm, double mm)
+{
+    return (double)nearest(mm * steps_per_mm);
+}
+
+void point5d_to_steps_fixed(const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count, Point2d *excess)
+{
+    size_t n;
+    for(n = 0; n < count; n++) {
+        steps[n].x = steps_fixed(steps_per_mm->x, mm[n].x);
+        steps[n].y = steps_fixed(steps_per_mm->y, mm[n].y);
+        steps[n].z = steps_fixed(steps_per_mm->z, mm[n].z);
+        if(excess) {
+            steps[n].a = fixed_carry(fixed_fractions(steps_per_mm->a, mm[n].a), &excess->a);
+            steps[n].b = fixed_carry(fixed_fractions(steps_per_mm->b, mm[n].b), &excess->b);
+        }
+        else {
+            steps[n].a = steps_fixed(steps_per_mm->a, mm[n].a);
+            steps[n].b = steps_fixed(steps_per_mm->b, mm[n].b);
+        }
+    }
+}
+
+void point5d_delta_steps_fixed(int flag, const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count)
+{
+    size_t n;
+    for(n = 0; n < count; n++) {
+        steps[n].x = flag & X_IS_SET ? steps_fixed(steps_per_mm->x, fabs(mm[n].x)) : 0;
+        steps[n].y = flag & Y_IS_SET ? steps_fixed(steps_per_mm->y, fabs(mm[n].y)) : 0;
+        steps[n].z = flag & Z_IS_SET ? steps_fixed(steps_per_mm->z, fabs(mm[n].z)) : 0;
+        steps[n].a = flag & A_IS_SET ? steps_fixed(steps_per_mm->a, fabs(mm[n].a)) : 0;
+        steps[n].b = flag & B_IS_SET ? steps_fixed(steps_per_mm->b, fabs(mm[n].b)) : 0;
+    }
+}
@@ -0,0 +1,85 @@
+//  kinematics.h
+//
+//  Branch free 5D vector arithmetic for the move conversion
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#ifndef __kinematics_h__
+#define __kinematics_h__
+
+#include <stddef.h>
+
+#include "gpx.h"
+
+// a Point5d is worked on as 8 double lanes, x y z a b in lanes 0 to 4 and
+// zero padding, so it fills whole registers of 2, 4 or 8 lanes.  The axes
+// missing from a command flag are masked to zero rather than branched around.
+
+#define AXIS_LANES 8
+
+// every result matches the axis by axis code it replaced bit for bit, sums
+// are accumulated x to b and steps are rounded half away from zero as round()
+
+// the length of the vector over the axes set in flag
+double point5d_magnitude(int flag, const Point5d *v);
+
+// the largest absolute value of the axes set in flag
+double point5d_largest_axis(int flag, const Point5d *v);
+
+// to - from for the axes set in flag, the a and b deltas are scaled by
+// percent[0] and percent[1] / 100, the other axes are zero
+Point5d point5d_delta(int flag, const Point5d *to, const Point5d *from, const unsigned percent[2]);
+
+// BATCH CONVERSION
+
+// convert count points from mm to steps, when excess is given the a and b
+// rounding remainders carry from each point to the next, exactly as count
+// calls converting one point at a time would
+void point5d_to_steps(const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count, Point2d *excess);
+
+// the absolute step counts of count mm deltas, the axes not set in flag are
+// zero
+void point5d_delta_steps(int flag, const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count);
+
+// FIXED POINT CONVERSION
+
+// whole steps are rounded in integer arithmetic from the same product the
+// double path rounds, so they match it exactly.  Where the a and b remainder
+// is carried between points, each mm value is instead taken to the nearest
+// step fraction of 1 / 2^STEP_FRACTION_BITS with one multiplication and the
+// carry is exact integer arithmetic, held in excess as step fractions.
+// Positions must stay below 2^33 steps.
+
+#define STEP_FRACTION_BITS 30
+
+double steps_fixed(double steps_per_mm, double mm);
+void point5d_to_steps_fixed(const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count, Point2d *excess);
+void point5d_delta_steps_fixed(int flag, const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count);
+
+// the individual implementations the batch conversions choose between
+void point5d_to_steps_scalar(const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count, Point2d *excess);
+void point5d_delta_steps_scalar(int flag, const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count);
+#if defined(__GNUC__) && defined(__SSE2__)
+#define HAVE_KINEMATICS_SSE2 1
+#if defined(__x86_64__) || defined(__i386__)
+#define HAVE_KINEMATICS_SSE41 1
+void point5d_to_steps_sse41(const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count, Point2d *excess);
+void point5d_delta_steps_sse41(int flag, const Point5d *steps_per_mm, const Point5d *mm, Point5d *steps, size_t count);
+#endif
+#endif
+
+#endif /* __kinematics_h__ */
@@ -0,0 +1,225 @@
+//
+//  libgpx.h
+//
+//  Public interface to the gcode to x3g translator for programs that link
+//  libgpx rather than run the gpx command.  Gpx is opaque here, everything
+//  a conversion needs (machine, state, translation and statistics) lives in
+//  the context returned by gpx_create, so separate threads may each convert
+//  with their own context at the same time.  A single context must only be
+//  used by one thread at a time.
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//  Much of the interface was declared in gpx.h,
+//  Copyright (c) 2013 WHPThomas.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#ifndef __libgpx_h__
+#define __libgpx_h__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+
+#define END_OF_FILE 1
+#define SUCCESS 0
+#define ERROR -1
+
+#define ESIOWRITE -2
+#define ESIOREAD -3
+#define ESIOFRAME -4
+#define ESIOCRC -5
+// EOSERROR means error code is in errno
+#define EOSERROR -6
+#define ESIOTIMEOUT -7
+#define ESIOBADBAUD -8
+
+// Item codes for passing control options
+#define ITEM_FRAMING_ENABLE 1
+#define ITEM_FRAMING_DISABLE 2
+
+// the words of a GpxMove, for its flag
+
+#define GPX_MOVE_X 0x1
+#define GPX_MOVE_Y 0x2
+#define GPX_MOVE_Z 0x4
+#define GPX_MOVE_A 0x8
+#define GPX_MOVE_B 0x10
+#define GPX_MOVE_E 0x20
+#define GPX_MOVE_F 0x40
+#define GPX_MOVE_I 0x80
+#define GPX_MOVE_P 0x100
+#define GPX_MOVE_J 0x200
+#define GPX_MOVE_R 0x400
+#define GPX_MOVE_S 0x800
+#define GPX_MOVE_G 0x1000
+#define GPX_MOVE_M 0x2000
+#define GPX_MOVE_T 0x4000
+
+    // GPX CONTEXT
+
+    typedef struct tGpx Gpx;
+
+    Gpx *gpx_create(void);
+    Gpx *gpx_clone(const Gpx *gpx);
+    void gpx_destroy(Gpx *gpx);
+
+    int gpx_set_machine(Gpx *gpx, const char *machine, int init);
+    int gpx_set_property(Gpx *gpx, const char* section, const char* property, char* value);
+    int gpx_load_config(Gpx *gpx, const char *filename);
+
+    void gpx_register_callback(Gpx *gpx, int (*callbackHandler)(Gpx *gpx, void *callbackData, char *buffer, size_t length), void *callbackData);
+
+    void gpx_start_convert(Gpx *gpx, char *buildName, int item_code, ...);
+    int gpx_convert_line(Gpx *gpx, char *gcode_line);
+    int gpx_convert(Gpx *gpx, FILE *file_in, FILE *file_out, FILE *file_out2);
+    // converts any moves still held back for merging, returns the status of
+    // doing so
+    int gpx_end_convert(Gpx *gpx);
+
+    // total up the conversion as gpx_convert would without writing any x3g,
+    // gpx_get_totals then returns them
+    int gpx_estimate(Gpx *gpx, FILE *file_in);
+
+    // the totals of the last conversion or estimate, the filament length in
+    // mm, build time in seconds, x3g bytes and commands.  Any of the pointers
+    // may be NULL.
+    void gpx_get_totals(Gpx *gpx, double *length, double *time, unsigned long *bytes, unsigned long *commands);
+
+    // gpx_convert reads the gcode ahead and writes the x3g behind on threads
+    // of their own where there are threads, disable to convert on the
+    // calling thread alone.  The x3g is the same either way.
+    void gpx_set_pipeline(Gpx *gpx, int enable);
+
+    // keep the x3g of each conversion of a file by gpx_convert in dir, a later
+    // conversion of the same gcode with the same settings copies it rather
+    // than converting it again.  Beyond size bytes the least recently used
+    // are removed.  NULL for dir keeps nothing.  Returns ERROR if out of
+    // memory.
+    int gpx_set_cache(Gpx *gpx, const char *dir, unsigned long long size);
+
+    // gpx_convert also keeps checkpoints of the conversion state in the
+    // cache, so a later conversion of an edited file copies the x3g of the
+    // gcode before and after the edit rather than converting it again.  The
+    // x3g is the same either way, though the messages of the gcode copied
+    // aren't repeated.  Takes precedence over gpx_set_parallel.
+    void gpx_set_checkpoints(Gpx *gpx, int enable);
+
+    // check the x3g of every entry of the cache in dir against the hash it
+    // was kept with, removing any that don't match and logging them to log.
+    // Returns the number removed or ERROR if dir can't be read.
+    int gpx_verify_cache(const char *dir, FILE *log);
+
+    // gpx_convert converts a file it can map in chunks on up to threads
+    // threads, 0 or 1 converts it on the calling thread.  The x3g is the same
+    // either way.
+    void gpx_set_parallel(Gpx *gpx, unsigned threads);
+
+    // gpx_convert gzips the x3g it writes at level 1 to 9, 0 writes it as it
+    // is.  Gzipped gcode is inflated as it's read regardless.  Returns ERROR
+    // for a level out of range or if GPX was built without zlib.
+    int gpx_set_compression(Gpx *gpx, int level);
+
+    // MOVE STREAM
+
+    // a line of gcode as data, for programs that hold their moves already
+    // parsed.  flag has the GPX_MOVE_ bit of each word the line would have,
+    // the other fields are ignored.  comment may be NULL, one starting with
+    // @ is run as a macro and for M23 and M28 it is the filename.
+    typedef struct tGpxMove {
+        double x;
+        double y;
+        double z;
+        double a;
+        double b;
+
+        double e;
+        double f;
+
+        double i;
+        double j;
+
+        double p;
+        double r;
+        double s;
+
+        unsigned g;
+        unsigned m;
+        unsigned t;
+
+        int flag;
+
+        const char *comment;
+    } GpxMove;
+
+    // convert moves exactly as gpx_convert_line would convert the same
+    // lines, between gpx_start_convert and gpx_end_convert.  A batch stops
+    // at the first move that doesn't return SUCCESS and returns its result,
+    // converted (if not NULL) is set to the number of moves before it, so
+    // the batch can be picked up again from there.
+    int gpx_convert_move(Gpx *gpx, const GpxMove *move);
+    int gpx_convert_moves(Gpx *gpx, const GpxMove *moves, size_t count, size_t *converted);
+
+    void gpx_set_preamble(Gpx *gpx, const char *preamble);
+    void gpx_set_start(Gpx *gpx, int head);
+    void gpx_set_end(Gpx *gpx, int tail);
+
+    void gpx_list_machines(FILE *fp);
+
+    // TIME ESTIMATE
+
+    // estimate the build time by simulating the firmware planner over a
+    // lookahead of window moves rather than the flat acceleration allowance,
+    // a window of 0 restores the allowance
+    void gpx_set_planner(Gpx *gpx, int window);
+
+    // LAYER INDEX
+
+    // keep an index of where each layer starts in the x3g while converting,
+    // a layer starts with the move to the Z of the first move extruding
+    // above the layers before it.  Returns ERROR if out of memory.
+    int gpx_set_layer_index(Gpx *gpx, int enable);
+
+    // write the index of the last conversion as text, a line for each layer
+    // of its number, Z, byte offset, the seconds of the build and the mm of
+    // filament before it, then a line of the totals
+    int gpx_write_layer_index(Gpx *gpx, FILE *fp);
+
+    // RESUME
+
+    // convert from the first move to z or above, or from line, with neither
+    // set (0) the whole gcode is converted.  The gcode before is followed
+    // without any x3g, the output starts by restoring the position, heaters
+    // and tool there after lifting the nozzle hop mm clear of the print.
+    void gpx_set_resume(Gpx *gpx, double z, unsigned line, double hop);
+
+    // PROFILING
+
+#define PROFILE_OFF 0
+#define PROFILE_TABLE 1
+#define PROFILE_JSON 2
+
+    // time each phase of the conversion, the results are written to the log
+    // by gpx_end_convert in the given format
+    int gpx_set_profile(Gpx *gpx, int format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __libgpx_h__ */
@@ -0,0 +1,386 @@
+//  pipeline.c
+//
+//  Read-ahead, write-behind and worker threads for converting files
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pipeline.h"
+
+#ifdef HAVE_PIPELINE
+
+// QUEUE
+
+static void spsc_init(Spsc *q)
+{
+    q->head = q->tail = 0;
+    q->sleeping = 0;
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->wake, NULL);
+}
+
+static void spsc_destroy(Spsc *q)
+{
+    pthread_mutex_destroy(&q->lock);
+    pthread_cond_destroy(&q->wake);
+}
+
+// the block is published by the store to tail, a consumer that found the
+// ring empty has said so in sleeping before looking at tail a last time, so
+// one of the two sees the other
+
+static void spsc_push(Spsc *q, Block *block)
+{
+    unsigned tail = q->tail;
+    q->slot[tail % PIPELINE_BLOCKS] = block;
+    __atomic_store_n(&q->tail, tail + 1, __ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&q->sleeping, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&q->lock);
+        pthread_cond_signal(&q->wake);
+        pthread_mutex_unlock(&q->lock);
+    }
+}
+
+static Block *spsc_pop(Spsc *q)
+{
+    unsigned head = q->head;
+    Block *block;
+    if(__atomic_load_n(&q->tail, __ATOMIC_ACQUIRE) == head) {
+        pthread_mutex_lock(&q->lock);
+        __atomic_store_n(&q->sleeping, 1, __ATOMIC_SEQ_CST);
+        while(__atomic_load_n(&q->tail, __ATOMIC_SEQ_CST) == head) {
+            pthread_cond_wait(&q->wake, &q->lock);
+        }
+        __atomic_store_n(&q->sleeping, 0, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&q->lock);
+    }
+    block = q->slot[head % PIPELINE_BLOCKS];
+    __atomic_store_n(&q->head, head + 1, __ATOMIC_RELEASE);
+    return block;
+}
+
+// STAGE
+
+static void stage_free(Stage *stage)
+{
+    int i;
+    for(i = 0; i < PIPELINE_BLOCKS; i++) {
+        free(stage->block[i].data);
+    }
+    spsc_destroy(&stage->full);
+    spsc_destroy(&stage->free);
+    stage->started = 0;
+}
+
+static int stage_init(Stage *stage)
+{
+    int i;
+    memset(stage, 0, sizeof(Stage));
+    spsc_init(&stage->full);
+    spsc_init(&stage->free);
+    for(i = 0; i < PIPELINE_BLOCKS; i++) {
+        stage->block[i].data = malloc(PIPELINE_BLOCK_SIZE);
+        if(stage->block[i].data == NULL) {
+            stage_free(stage);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int stage_error(Stage *stage)
+{
+    return __atomic_load_n(&stage->error, __ATOMIC_ACQUIRE);
+}
+
+static void stage_fail(Stage *stage)
+{
+    __atomic_store_n(&stage->error, errno ? errno : EIO, __ATOMIC_RELEASE);
+}
+
+// READ AHEAD
+
+static void *read_ahead_run(void *arg)
+{
+    ReadAhead *ra = arg;
+    for(;;) {
+        Block *block = spsc_pop(&ra->stage.free);
+        block->length = 0;
+        block->last = 1;
+        if(!__atomic_load_n(&ra->stage.stop, __ATOMIC_ACQUIRE)) {
+            long n = ra->read(ra->ctx, block->data, PIPELINE_BLOCK_SIZE);
+            if(n == PIPELINE_BLOCK_SIZE) {
+                block->last = 0;
+            }
+            else if(n < 0) {
+                stage_fail(&ra->stage);
+            }
+            if(n > 0) block->length = (size_t)n;
+        }
+        spsc_push(&ra->stage.full, block);
+        if(block->last) return NULL;
+    }
+}
+
+int read_ahead_start(ReadAhead *ra, ReadProc read, void *ctx)
+{
+    int i;
+    ra->read = read;
+    ra->ctx = ctx;
+    ra->current = NULL;
+    ra->pos = 0;
+    ra->consumed = 0;
+    if(stage_init(&ra->stage)) return -1;
+    for(i = 0; i < PIPELINE_BLOCKS; i++) {
+        spsc_push(&ra->stage.free, ra->stage.block + i);
+    }
+    if(pthread_create(&ra->stage.thread, NULL, read_ahead_run, ra)) {
+        stage_free(&ra->stage);
+        return -1;
+    }
+    ra->stage.started = 1;
+    return 0;
+}
+
+long read_ahead_line(ReadAhead *ra, char *buffer, size_t size)
+{
+    size_t n = 0;
+    while(n + 1 < size) {
+        Block *block = ra->current;
+        if(block == NULL) {
+            block = ra->current = spsc_pop(&ra->stage.full);
+            ra->pos = 0;
+        }
+        if(ra->pos == block->length) {
+            // the last block is kept so every read after it is at the end
+            if(block->last) break;
+            spsc_push(&ra->stage.free, block);
+            ra->current = NULL;
+            continue;
+        }
+        char *line = block->data + ra->pos;
+        size_t length = block->length - ra->pos;
+        if(length > size - 1 - n) length = size - 1 - n;
+        char *eol = memchr(line, '\n', length);
+        if(eol) length = eol - line + 1;
+        memcpy(buffer + n, line, length);
+        n += length;
+        ra->pos += length;
+        if(eol) break;
+    }
+    buffer[n] = 0;
+    ra->consumed += n;
+    if(n == 0 && stage_error(&ra->stage)) return -1;
+    return (long)n;
+}
+
+void read_ahead_stop(ReadAhead *ra)
+{
+    Block *block = ra->current;
+    if(!ra->stage.started) return;
+    __atomic_store_n(&ra->stage.stop, 1, __ATOMIC_RELEASE);
+    // hand back every block until the reader sends its last
+    while(block == NULL || !block->last) {
+        if(block) spsc_push(&ra->stage.free, block);
+        block = spsc_pop(&ra->stage.full);
+    }
+    pthread_join(ra->stage.thread, NULL);
+    ra->current = NULL;
+    stage_free(&ra->stage);
+}
+
+// WRITE BEHIND
+
+static void *write_behind_run(void *arg)
+{
+    WriteBehind *wb = arg;
+    for(;;) {
+        Block *block = spsc_pop(&wb->stage.full);
+        int last = block->last;
+        // after a failure the rest is only handed back
+        if(block->length && !stage_error(&wb->stage)
+           && wb->write(wb->ctx, block->data, block->length)) {
+            stage_fail(&wb->stage);
+        }
+        spsc_push(&wb->stage.free, block);
+        if(last) return NULL;
+    }
+}
+
+int write_behind_start(WriteBehind *wb, WriteProc write, void *ctx)
+{
+    int i;
+    wb->write = write;
+    wb->ctx = ctx;
+    wb->current = NULL;
+    if(stage_init(&wb->stage)) return -1;
+    for(i = 0; i < PIPELINE_BLOCKS; i++) {
+        wb->spare[i] = wb->stage.block + i;
+    }
+    wb->spares = PIPELINE_BLOCKS;
+    if(pthread_create(&wb->stage.thread, NULL, write_behind_run, wb)) {
+        stage_free(&wb->stage);
+        return -1;
+    }
+    wb->stage.started = 1;
+    return 0;
+}
+
+// a spare block or the next back from the writer
+
+static Block *write_behind_block(WriteBehind *wb)
+{
+    Block *block = wb->spares ? wb->spare[--wb->spares] : spsc_pop(&wb->stage.free);
+    block->length = 0;
+    block->last = 0;
+    return block;
+}
+
+int write_behind_append(WriteBehind *wb, const char *data, size_t length)
+{
+    while(length) {
+        Block *block = wb->current;
+        if(block == NULL) block = wb->current = write_behind_block(wb);
+        size_t n = PIPELINE_BLOCK_SIZE - block->length;
+        if(n > length) n = length;
+        memcpy(block->data + block->length, data, n);
+        block->length += n;
+        data += n;
+        length -= n;
+        if(block->length == PIPELINE_BLOCK_SIZE) {
+            spsc_push(&wb->stage.full, block);
+            wb->current = NULL;
+        }
+    }
+    return stage_error(&wb->stage) ? -1 : 0;
+}
+
+int write_behind_sync(WriteBehind *wb)
+{
+    if(wb->current) {
+        spsc_push(&wb->stage.full, wb->current);
+        wb->current = NULL;
+    }
+    while(wb->spares < PIPELINE_BLOCKS) {
+        wb->spare[wb->spares++] = spsc_pop(&wb->stage.free);
+    }
+    return stage_error(&wb->stage) ? -1 : 0;
+}
+
+int write_behind_stop(WriteBehind *wb)
+{
+    int rval;
+    Block *block;
+    if(!wb->stage.started) return 0;
+    rval = write_behind_sync(wb);
+    block = write_behind_block(wb);
+    block->last = 1;
+    spsc_push(&wb->stage.full, block);
+    pthread_join(wb->stage.thread, NULL);
+    stage_free(&wb->stage);
+    return rval;
+}
+
+// WORKERS
+
+static void *workers_run(void *arg)
+{
+    Workers *w = arg;
+    pthread_mutex_lock(&w->lock);
+    for(;;) {
+        if(w->next < w->items) {
+            void *item = w->item[w->next++];
+            pthread_mutex_unlock(&w->lock);
+            w->work(item);
+            pthread_mutex_lock(&w->lock);
+        }
+        else if(w->finishing) {
+            break;
+        }
+        else {
+            pthread_cond_wait(&w->ready, &w->lock);
+        }
+    }
+    pthread_mutex_unlock(&w->lock);
+    return NULL;
+}
+
+int workers_start(Workers *w, int threads, WorkProc work)
+{
+    memset(w, 0, sizeof(Workers));
+    w->work = work;
+    if(threads < 1) threads = 1;
+    w->thread = malloc(threads * sizeof(pthread_t));
+    if(w->thread == NULL) return -1;
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->ready, NULL);
+    while(w->threads < threads) {
+        if(pthread_create(w->thread + w->threads, NULL, workers_run, w)) break;
+        w->threads++;
+    }
+    if(w->threads == 0) {
+        pthread_mutex_destroy(&w->lock);
+        pthread_cond_destroy(&w->ready);
+        free(w->thread);
+        return -1;
+    }
+    return w->threads;
+}
+
+int workers_add(Workers *w, void *item)
+{
+    int rval = 0;
+    pthread_mutex_lock(&w->lock);
+    if(w->items == w->size) {
+        unsigned size = w->size ? w->size * 2 : 64;
+        void **grown = realloc(w->item, size * sizeof(void *));
+        if(grown) {
+            w->item = grown;
+            w->size = size;
+        }
+    }
+    if(w->items < w->size) {
+        w->item[w->items++] = item;
+        pthread_cond_signal(&w->ready);
+    }
+    else {
+        rval = -1;
+    }
+    pthread_mutex_unlock(&w->lock);
+    return rval;
+}
+
+void workers_finish(Workers *w)
+{
+    int i;
+    pthread_mutex_lock(&w->lock);
+    w->finishing = 1;
+    pthread_cond_broadcast(&w->ready);
+    pthread_mutex_unlock(&w->lock);
+    for(i = 0; i < w->threads; i++) {
+        pthread_join(w->thread[i], NULL);
+    }
+    pthread_mutex_destroy(&w->lock);
+    pthread_cond_destroy(&w->ready);
+    free(w->thread);
+    free(w->item);
+}
+
+#endif // HAVE_PIPELINE
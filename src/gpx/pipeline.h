@@ -0,0 +1,161 @@
+//  pipeline.h
+//
+//  Read-ahead, write-behind and worker threads for converting files
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#ifndef __pipeline_h__
+#define __pipeline_h__
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "config.h"
+
+// the conversion reads, converts and writes on three threads, the gcode is
+// read ahead a block at a time and the x3g written behind a block at a time.
+// Blocks are handed between two threads through single producer, single
+// consumer queues that only take a lock to sleep on when empty.
+
+#if defined(HAVE_PTHREAD_H) && defined(__GNUC__)
+#define HAVE_PIPELINE 1
+#endif
+
+#ifdef HAVE_PIPELINE
+
+#include <pthread.h>
+
+#define PIPELINE_BLOCK_SIZE 65536
+#define PIPELINE_BLOCKS 4       // in flight in each direction, a power of 2
+
+typedef struct tBlock {
+    char *data;
+    size_t length;
+    int last;                   // nothing follows, the end of the input or the writer
+} Block;
+
+// a ring of PIPELINE_BLOCKS, head is only moved by the consumer and tail by
+// the producer.  A stage only has PIPELINE_BLOCKS so the ring can't overflow
+// and only the consumer ever waits.
+
+typedef struct tSpsc {
+    Block *slot[PIPELINE_BLOCKS];
+    unsigned head;
+    unsigned tail;
+    int sleeping;               // a thread waits on wake for the ring to change
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+} Spsc;
+
+// a thread and the blocks going to it in full and coming back from it free
+
+typedef struct tStage {
+    pthread_t thread;
+    Spsc full;
+    Spsc free;
+    Block block[PIPELINE_BLOCKS];
+    int started;
+    int error;                  // errno of a failed read or write, 0 for none
+    int stop;                   // the reader is to stop early
+} Stage;
+
+// READ AHEAD
+
+// read up to length bytes, returns the number read, short only at the end of
+// the input, or -1 on a read error
+typedef long (*ReadProc)(void *ctx, char *data, size_t length);
+
+typedef struct tReadAhead {
+    Stage stage;
+    ReadProc read;
+    void *ctx;
+    Block *current;             // being split into lines
+    size_t pos;
+    unsigned long consumed;     // bytes taken as lines
+} ReadAhead;
+
+// start reading through read on a thread, returns -1 if it couldn't be
+// started
+int read_ahead_start(ReadAhead *ra, ReadProc read, void *ctx);
+
+// the next line into buffer, at most size - 1 characters split as fgets
+// would.  Returns the length, 0 at the end of the input and -1 on a read
+// error.
+long read_ahead_line(ReadAhead *ra, char *buffer, size_t size);
+
+// stop the thread, the input is left wherever the reading stopped
+void read_ahead_stop(ReadAhead *ra);
+
+// WRITE BEHIND
+
+typedef int (*WriteProc)(void *ctx, char *data, size_t length);
+
+typedef struct tWriteBehind {
+    Stage stage;
+    WriteProc write;
+    void *ctx;
+    Block *current;             // being filled
+    Block *spare[PIPELINE_BLOCKS]; // back from the writer
+    unsigned spares;
+} WriteBehind;
+
+// start writing through write on a thread, returns -1 if it couldn't be
+// started
+int write_behind_start(WriteBehind *wb, WriteProc write, void *ctx);
+
+// append data, a full block goes to the writer, returns -1 if a write failed
+int write_behind_append(WriteBehind *wb, const char *data, size_t length);
+
+// wait for everything appended to be written, returns -1 if a write failed
+int write_behind_sync(WriteBehind *wb);
+
+// sync and stop the thread
+int write_behind_stop(WriteBehind *wb);
+
+// WORKERS
+
+// a pool of threads each taking the next item added and passing it to work,
+// items are started in the order they were added
+
+typedef void (*WorkProc)(void *item);
+
+typedef struct tWorkers {
+    pthread_t *thread;
+    int threads;
+    WorkProc work;
+    void **item;
+    unsigned items;
+    unsigned next;              // the next item to start
+    unsigned size;
+    int finishing;              // no more items are coming
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+} Workers;
+
+// start up to threads threads, returns the number started or -1 if none
+// could be
+int workers_start(Workers *w, int threads, WorkProc work);
+
+// queue item for the next thread free, returns -1 if out of memory
+int workers_add(Workers *w, void *item);
+
+// wait for every item added to be worked and stop the threads
+void workers_finish(Workers *w);
+
+#endif // HAVE_PIPELINE
+
+#endif /* __pipeline_h__ */
@@ -0,0 +1,168 @@
+//  planner.c
+//
+//  Lookahead motion planner simulation for the build time estimate
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <math.h>
+
+#include "planner.h"
+
+// an axis moving less than this per mm of the move is taken as still
+
+#define UNIT_EPSILON 1E-9
+
+#define AXES 5
+
+// the ring holds count moves from head, wrapping at PLANNER_WINDOW_MAX
+
+#define SEGMENT(planner, i) ((planner)->segment + ((planner)->head + (i)) % PLANNER_WINDOW_MAX)
+
+void planner_stop(Planner *planner)
+{
+    planner->count = 0;
+}
+
+// the fastest speed reachable from speed v accelerating over the whole move
+
+static double reachable(const Segment *s, double v)
+{
+    if(s->acceleration <= 0.0) return HUGE_VAL;
+    return sqrt(v * v + 2.0 * s->acceleration * s->length);
+}
+
+// the seconds a move takes entering at v0 and leaving at v1, accelerating
+// toward the nominal speed and cruising if there is the length for it
+
+static double segment_time(const Segment *s, double v0, double v1)
+{
+    double vn = s->nominal;
+    double a = s->acceleration;
+    if(a <= 0.0) return s->length / vn;
+    if(v0 > vn) v0 = vn;
+    if(v1 > vn) v1 = vn;
+    double accelerating = (vn * vn - v0 * v0) / (2.0 * a);
+    double decelerating = (vn * vn - v1 * v1) / (2.0 * a);
+    double cruising = s->length - accelerating - decelerating;
+    if(cruising >= 0.0) {
+        return (vn - v0) / a + (vn - v1) / a + cruising / vn;
+    }
+    // a triangle, the peak speed is where acceleration and deceleration meet
+    double peak = sqrt((2.0 * a * s->length + v0 * v0 + v1 * v1) / 2.0);
+    if(peak < v0) peak = v0;
+    if(peak < v1) peak = v1;
+    return (peak - v0) / a + (peak - v1) / a;
+}
+
+double planner_add(Planner *planner, const Machine *machine, const Point5d *delta, double length, double feedrate)
+{
+    const double accel[AXES] = {
+        machine->x.max_accel, machine->y.max_accel, machine->z.max_accel,
+        machine->a.max_accel, machine->b.max_accel
+    };
+    const double jerk[AXES] = {
+        machine->x.max_speed_change, machine->y.max_speed_change, machine->z.max_speed_change,
+        machine->a.max_speed_change, machine->b.max_speed_change
+    };
+    const double *travel = &delta->x;
+    double booked = 0.0;
+    unsigned i;
+    int k;
+
+    if(length <= 0.0 || feedrate <= 0.0) return 0.0;
+
+    // the window is full, the oldest move is executing and can't be replanned,
+    // nor can the exit speed it was given
+    if(planner->count >= planner->window) {
+        planner->head = (planner->head + 1) % PLANNER_WINDOW_MAX;
+        planner->count--;
+        if(planner->count) {
+            Segment *head = SEGMENT(planner, 0);
+            if(head->entry < head->max_entry) head->max_entry = head->entry;
+        }
+    }
+
+    const Segment *previous = planner->count ? SEGMENT(planner, planner->count - 1) : NULL;
+    Segment *s = SEGMENT(planner, planner->count);
+    double *unit = &s->unit.x;
+    double entry;
+
+    s->length = length;
+    s->nominal = feedrate;
+    s->acceleration = 0.0;
+    s->time = 0.0;
+
+    // the acceleration along the move that keeps every axis within its limit
+    for(k = 0; k < AXES; k++) {
+        unit[k] = travel[k] / length;
+        double u = fabs(unit[k]);
+        if(u > UNIT_EPSILON && accel[k] > 0.0) {
+            double a = accel[k] / u;
+            if(s->acceleration <= 0.0 || a < s->acceleration) s->acceleration = a;
+        }
+    }
+
+    // the junction speed, no axis may change speed by more than its
+    // max_speed_change on the way in, from a standstill or the previous move
+    entry = feedrate;
+    if(previous && previous->nominal < entry) entry = previous->nominal;
+    for(k = 0; k < AXES; k++) {
+        double change = fabs(unit[k] - (previous ? (&previous->unit.x)[k] : 0.0));
+        if(change > UNIT_EPSILON && change * entry > jerk[k]) {
+            entry = jerk[k] > 0.0 ? jerk[k] / change : 0.0;
+        }
+    }
+    s->max_entry = entry;
+    planner->count++;
+
+    // backward pass, each move must be able to slow down to the entry of
+    // the next and the last move ends at rest.  Once a move's bound is
+    // unchanged, the bounds before it are too.
+    unsigned first = planner->count - 1;
+    double exit = 0.0;
+    for(i = planner->count; i-- > 0;) {
+        Segment *seg = SEGMENT(planner, i);
+        double v = reachable(seg, exit);
+        if(v > seg->max_entry) v = seg->max_entry;
+        if(i < first && v == seg->bound) break;
+        seg->bound = v;
+        first = i;
+        exit = v;
+    }
+
+    // forward pass, each move must be able to reach the entry of the next
+    for(i = first; i < planner->count; i++) {
+        Segment *seg = SEGMENT(planner, i);
+        double v = seg->bound;
+        if(i) {
+            Segment *prev = SEGMENT(planner, i - 1);
+            double r = reachable(prev, prev->entry);
+            if(r < v) v = r;
+        }
+        seg->entry = v;
+    }
+
+    // rebook the moves whose entry or exit changed
+    for(i = first ? first - 1 : 0; i < planner->count; i++) {
+        Segment *seg = SEGMENT(planner, i);
+        double v1 = i + 1 < planner->count ? SEGMENT(planner, i + 1)->entry : 0.0;
+        double t = segment_time(seg, seg->entry, v1);
+        booked += t - seg->time;
+        seg->time = t;
+    }
+    return booked;
+}
@@ -0,0 +1,40 @@
+//  planner.h
+//
+//  Lookahead motion planner simulation for the build time estimate
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#ifndef __planner_h__
+#define __planner_h__
+
+#include "gpx.h"
+
+// the planner follows the firmware: every move accelerates and decelerates
+// at the most its axes allow, the speed across a junction is limited by the
+// max_speed_change of each axis and the last move in the window is planned
+// to end at rest.  The seconds booked for a move are revised as later moves
+// arrive, until it drops out of the window.
+
+// the machine comes to rest, the next move starts from a standstill
+void planner_stop(Planner *planner);
+
+// plan a move of length mm at feedrate mm/s, delta holds the signed travel
+// of each axis in mm.  Returns the change to the seconds booked for the moves
+// in the window, to be added to the accumulated time.
+double planner_add(Planner *planner, const Machine *machine, const Point5d *delta, double length, double feedrate);
+
+#endif /* __planner_h__ */
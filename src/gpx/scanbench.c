@@ -0,0 +1,303 @@
+//  scanbench.c
+//
+//  Microbenchmark for the gcode lexer, times tokenizing the lines of one or
+//  more gcode files with the previous ctype/strtod lexer and with the table
+//  driven lexer using each of the scan_stop implementations
+//
+//  usage: scanbench [-n REPEAT] FILE...
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "scanner.h"
+
+#define BUFFER_MAX 1023
+
+// what a lexer found on a line, summed so the lexers can be compared and
+// the work can't be optimized away
+
+typedef struct tTally {
+    double values;
+    long integers;
+    long words;
+    long comments;
+    long commentBytes;
+} Tally;
+
+// PREVIOUS LEXER
+
+static char *normalize_word(char* p)
+{
+    char *s = p + 1;
+    char *e = p;
+    while(isspace(*s)) s++;
+    if(*s == '+' || *s == '-') {
+        *e++ = *s++;
+    }
+    while(1) {
+        if(isspace(*s)) {
+            s++;
+        }
+        else if(isdigit(*s)) {
+            *e++ = *s++;
+        }
+        else {
+            break;
+        }
+    }
+    if(*s == '.') {
+        *e++ = *s++;
+        while(1) {
+            if(isspace(*s)) {
+                s++;
+            }
+            else if(isdigit(*s)) {
+                *e++ = *s++;
+            }
+            else {
+                break;
+            }
+        }
+    }
+    *e = 0;
+    return s;
+}
+
+static char *normalize_comment(char *p)
+{
+    char *e = p + strlen(p);
+    while (e > p && isspace((unsigned char)(*--e))) *e = '\0';
+    while(isspace(*p)) p++;
+    return p;
+}
+
+static void comment(Tally *tally, char *comment)
+{
+    tally->comments++;
+    tally->commentBytes += (long)strlen(comment);
+}
+
+static void lex_ctype(char *p, Tally *tally)
+{
+    while(isspace(*p)) p++;
+    while(*p != 0) {
+        if(isalpha(*p)) {
+            int c = *p;
+            char *digits = p;
+            p = normalize_word(p);
+            tally->words++;
+            if(c == 'G' || c == 'M' || c == 'T' || c == 'N') {
+                tally->integers += atoi(digits);
+            }
+            else {
+                tally->values += strtod(digits, NULL);
+            }
+        }
+        else if(*p == ';') {
+            comment(tally, normalize_comment(p + 1));
+            break;
+        }
+        else if(*p == '(') {
+            char *s = strchr(p + 1, '(');
+            char *e = strchr(p + 1, ')');
+            if(s && e && s < e) {
+                e = strrchr(p + 1, ')');
+            }
+            if(e) {
+                *e = 0;
+                comment(tally, normalize_comment(p + 1));
+                p = e + 1;
+            }
+            else {
+                comment(tally, normalize_comment(p + 1));
+                break;
+            }
+        }
+        else {
+            break;
+        }
+    }
+}
+
+// TABLE DRIVEN LEXER
+
+static char *trim_comment(char *p, char *e)
+{
+    while (e > p && IS_SPACE(*--e)) *e = '\0';
+    while(IS_SPACE(*p)) p++;
+    return p;
+}
+
+static void lex_table(char *p, Tally *tally, char *(*scan)(const char *))
+{
+    double value;
+    int integer;
+    while(IS_SPACE(*p)) p++;
+    while(*p != 0) {
+        if(IS_ALPHA(*p)) {
+            int c = *p;
+            p = scan_word(p, &value, &integer);
+            tally->words++;
+            if(c == 'G' || c == 'M' || c == 'T' || c == 'N') {
+                tally->integers += integer;
+            }
+            else {
+                tally->values += value;
+            }
+        }
+        else if(*p == ';') {
+            comment(tally, trim_comment(p + 1, p + 1 + strlen(p + 1)));
+            break;
+        }
+        else if(*p == '(') {
+            char *e = p + 1;
+            int nested = 0;
+            while(*(e = scan(e)) && *e != ')') {
+                if(*e == '(') nested = 1;
+                e++;
+            }
+            if(*e && nested) e = strrchr(e, ')');
+            if(*e) {
+                *e = 0;
+                comment(tally, trim_comment(p + 1, e));
+                p = e + 1;
+            }
+            else {
+                comment(tally, trim_comment(p + 1, e));
+                break;
+            }
+        }
+        else {
+            break;
+        }
+    }
+}
+
+// BENCHMARK
+
+static char **lines;
+static long lineCount;
+static long byteCount;
+
+static void load(const char *filename)
+{
+    static long size;
+    char buffer[BUFFER_MAX + 1];
+    FILE *in = fopen(filename, "r");
+    if(in == NULL) {
+        perror(filename);
+        exit(1);
+    }
+    while(fgets(buffer, sizeof(buffer), in)) {
+        if(lineCount == size) {
+            size = size ? size * 2 : 4096;
+            lines = realloc(lines, size * sizeof(char *));
+            if(lines == NULL) {
+                perror("realloc");
+                exit(1);
+            }
+        }
+        byteCount += (long)strlen(buffer);
+        lines[lineCount++] = strdup(buffer);
+    }
+    fclose(in);
+}
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double run(const char *name, int repeat, char *(*scan)(const char *), Tally *tally, double baseline)
+{
+    char buffer[BUFFER_MAX + 1];
+    double start = now();
+    int r;
+    long i;
+    memset(tally, 0, sizeof(Tally));
+    for(r = 0; r < repeat; r++) {
+        for(i = 0; i < lineCount; i++) {
+            strcpy(buffer, lines[i]);
+            if(scan) {
+                lex_table(buffer, tally, scan);
+            }
+            else {
+                lex_ctype(buffer, tally);
+            }
+        }
+    }
+    double elapsed = now() - start;
+    double lines_per_second = (double)lineCount * repeat / elapsed;
+    printf("%-8s %10.3f s %12.0f lines/s %9.1f MB/s", name, elapsed,
+           lines_per_second, (double)byteCount * repeat / elapsed / 1e6);
+    if(baseline > 0) printf("  %5.2fx", baseline / elapsed);
+    printf("\n");
+    return elapsed;
+}
+
+static int same(const Tally *a, const Tally *b)
+{
+    return a->values == b->values && a->integers == b->integers && a->words == b->words
+        && a->comments == b->comments && a->commentBytes == b->commentBytes;
+}
+
+int main(int argc, char *argv[])
+{
+    int repeat = 0;
+    int i = 1;
+    if(i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+        repeat = atoi(argv[i + 1]);
+        i += 2;
+    }
+    if(i == argc) {
+        fprintf(stderr, "usage: scanbench [-n REPEAT] FILE..." "\n");
+        return 1;
+    }
+    for(; i < argc; i++) load(argv[i]);
+    if(byteCount == 0) {
+        fprintf(stderr, "scanbench: nothing to lex" "\n");
+        return 1;
+    }
+    // default to lexing about 200MB of gcode per lexer
+    if(repeat <= 0) repeat = (int)(200000000 / byteCount) + 1;
+
+    printf("%ld lines, %ld bytes, %d repeats" "\n", lineCount, byteCount, repeat);
+    Tally reference, tally;
+    int rval = 0;
+    double baseline = run("ctype", repeat, NULL, &reference, 0);
+    run("scalar", repeat, scan_stop_scalar, &tally, baseline);
+    if(!same(&reference, &tally)) rval = 1;
+#ifdef HAVE_SCAN_SSE2
+    run("sse2", repeat, scan_stop_sse2, &tally, baseline);
+    if(!same(&reference, &tally)) rval = 1;
+#endif
+#ifdef HAVE_SCAN_AVX2
+    if(__builtin_cpu_supports("avx2")) {
+        run("avx2", repeat, scan_stop_avx2, &tally, baseline);
+        if(!same(&reference, &tally)) rval = 1;
+    }
+#endif
+    if(rval) fprintf(stderr, "scanbench: lexers disagree" "\n");
+    return rval;
+}
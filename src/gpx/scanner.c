@@ -0,0 +1,236 @@
+//  scanner.c
+//
+//  Character classification and scanning for the gcode lexer
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "scanner.h"
+
+#ifdef HAVE_SCAN_SSE2
+#include <immintrin.h>
+#endif
+
+// the longest number scan_word hands to strtod
+#define SCAN_WORD_MAX 1024
+
+// CHARACTER CLASSES
+
+#define S CC_SPACE
+#define D CC_DIGIT
+#define A CC_ALPHA
+#define C CC_CNTRL
+#define X CC_STOP
+
+const unsigned char gcode_class[256] = {
+    C|X, C, C, C, C, C, C, C,
+    C, S|C, S|C, S|C, S|C, S|C, C, C,
+    C, C, C, C, C, C, C, C,
+    C, C, C, C, C, C, C, C,
+    S, 0, 0, 0, 0, 0, 0, 0,
+    X, X, 0, 0, 0, 0, 0, 0,
+    D, D, D, D, D, D, D, D,
+    D, D, 0, X, 0, 0, 0, 0,
+    0, A, A, A, A, A, A, A,
+    A, A, A, A, A, A, A, A,
+    A, A, A, A, A, A, A, A,
+    A, A, A, 0, 0, 0, 0, 0,
+    0, A, A, A, A, A, A, A,
+    A, A, A, A, A, A, A, A,
+    A, A, A, A, A, A, A, A,
+    A, A, A, 0, 0, 0, 0, C,
+    // the upper half has no class in the C locale
+    0
+};
+
+#undef S
+#undef D
+#undef A
+#undef C
+#undef X
+
+// GCODE WORDS
+
+// powers of ten that are exactly representable as a double
+static const double exact_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+char *scan_word(char *p, double *value, int *integer)
+{
+    // we expect a letter followed by a number, spaces are ignored
+    // [ a-zA-Z] [ +-]? [ 0-9]+ ('.' [ 0-9]*)?
+    // value is rounded exactly as strtod would, integer is the whole part as
+    // atoi would read it, neither depends on the locale
+    char digits[SCAN_WORD_MAX + 16];
+    char *s = p + 1;
+    char *e = digits;
+    int negative = 0;
+    int point = 0;
+    int fraction = 0;
+    int significant = 0;
+    int saturated = 0;
+    int dropped = 0;
+    uint64_t mantissa = 0;
+    long whole = 0;
+    while(IS_SPACE(*s)) s++;
+    if(*s == '+' || *s == '-') {
+        negative = *s++ == '-';
+    }
+    while(1) {
+        // skip spaces
+        if(IS_SPACE(*s)) {
+            s++;
+        }
+        // accumulate digits
+        else if(IS_DIGIT(*s)) {
+            int d = *s++ - '0';
+            // keep the digits for strtod, past the limit only the scale matters
+            if(e < digits + SCAN_WORD_MAX) {
+                *e++ = (char)d + '0';
+            }
+            else {
+                dropped++;
+            }
+            if(mantissa || d) {
+                mantissa = mantissa * 10 + d;
+                significant++;
+            }
+            if(point) {
+                fraction++;
+            }
+            else if(whole <= (LONG_MAX - d) / 10) {
+                whole = whole * 10 + d;
+            }
+            else {
+                saturated = 1;
+            }
+        }
+        // a single decimal point
+        else if(*s == '.' && !point) {
+            s++;
+            point = 1;
+        }
+        else {
+            break;
+        }
+    }
+    if(saturated) {
+        *integer = (int)(negative ? LONG_MIN : LONG_MAX);
+    }
+    else {
+        *integer = (int)(negative ? -whole : whole);
+    }
+    // an exact mantissa and an exact power of ten means the division is only
+    // rounded once and so is correctly rounded
+    if(significant <= 19 && fraction <= 22 && mantissa <= (1ULL << 53)) {
+        double d = (double)mantissa;
+        if(fraction) d /= exact_powers_of_ten[fraction];
+        // a sign without digits isn't a number, so it reads as positive zero
+        *value = negative && e != digits ? -d : d;
+    }
+    // otherwise leave the rounding to strtod with the decimal point folded
+    // into the exponent so the locale doesn't matter
+    else {
+        sprintf(e, "e%d", dropped - fraction);
+        *value = strtod(digits, NULL);
+        if(negative) *value = -*value;
+    }
+    return s;
+}
+
+
+// SCANNING
+
+char *scan_stop_scalar(const char *p)
+{
+    while(!(CHAR_CLASS(*p) & CC_STOP)) p++;
+    return (char *)p;
+}
+
+// The vector scans only use aligned loads, which never cross a page boundary,
+// so reading past the terminating NUL can't fault.  The bytes before p in the
+// first block are masked off.  '(' and ')' differ only in the low bit, so one
+// compare of c | 1 with ')' finds both.
+
+#ifdef HAVE_SCAN_SSE2
+
+static inline unsigned sse2_stops(__m128i x)
+{
+    __m128i stops = _mm_or_si128(
+        _mm_cmpeq_epi8(x, _mm_setzero_si128()),
+        _mm_or_si128(
+            _mm_cmpeq_epi8(x, _mm_set1_epi8(';')),
+            _mm_cmpeq_epi8(_mm_or_si128(x, _mm_set1_epi8(1)), _mm_set1_epi8(')'))));
+    return (unsigned)_mm_movemask_epi8(stops);
+}
+
+char *scan_stop_sse2(const char *p)
+{
+    unsigned offset = (unsigned)((uintptr_t)p & 15);
+    const __m128i *v = (const __m128i *)(p - offset);
+    unsigned mask = sse2_stops(_mm_load_si128(v)) & (0xFFFFu << offset);
+    while(mask == 0) {
+        mask = sse2_stops(_mm_load_si128(++v));
+    }
+    return (char *)v + __builtin_ctz(mask);
+}
+
+#ifdef HAVE_SCAN_AVX2
+
+__attribute__((target("avx2")))
+static inline unsigned avx2_stops(__m256i x)
+{
+    __m256i stops = _mm256_or_si256(
+        _mm256_cmpeq_epi8(x, _mm256_setzero_si256()),
+        _mm256_or_si256(
+            _mm256_cmpeq_epi8(x, _mm256_set1_epi8(';')),
+            _mm256_cmpeq_epi8(_mm256_or_si256(x, _mm256_set1_epi8(1)), _mm256_set1_epi8(')'))));
+    return (unsigned)_mm256_movemask_epi8(stops);
+}
+
+__attribute__((target("avx2")))
+char *scan_stop_avx2(const char *p)
+{
+    unsigned offset = (unsigned)((uintptr_t)p & 31);
+    const __m256i *v = (const __m256i *)(p - offset);
+    unsigned mask = avx2_stops(_mm256_load_si256(v)) & (0xFFFFFFFFu << offset);
+    while(mask == 0) {
+        mask = avx2_stops(_mm256_load_si256(++v));
+    }
+    return (char *)v + __builtin_ctz(mask);
+}
+
+#endif
+#endif
+
+char *scan_stop(const char *p)
+{
+#if defined(HAVE_SCAN_AVX2)
+    if(__builtin_cpu_supports("avx2")) return scan_stop_avx2(p);
+    return scan_stop_sse2(p);
+#elif defined(HAVE_SCAN_SSE2)
+    return scan_stop_sse2(p);
+#else
+    return scan_stop_scalar(p);
+#endif
+}
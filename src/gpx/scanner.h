@@ -0,0 +1,61 @@
+//  scanner.h
+//
+//  Character classification and scanning for the gcode lexer
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#ifndef __scanner_h__
+#define __scanner_h__
+
+// character classes, these agree with the ctype functions in the C locale
+// but don't depend on the current locale or the sign of char
+
+#define CC_SPACE 1
+#define CC_DIGIT 2
+#define CC_ALPHA 4
+#define CC_CNTRL 8
+#define CC_STOP 16  // the characters scan_stop looks for: NUL ; ( )
+
+extern const unsigned char gcode_class[256];
+
+#define CHAR_CLASS(c) gcode_class[(unsigned char)(c)]
+#define IS_SPACE(c) (CHAR_CLASS(c) & CC_SPACE)
+#define IS_DIGIT(c) (CHAR_CLASS(c) & CC_DIGIT)
+#define IS_ALPHA(c) (CHAR_CLASS(c) & CC_ALPHA)
+#define IS_CNTRL(c) (CHAR_CLASS(c) & CC_CNTRL)
+
+// parse the number following the command letter at p and return a pointer to
+// the next word, value is rounded exactly as strtod would and integer is the
+// whole part as atoi would read it
+char *scan_word(char *p, double *value, int *integer);
+
+// return a pointer to the first NUL, ';', '(' or ')' at or after p, comments
+// are skipped 16 or 32 bytes at a time where the processor allows
+char *scan_stop(const char *p);
+
+// the individual implementations scan_stop chooses between
+char *scan_stop_scalar(const char *p);
+#if defined(__GNUC__) && defined(__SSE2__)
+#define HAVE_SCAN_SSE2 1
+char *scan_stop_sse2(const char *p);
+#if defined(__x86_64__) || defined(__i386__)
+#define HAVE_SCAN_AVX2 1
+char *scan_stop_avx2(const char *p);
+#endif
+#endif
+
+#endif /* __scanner_h__ */
@@ -0,0 +1,238 @@
+//  stepcmp.c
+//
+//  Compares the double and the fixed point mm to step conversion, converts
+//  the gcode line by line with both and reports every x3g command whose step
+//  counts or feedrate differ, with a per axis summary.  Exits non zero when
+//  they differ anywhere.
+//
+//  usage: stepcmp [-m MACHINE] [-n SHOW] GCODE
+//
+//  Copyright (c) 2026 GPX contributors, All rights reserved.
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gpx.h"
+
+#define LINE_MAX_LENGTH (BUFFER_MAX + 1)
+#define AXES 5
+
+static const char axis_name[AXES] = { 'X', 'Y', 'Z', 'A', 'B' };
+
+// the x3g commands converted from one line
+
+typedef struct tCapture {
+    char *data;
+    size_t length;
+    size_t size;
+    size_t *offset;     // of each command, and the length after the last
+    size_t count;
+    size_t capacity;
+} Capture;
+
+typedef struct tSummary {
+    unsigned long commands;
+    unsigned long differ;
+    unsigned long axis[AXES];   // commands with a different step count
+    long worst[AXES];           // largest difference in steps
+    unsigned long rate;         // commands with a different feedrate
+    unsigned long other;        // commands that differ in anything else
+} Summary;
+
+static int quiet_handler(Gpx *gpx, void *callbackData, const char *fmt, va_list ap)
+{
+    return SUCCESS;
+}
+
+static int capture_handler(Gpx *gpx, void *callbackData, char *buffer, size_t length)
+{
+    Capture *c = callbackData;
+    if(length == 0) return SUCCESS;
+    if(c->length + length > c->size) {
+        size_t size = c->size ? c->size * 2 : 4096;
+        while(size < c->length + length) size *= 2;
+        if((c->data = realloc(c->data, size)) == NULL) return ERROR;
+        c->size = size;
+    }
+    if(c->count + 2 > c->capacity) {
+        c->capacity = c->capacity ? c->capacity * 2 : 64;
+        if((c->offset = realloc(c->offset, c->capacity * sizeof(size_t))) == NULL) return ERROR;
+    }
+    c->offset[c->count++] = c->length;
+    memcpy(c->data + c->length, buffer, length);
+    c->length += length;
+    c->offset[c->count] = c->length;
+    return SUCCESS;
+}
+
+static int32_t read_int32(const unsigned char *p)
+{
+    return (int32_t)((uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+}
+
+static Gpx *open_converter(const char *machine, const char *fixed)
+{
+    char value[2];
+    Gpx *gpx = gpx_create();
+    if(gpx == NULL) return NULL;
+    gpx->resultHandler = quiet_handler;
+    if(gpx_set_machine(gpx, machine, 1) != SUCCESS) {
+        fprintf(stderr, "stepcmp: unknown machine %s" "\n", machine);
+        exit(1);
+    }
+    strcpy(value, fixed);
+    gpx_set_property(gpx, "printer", "fixed_point", value);
+    return gpx;
+}
+
+// compare the commands two converters made of one line
+
+static void compare(unsigned line, const Capture *d, const Capture *f, Summary *summary, long *show)
+{
+    size_t n;
+    int k;
+    if(d->count != f->count) {
+        summary->commands += d->count;
+        summary->differ += d->count;
+        summary->other += d->count;
+        if((*show)-- > 0) printf("line %u: %lu commands become %lu" "\n", line, (unsigned long)d->count, (unsigned long)f->count);
+        return;
+    }
+    for(n = 0; n < d->count; n++) {
+        const unsigned char *a = (const unsigned char *)d->data + d->offset[n];
+        const unsigned char *b = (const unsigned char *)f->data + f->offset[n];
+        size_t length = d->offset[n + 1] - d->offset[n];
+        summary->commands++;
+        if(length == f->offset[n + 1] - f->offset[n] && memcmp(a, b, length) == 0) continue;
+        summary->differ++;
+        // 139, 140, 142 and 155 start with the five axis positions in steps
+        if(a[0] != b[0] || length < 1 + 4 * AXES || !(a[0] == 139 || a[0] == 140 || a[0] == 142 || a[0] == 155)) {
+            summary->other++;
+            if((*show)-- > 0) printf("line %u: command %u differs" "\n", line, a[0]);
+            continue;
+        }
+        int show_this = (*show)-- > 0;
+        if(show_this) printf("line %u: command %u", line, a[0]);
+        for(k = 0; k < AXES; k++) {
+            long sd = read_int32(a + 1 + 4 * k);
+            long sf = read_int32(b + 1 + 4 * k);
+            if(sd != sf) {
+                long delta = labs(sf - sd);
+                summary->axis[k]++;
+                if(delta > summary->worst[k]) summary->worst[k] = delta;
+                if(show_this) printf(" %c %ld/%ld", axis_name[k], sd, sf);
+            }
+        }
+        if(a[0] == 155 && length >= 25 && memcmp(a + 21, b + 21, 4) != 0) {
+            summary->rate++;
+            if(show_this) printf(" rate %u/%u", (unsigned)read_int32(a + 21), (unsigned)read_int32(b + 21));
+        }
+        if(show_this) printf("\n");
+    }
+}
+
+static void usage(void)
+{
+    fputs("usage: stepcmp [-m MACHINE] [-n SHOW] GCODE" "\n", stderr);
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *machine = "r2x";
+    char line[LINE_MAX_LENGTH];
+    char copy[LINE_MAX_LENGTH];
+    Capture captured[2];
+    Summary summary;
+    long show = 20;
+    unsigned number = 0;
+    int i, k;
+
+    for(i = 1; i < argc && argv[i][0] == '-'; i++) {
+        if(i + 1 == argc) usage();
+        if(strcmp(argv[i], "-m") == 0) {
+            machine = argv[++i];
+        }
+        else if(strcmp(argv[i], "-n") == 0) {
+            show = atol(argv[++i]);
+        }
+        else {
+            usage();
+        }
+    }
+    if(argc - i != 1) usage();
+
+    FILE *in = fopen(argv[i], "r");
+    if(in == NULL) {
+        perror(argv[i]);
+        return 1;
+    }
+    Gpx *gpx[2] = { open_converter(machine, "0"), open_converter(machine, "1") };
+    if(gpx[0] == NULL || gpx[1] == NULL) {
+        fputs("stepcmp: insufficient memory" "\n", stderr);
+        return 1;
+    }
+    memset(captured, 0, sizeof(captured));
+    memset(&summary, 0, sizeof(summary));
+    for(k = 0; k < 2; k++) {
+        gpx_register_callback(gpx[k], capture_handler, captured + k);
+        gpx_start_convert(gpx[k], "stepcmp", 0, 0);
+    }
+
+    // both convert the same line before the commands are compared, the
+    // parser modifies the line so each gets its own copy
+    for(;;) {
+        int more = fgets(line, sizeof(line), in) != NULL;
+        number++;
+        for(k = 0; k < 2; k++) {
+            captured[k].length = captured[k].count = 0;
+            if(more) {
+                strcpy(copy, line);
+                if(gpx_convert_line(gpx[k], copy) < 0) {
+                    fprintf(stderr, "stepcmp: line %u failed to convert" "\n", number);
+                    return 1;
+                }
+            }
+            else {
+                gpx_end_convert(gpx[k]);
+            }
+        }
+        compare(number, captured, captured + 1, &summary, &show);
+        if(!more) break;
+    }
+    fclose(in);
+
+    printf("%u lines, %lu x3g commands, %lu differ", number - 1, summary.commands, summary.differ);
+    if(summary.differ) {
+        printf(":");
+        for(k = 0; k < AXES; k++) {
+            if(summary.axis[k]) printf(" %c %lu (at most %ld steps)", axis_name[k], summary.axis[k], summary.worst[k]);
+        }
+        if(summary.rate) printf(" feedrate %lu", summary.rate);
+        if(summary.other) printf(" other %lu", summary.other);
+    }
+    printf("\n");
+    for(k = 0; k < 2; k++) {
+        gpx_destroy(gpx[k]);
+        free(captured[k].data);
+        free(captured[k].offset);
+    }
+    return summary.differ ? 1 : 0;
+}
@@ -0,0 +1,17 @@
+; arcs from I and J offsets, from R (a negative R takes the longer way
+; round), a full circle, a helix and an R too short to reach the end
+M104 S220 T0
+G21
+G90
+M82
+G92 X0 Y0 Z0 E0
+G1 Z0.2 F1200
+G1 X5 Y0 F3000
+G2 X0 Y-5 I-5 J0 E0.5 F1500
+G3 X5 Y0 I0 J5 E1.0
+G3 X-5 Y0 R5 E1.5
+G2 X5 Y0 R-5 E2.5
+G2 X5 Y0 I-5 J0 E4.0
+G3 X5 Y0 Z1.2 I-5 J0 E5.5
+G2 X20 Y0 R2 E6.0
+G1 Z5 F1200
@@ -0,0 +1,124 @@
+; runs of short moves along a line and around a quarter circle, which
+; --coalesce merges without changing the filament extruded
+M104 S220 T0
+M140 S60
+G21
+G90
+M82
+G92 X0 Y0 Z0 E0
+G1 Z0.2 F1200
+M116
+G1 X10 Y0 F3000
+G1 F1500
+G1 X11.000 Y0.000 E0.03300
+G1 X12.000 Y0.000 E0.06600
+G1 X13.000 Y0.000 E0.09900
+G1 X14.000 Y0.000 E0.13200
+G1 X15.000 Y0.000 E0.16500
+G1 X16.000 Y0.000 E0.19800
+G1 X17.000 Y0.000 E0.23100
+G1 X18.000 Y0.000 E0.26400
+G1 X19.000 Y0.000 E0.29700
+G1 X20.000 Y0.000 E0.33000
+G1 X21.000 Y0.000 E0.36300
+G1 X22.000 Y0.000 E0.39600
+G1 X23.000 Y0.000 E0.42900
+G1 X24.000 Y0.000 E0.46200
+G1 X25.000 Y0.000 E0.49500
+G1 X26.000 Y0.000 E0.52800
+G1 X27.000 Y0.000 E0.56100
+G1 X28.000 Y0.000 E0.59400
+G1 X29.000 Y0.000 E0.62700
+G1 X30.000 Y0.000 E0.66000
+G1 X30.175 Y0.002 E0.66576
+G1 X30.349 Y0.006 E0.67152
+G1 X30.523 Y0.014 E0.67728
+G1 X30.698 Y0.024 E0.68304
+G1 X30.872 Y0.038 E0.68880
+G1 X31.045 Y0.055 E0.69456
+G1 X31.219 Y0.075 E0.70032
+G1 X31.392 Y0.097 E0.70608
+G1 X31.564 Y0.123 E0.71184
+G1 X31.736 Y0.152 E0.71760
+G1 X31.908 Y0.184 E0.72335
+G1 X32.079 Y0.219 E0.72911
+G1 X32.250 Y0.256 E0.73487
+G1 X32.419 Y0.297 E0.74063
+G1 X32.588 Y0.341 E0.74639
+G1 X32.756 Y0.387 E0.75215
+G1 X32.924 Y0.437 E0.75791
+G1 X33.090 Y0.489 E0.76367
+G1 X33.256 Y0.545 E0.76943
+G1 X33.420 Y0.603 E0.77519
+G1 X33.584 Y0.664 E0.78095
+G1 X33.746 Y0.728 E0.78671
+G1 X33.907 Y0.795 E0.79247
+G1 X34.067 Y0.865 E0.79823
+G1 X34.226 Y0.937 E0.80399
+G1 X34.384 Y1.012 E0.80975
+G1 X34.540 Y1.090 E0.81551
+G1 X34.695 Y1.171 E0.82127
+G1 X34.848 Y1.254 E0.82703
+G1 X35.000 Y1.340 E0.83279
+G1 X35.150 Y1.428 E0.83854
+G1 X35.299 Y1.520 E0.84430
+G1 X35.446 Y1.613 E0.85006
+G1 X35.592 Y1.710 E0.85582
+G1 X35.736 Y1.808 E0.86158
+G1 X35.878 Y1.910 E0.86734
+G1 X36.018 Y2.014 E0.87310
+G1 X36.157 Y2.120 E0.87886
+G1 X36.293 Y2.229 E0.88462
+G1 X36.428 Y2.340 E0.89038
+G1 X36.561 Y2.453 E0.89614
+G1 X36.691 Y2.569 E0.90190
+G1 X36.820 Y2.686 E0.90766
+G1 X36.947 Y2.807 E0.91342
+G1 X37.071 Y2.929 E0.91918
+G1 X37.193 Y3.053 E0.92494
+G1 X37.314 Y3.180 E0.93070
+G1 X37.431 Y3.309 E0.93646
+G1 X37.547 Y3.439 E0.94222
+G1 X37.660 Y3.572 E0.94798
+G1 X37.771 Y3.707 E0.95374
+G1 X37.880 Y3.843 E0.95949
+G1 X37.986 Y3.982 E0.96525
+G1 X38.090 Y4.122 E0.97101
+G1 X38.192 Y4.264 E0.97677
+G1 X38.290 Y4.408 E0.98253
+G1 X38.387 Y4.554 E0.98829
+G1 X38.480 Y4.701 E0.99405
+G1 X38.572 Y4.850 E0.99981
+G1 X38.660 Y5.000 E1.00557
+G1 X38.746 Y5.152 E1.01133
+G1 X38.829 Y5.305 E1.01709
+G1 X38.910 Y5.460 E1.02285
+G1 X38.988 Y5.616 E1.02861
+G1 X39.063 Y5.774 E1.03437
+G1 X39.135 Y5.933 E1.04013
+G1 X39.205 Y6.093 E1.04589
+G1 X39.272 Y6.254 E1.05165
+G1 X39.336 Y6.416 E1.05741
+G1 X39.397 Y6.580 E1.06317
+G1 X39.455 Y6.744 E1.06893
+G1 X39.511 Y6.910 E1.07468
+G1 X39.563 Y7.076 E1.08044
+G1 X39.613 Y7.244 E1.08620
+G1 X39.659 Y7.412 E1.09196
+G1 X39.703 Y7.581 E1.09772
+G1 X39.744 Y7.750 E1.10348
+G1 X39.781 Y7.921 E1.10924
+G1 X39.816 Y8.092 E1.11500
+G1 X39.848 Y8.264 E1.12076
+G1 X39.877 Y8.436 E1.12652
+G1 X39.903 Y8.608 E1.13228
+G1 X39.925 Y8.781 E1.13804
+G1 X39.945 Y8.955 E1.14380
+G1 X39.962 Y9.128 E1.14956
+G1 X39.976 Y9.302 E1.15532
+G1 X39.986 Y9.477 E1.16108
+G1 X39.994 Y9.651 E1.16684
+G1 X39.998 Y9.825 E1.17260
+G1 X40.000 Y10.000 E1.17836
+G1 E0.17836 F2400
+G1 Z5 F1200
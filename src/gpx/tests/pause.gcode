@@ -0,0 +1,14 @@
+; the pause @ zPos defined by pause.ini is issued at the start of the body
+; and the build pauses when it reaches 1mm
+M104 S220 T0
+G21
+G90
+M82
+G92 X0 Y0 Z0 E0
+;@body
+G1 Z0.5 F1200
+G1 X10 Y10 E1 F1500
+G1 Z1.0 F1200
+G1 X20 Y10 E2 F1500
+G1 Z1.5 F1200
+G1 X20 Y20 E3 F1500
@@ -0,0 +1,23 @@
+; resume a print part way through, the fan and tool the gcode before
+; left set are restored before the print continues
+M104 S220 T0
+M104 S210 T1
+M140 S60
+G21
+G90
+M82
+G92 X0 Y0 Z0 E0
+G1 Z0.2 F1200
+M106 S255
+G1 X10 Y10 E1 F1500
+G1 X20 Y10 E2
+T1
+G92 E0
+G1 X30 Y10 E1
+M107
+G1 X40 Y10 E2
+G1 Z0.4 F1200
+M106
+G1 X40 Y20 E3 F1500
+G1 X30 Y20 E4
+G1 X20 Y20 E5
@@ -2,6 +2,7 @@
 
 #include <ctype.h>
 #include <fcntl.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -16,12 +17,9 @@
 #include "eeprominfo.h"
 #include "gpx.h"
 
-// TODO at the moment the module is taking twice as much memory for Gpx as it
-// should to because gpx-main also has one. We can merge them via extern or pass
-// it one way or the other, but perhaps the best way is to drop gpx-main from
-// the module and reserve that for the CLI.  We'll need to refactor a couple of
-// things from it however
-static Gpx gpx;
+// the module drives a single printer connection, so it keeps one context for
+// it allocated from libgpx when the module is loaded
+static Gpx *gpx;
 static Tio *tio;
 
 static int connected = 0;
@@ -57,7 +55,7 @@ static void clear_state_for_cancel(void)
 // return the translation or set the error context and return NULL if failure
 static PyObject *py_return_translation(int rval)
 {
-    rval = gpx_return_translation(&gpx, rval);
+    rval = gpx_return_translation(gpx, rval);
 
     switch (rval) {
         case SUCCESS:
@@ -114,7 +112,7 @@ static PyObject *py_return_translation(int rval)
 
 static PyObject *py_write_string(const char *s)
 {
-    return py_return_translation(gpx_write_string_core(&gpx, s));
+    return py_return_translation(gpx_write_string_core(gpx, s));
 }
 
 // def connect(port, baudrate, inipath, logpath)
@@ -143,32 +141,32 @@ static PyObject *py_connect(PyObject *self, PyObject *args)
 
     tio_cleanup(tio);
     connected = 1;
-    gpx_initialize(&gpx, 0);
-    gpx.axis.positionKnown = 0;
-    gpx.flag.M106AlwaysValve = 1;
-    gpx.flag.verboseSioMode = gpx.flag.verboseMode = verbose;
-    gpx.flag.logMessages = 1;
+    gpx_initialize(gpx, 0);
+    gpx->axis.positionKnown = 0;
+    gpx->flag.M106AlwaysValve = 1;
+    gpx->flag.verboseSioMode = gpx->flag.verboseMode = verbose;
+    gpx->flag.logMessages = 1;
 
     // open the log file
-    if (logpath != NULL && (gpx.log = fopen(logpath, "a")) == NULL) {
+    if (logpath != NULL && (gpx->log = fopen(logpath, "a")) == NULL) {
         fprintf(stderr, "Unable to open logfile (%s) for writing\n", logpath);
     }
-    if (gpx.log == NULL)
-        gpx.log = stderr;
+    if (gpx->log == NULL)
+        gpx->log = stderr;
 #ifdef ALWAYS_USE_STDERR
-    else if (gpx.log != stderr)
+    else if (gpx->log != stderr)
     {
-        fclose(gpx.log);
-        gpx.log = stderr;
+        fclose(gpx->log);
+        gpx->log = stderr;
     }
 #endif
 
     // load the config
     if (inipath != NULL)
     {
-        int lineno = gpx_load_config(&gpx, inipath);
+        int lineno = gpx_load_config(gpx, inipath);
         if (lineno < 0) {
-            fprintf(gpx.log, "Unable to load configuration file (%s)\n", inipath);
+            fprintf(gpx->log, "Unable to load configuration file (%s)\n", inipath);
             tio_printf(tio, "Error: Unable to load configuration file (%s)\n", inipath);
         }
         if (lineno > 0) {
@@ -176,7 +174,7 @@ static PyObject *py_connect(PyObject *self, PyObject *args)
         }
     }
 
-    int rval = gpx_connect(&gpx, port, baudrate);
+    int rval = gpx_connect(gpx, port, baudrate);
 #if PY_MAJOR_VERSION >= 3
     if (pyobj_port != NULL)
         Py_DECREF(pyobj_port);
@@ -217,11 +215,11 @@ static PyObject *py_start(PyObject *self, PyObject *args)
 
     tio->cur = 0;
     tio->translation[0] = 0;
-    int rval = get_advanced_version_number(&gpx);
+    int rval = get_advanced_version_number(gpx);
     if (rval >= 0) {
         tio->waitflag.waitForEmptyQueue = 1;
         tio_printf(tio, "\necho: gcode to x3g translation by GPX");
-        rval = gpx_write_string(&gpx, "M21");
+        rval = gpx_write_string(gpx, "M21");
     }
     return py_return_translation(rval);
 }
@@ -249,6 +247,102 @@ static PyObject *py_write(PyObject *self, PyObject *args)
     return rval;
 }
 
+// add an attribute to the exception being raised
+static void set_error_attribute(const char *name, Py_ssize_t value)
+{
+    PyObject *type, *exc, *traceback, *attr;
+
+    PyErr_Fetch(&type, &exc, &traceback);
+    PyErr_NormalizeException(&type, &exc, &traceback);
+    if (exc != NULL && (attr = PyLong_FromSsize_t(value)) != NULL) {
+        PyObject_SetAttrString(exc, name, attr);
+        Py_DECREF(attr);
+    }
+    PyErr_Restore(type, exc, traceback);
+}
+
+// def write_moves(buffer)
+//  Translate and send moves without formatting them as g-code.  The buffer
+//  holds records of MOVE_FIELDS native doubles, the g, m, t, x, y, z, a, b, e,
+//  f, p, r, s, i and j words of a line with NaN for a word the line doesn't
+//  have, such as an array('d') or a numpy float64 array.  Returns the
+//  translation and the number of moves converted, which is short of the
+//  whole buffer if a move stopped the batch.  An exception raised by a move
+//  has the number converted before it as its converted attribute.
+#define MOVE_FIELDS 15
+
+static PyObject *py_write_moves(PyObject *self, PyObject *args)
+{
+    static const int word_flag[MOVE_FIELDS] = {
+        G_IS_SET, M_IS_SET, T_IS_SET, X_IS_SET, Y_IS_SET, Z_IS_SET, A_IS_SET,
+        B_IS_SET, E_IS_SET, F_IS_SET, P_IS_SET, R_IS_SET, S_IS_SET, I_IS_SET,
+        J_IS_SET
+    };
+    Py_buffer pybuf;
+    GpxMove *moves;
+    size_t count, i;
+    int j;
+
+    if (!connected)
+        return PyErr_NotConnected();
+
+    if (!PyArg_ParseTuple(args, "s*", &pybuf))
+        return NULL;
+    if (pybuf.len % (MOVE_FIELDS * sizeof(double))) {
+        PyBuffer_Release(&pybuf);
+        PyErr_SetString(PyExc_ValueError, "write_moves buffer is not a whole number of move records");
+        return NULL;
+    }
+    count = pybuf.len / (MOVE_FIELDS * sizeof(double));
+    if ((moves = PyMem_Malloc(count ? count * sizeof(GpxMove) : 1)) == NULL) {
+        PyBuffer_Release(&pybuf);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < count; i++) {
+        double word[MOVE_FIELDS];
+        GpxMove *move = moves + i;
+        memcpy(word, (const char *)pybuf.buf + i * sizeof(word), sizeof(word));
+        move->flag = 0;
+        for (j = 0; j < MOVE_FIELDS; j++) {
+            if (isnan(word[j]))
+                word[j] = 0.0;
+            else
+                move->flag |= word_flag[j];
+        }
+        move->g = (unsigned)word[0];
+        move->m = (unsigned)word[1];
+        move->t = (unsigned)word[2];
+        move->x = word[3];
+        move->y = word[4];
+        move->z = word[5];
+        move->a = word[6];
+        move->b = word[7];
+        move->e = word[8];
+        move->f = word[9];
+        move->p = word[10];
+        move->r = word[11];
+        move->s = word[12];
+        move->i = word[13];
+        move->j = word[14];
+        move->comment = NULL;
+    }
+    PyBuffer_Release(&pybuf);
+
+    tio->cur = 0;
+    tio->translation[0] = 0;
+    tio->waitflag.waitForBuffer = 0;
+    tio->flag.okPending = !tio->waiting;
+    size_t converted = 0;
+    PyObject *translation = py_return_translation(gpx_write_moves_core(gpx, moves, count, &converted));
+    tio->flag.okPending = 0;
+    PyMem_Free(moves);
+    if (translation == NULL) {
+        set_error_attribute("converted", (Py_ssize_t)converted);
+        return NULL;
+    }
+    return Py_BuildValue("(Nn)", translation, (Py_ssize_t)converted);
+}
+
 // def readnext()
 static PyObject *py_readnext(PyObject *self, PyObject *args)
 {
@@ -260,42 +354,42 @@ static PyObject *py_readnext(PyObject *self, PyObject *args)
     if (!PyArg_ParseTuple(args, ""))
         return NULL;
 
-    if (gpx.flag.verboseMode)
-        fprintf(gpx.log, "i");
+    if (gpx->flag.verboseMode)
+        fprintf(gpx->log, "i");
     tio->cur = 0;
     tio->translation[0] = 0;
 
     if (tio->flag.listingFiles) {
-        rval = get_next_filename(&gpx, 0);
+        rval = get_next_filename(gpx, 0);
     }
     else if (tio->waiting) {
-        if (gpx.flag.verboseMode)
-            fprintf(gpx.log, "tio->waiting = %u\n", tio->waiting);
+        if (gpx->flag.verboseMode)
+            fprintf(gpx->log, "tio->waiting = %u\n", tio->waiting);
         if (!tio->waitflag.waitForCancelSync) {
             if (tio->waitflag.waitForUnpause)
-                rval = get_build_statistics(&gpx);
+                rval = get_build_statistics(gpx);
             // if we're waiting for the queue to drain, do that before checking on
             // anything else
             if (rval == SUCCESS && (tio->waitflag.waitForEmptyQueue || tio->waitflag.waitForButton))
-                rval = is_ready(&gpx);
+                rval = is_ready(gpx);
             if (rval == SUCCESS && !tio->waitflag.waitForEmptyQueue) {
                 if (tio->waitflag.waitForStart || tio->waitflag.waitForBotCancel)
-                    rval = get_build_statistics(&gpx);
+                    rval = get_build_statistics(gpx);
                 if (rval == SUCCESS && tio->waitflag.waitForPlatform)
-                    rval = is_build_platform_ready(&gpx, 0);
+                    rval = is_build_platform_ready(gpx, 0);
                 if (rval == SUCCESS && tio->waitflag.waitForExtruderA)
-                    rval = is_extruder_ready(&gpx, 0);
+                    rval = is_extruder_ready(gpx, 0);
                 if (rval == SUCCESS && tio->waitflag.waitForExtruderB)
-                    rval = is_extruder_ready(&gpx, 1);
+                    rval = is_extruder_ready(gpx, 1);
             }
         }
-        if (gpx.flag.verboseMode)
-            fprintf(gpx.log, "tio->waiting = %u and rval = %d\n", tio->waiting, rval);
+        if (gpx->flag.verboseMode)
+            fprintf(gpx->log, "tio->waiting = %u and rval = %d\n", tio->waiting, rval);
         if (rval == SUCCESS) {
             if (tio->waiting) {
-                if (gpx.flag.verboseMode) {
+                if (gpx->flag.verboseMode) {
                     tio_printf(tio, "// echo: tio->waiting = 0x%x\n", tio->waiting);
-                    fprintf(gpx.log, "o");
+                    fprintf(gpx->log, "o");
                 }
                 return py_write_string("M105");
             }
@@ -304,13 +398,13 @@ static PyObject *py_readnext(PyObject *self, PyObject *args)
         }
     }
     else if (tio->flag.waitClearedByCancel) {
-        if(gpx.flag.verboseMode)
-            fprintf(gpx.log, "adding ok for wait cleared by cancel\n");
+        if(gpx->flag.verboseMode)
+            fprintf(gpx->log, "adding ok for wait cleared by cancel\n");
         tio->flag.waitClearedByCancel = 0;
         tio_printf(tio, "ok");
     }
-    if (gpx.flag.verboseMode)
-        fprintf(gpx.log, "o");
+    if (gpx->flag.verboseMode)
+        fprintf(gpx->log, "o");
     return py_return_translation(rval);
 }
 
@@ -330,7 +424,7 @@ static PyObject *py_set_baudrate(PyObject *self, PyObject *args)
 
     if(tcgetattr(tio->sio.port, &tp) < 0)
         return PyErr_SetFromErrno(PyExc_IOError);
-    speed = speed_from_long(&baudrate);
+    speed = speed_from_long(gpx, &baudrate);
     if (speed == B0)
         return NULL;
     cfsetspeed(&tp, speed);
@@ -380,7 +474,7 @@ static PyObject *py_get_machine_defaults(PyObject *self, PyObject *args)
     Machine *machine = gpx_find_machine(machine_type_id);
     machine_type_id = NULL;
     PyBuffer_Release(&pybuf);
-    fflush(gpx.log);
+    fflush(gpx->log);
 
     if (machine == NULL) {
         PyErr_SetString(PyExc_ValueError, "Machine id not found");
@@ -433,7 +527,7 @@ static PyObject *py_read_ini(PyObject *self, PyObject *args)
         return NULL;
     inipath = (const char *)pybuf.buf;
 
-    int lineno = gpx_load_config(&gpx, inipath);
+    int lineno = gpx_load_config(gpx, inipath);
 
     if (lineno == 0) {
         inipath = NULL;
@@ -442,10 +536,10 @@ static PyObject *py_read_ini(PyObject *self, PyObject *args)
     }
 
     if (lineno < 0)
-        fprintf(gpx.log, "Unable to load configuration file (%s)\n", inipath);
+        fprintf(gpx->log, "Unable to load configuration file (%s)\n", inipath);
     if (lineno > 0)
-        fprintf(gpx.log, "(line %u) Configuration syntax error in %s: unrecognized parameters\n", lineno, inipath);
-    fflush(gpx.log);
+        fprintf(gpx->log, "(line %u) Configuration syntax error in %s: unrecognized parameters\n", lineno, inipath);
+    fflush(gpx->log);
 
     inipath = NULL;
     PyBuffer_Release(&pybuf);
@@ -459,27 +553,28 @@ static PyObject *py_read_ini(PyObject *self, PyObject *args)
 static PyObject *py_reset_ini(PyObject *self, PyObject *args)
 {
     // some state survives reset_ini
-    void *callbackHandler = gpx.callbackHandler;
-    void *resultHandler = gpx.resultHandler;
-    void *callbackData = gpx.callbackData;
-    FILE *log = gpx.log;
-    unsigned verbose = gpx.flag.verboseMode;
-
-    // nuke it all
-    gpx_initialize(&gpx, 1);
-    gpx.axis.positionKnown = 0;
-    gpx.flag.M106AlwaysValve = 1;
+    void *callbackHandler = gpx->callbackHandler;
+    void *resultHandler = gpx->resultHandler;
+    void *callbackData = gpx->callbackData;
+    FILE *log = gpx->log;
+    unsigned verbose = gpx->flag.verboseMode;
+
+    // nuke it all, except the translation state the module holds on to
+    gpx_initialize(gpx, 1);
+    gpx->tio = tio;
+    gpx->axis.positionKnown = 0;
+    gpx->flag.M106AlwaysValve = 1;
 
     // restore some stuff, plus we're still in pymodule mode
-    gpx.callbackHandler = callbackHandler;
-    gpx.resultHandler = resultHandler;
-    gpx.callbackData = callbackData;
-    gpx.log = log;
-    gpx.flag.framingEnabled = 1;
-    gpx.flag.sioConnected = 1;
-    gpx.sio = &tio->sio;
-    gpx.flag.verboseMode = verbose;
-    gpx.flag.logMessages = 1;
+    gpx->callbackHandler = callbackHandler;
+    gpx->resultHandler = resultHandler;
+    gpx->callbackData = callbackData;
+    gpx->log = log;
+    gpx->flag.framingEnabled = 1;
+    gpx->flag.sioConnected = 1;
+    gpx->sio = &tio->sio;
+    gpx->flag.verboseMode = verbose;
+    gpx->flag.logMessages = 1;
 
     return Py_BuildValue("i", 0);
 }
@@ -501,7 +596,7 @@ static PyObject *py_waiting(PyObject *self, PyObject *args)
 // are we printing a build?
 static PyObject *py_build_started(PyObject *self, PyObject *args)
 {
-    if (gpx.flag.programState == RUNNING_STATE)
+    if (gpx->flag.programState == RUNNING_STATE)
         Py_RETURN_TRUE;
     else
         Py_RETURN_FALSE;
@@ -514,7 +609,7 @@ static PyObject *py_build_paused(PyObject *self, PyObject *args)
     if (!connected)
         return PyErr_NotConnected();
 
-    int rval = get_build_statistics(&gpx);
+    int rval = get_build_statistics(gpx);
     // if we fail, is that a yes or a no?
     if (rval != SUCCESS) {
         PyErr_SetString(PyExc_IOError, "Unable to get build statistics.");
@@ -550,8 +645,8 @@ static PyObject *py_reprap_flavor(PyObject *self, PyObject *args)
     if (!PyArg_ParseTuple(args, "i", &reprap))
         return NULL;
 
-    int rval = gpx.flag.reprapFlavor;
-    gpx.flag.reprapFlavor = !!reprap;
+    int rval = gpx->flag.reprapFlavor;
+    gpx->flag.reprapFlavor = !!reprap;
     if (rval)
         Py_RETURN_TRUE;
     else
@@ -598,9 +693,9 @@ static PyObject *py_stop(PyObject *self, PyObject *args)
     if (!PyArg_ParseTuple(args, "|ii", &halt_steppers, &clear_queue))
         return NULL;
 
-    if (gpx.flag.verboseMode) fprintf(gpx.log, "py_stop\n");
+    if (gpx->flag.verboseMode) fprintf(gpx->log, "py_stop\n");
     if (!tio->waitflag.waitForCancelSync) {
-        if (gpx.flag.verboseMode) fprintf(gpx.log, "py_stop now waiting for @clear_cancel\n");
+        if (gpx->flag.verboseMode) fprintf(gpx->log, "py_stop now waiting for @clear_cancel\n");
         tio->flag.cancelPending = 1;
     }
 
@@ -611,27 +706,27 @@ static PyObject *py_stop(PyObject *self, PyObject *args)
     // first, ask if we are SD printing
     // delay 1ms is a queuable command that will fail if SD printing
     int sdprinting = 0;
-    rval = delay(&gpx, 1);
+    rval = delay(gpx, 1);
     if (rval == 0x8A) // SD printing
         sdprinting = 1;
     // ignore any other response
 
-    if (sdprinting && !gpx.flag.sd_paused) {
-        rval = pause_resume(&gpx);
+    if (sdprinting && !gpx->flag.sd_paused) {
+        rval = pause_resume(gpx);
         if (rval != SUCCESS)
             return py_return_translation(rval);
-        gpx.flag.sd_paused = 1;
+        gpx->flag.sd_paused = 1;
     }
 
-    rval = extended_stop(&gpx, halt_steppers, clear_queue);
+    rval = extended_stop(gpx, halt_steppers, clear_queue);
 
     if (rval != 0x89)
         tio->waitflag.waitForCancelSync = 0;
 
     if (rval != SUCCESS)
         return py_return_translation(rval);
-    gpx.flag.sd_paused = 0;
-    return set_build_aborted_state(&gpx);
+    gpx->flag.sd_paused = 0;
+    return set_build_aborted_state(gpx);
 }
 
 // def abort()
@@ -643,15 +738,15 @@ static PyObject *py_abort(PyObject *self, PyObject *args)
     if (!PyArg_ParseTuple(args, ""))
         return NULL;
 
-    if (gpx.flag.verboseMode) fprintf(gpx.log, "py_abort\n");
+    if (gpx->flag.verboseMode) fprintf(gpx->log, "py_abort\n");
     if (!tio->waitflag.waitForCancelSync) {
-        if (gpx.flag.verboseMode) fprintf(gpx.log, "py_abort now waiting for @clear_cancel\n");
+        if (gpx->flag.verboseMode) fprintf(gpx->log, "py_abort now waiting for @clear_cancel\n");
         tio->flag.cancelPending = 1;
     }
 
     clear_state_for_cancel();
 
-    int rval = abort_immediately(&gpx);
+    int rval = abort_immediately(gpx);
 
     // ESIOTIMEOUT is only returned if the write succeeded, but no bytes returned
     // I think this can happen if the bot resets immediately and doesn't respond
@@ -664,11 +759,11 @@ static PyObject *py_abort(PyObject *self, PyObject *args)
         tio->waitflag.waitForCancelSync = 0;
 
     if (rval != SUCCESS) {
-        if (gpx.flag.verboseMode) fprintf(gpx.log, "abort_immediately rval = %d\n", rval);
+        if (gpx->flag.verboseMode) fprintf(gpx->log, "abort_immediately rval = %d\n", rval);
         return py_return_translation(rval);
     }
-    gpx.flag.sd_paused = 0;
-    return set_build_aborted_state(&gpx);
+    gpx->flag.sd_paused = 0;
+    return set_build_aborted_state(gpx);
 }
 
 // def read_eeprom(id)
@@ -680,7 +775,7 @@ static PyObject *py_read_eeprom(PyObject *self, PyObject *args)
     tio->cur = 0;
     tio->translation[0] = 0;
 
-    if (gpx.eepromMap == NULL && load_eeprom_map(&gpx) != SUCCESS) {
+    if (gpx->eepromMap == NULL && load_eeprom_map(gpx) != SUCCESS) {
         PyErr_SetString(pyerrUnknownFirmware, "No EEPROM map found for firmware type and/or version");
         return NULL;
     }
@@ -691,8 +786,8 @@ static PyObject *py_read_eeprom(PyObject *self, PyObject *args)
         return NULL;
     id = (const char *)pybuf.buf;
 
-    if (gpx.flag.verboseMode) fprintf(gpx.log, "py_read_eeprom %s\n", id);
-    EepromMapping *pem = find_any_eeprom_mapping(&gpx, id);
+    if (gpx->flag.verboseMode) fprintf(gpx->log, "py_read_eeprom %s\n", id);
+    EepromMapping *pem = find_any_eeprom_mapping(gpx, id);
     id = NULL;
     PyBuffer_Release(&pybuf);
 
@@ -707,44 +802,44 @@ static PyObject *py_read_eeprom(PyObject *self, PyObject *args)
     float n;
     switch (pem->et) {
         case et_boolean:
-            if (read_eeprom_8(&gpx, gpx.sio, pem->address, &b) == SUCCESS)
+            if (read_eeprom_8(gpx, gpx->sio, pem->address, &b) == SUCCESS)
                 return Py_BuildValue("O", b ? Py_True : Py_False);
             break;
 
         case et_bitfield:
         case et_byte:
-            if (read_eeprom_8(&gpx, gpx.sio, pem->address, &b) == SUCCESS)
+            if (read_eeprom_8(gpx, gpx->sio, pem->address, &b) == SUCCESS)
                 return Py_BuildValue("B", b);
             break;
 
         case et_ushort:
-            if (read_eeprom_16(&gpx, gpx.sio, pem->address, &us) == SUCCESS)
+            if (read_eeprom_16(gpx, gpx->sio, pem->address, &us) == SUCCESS)
                 return Py_BuildValue("H", us);
             break;
 
         case et_fixed:
-            if (read_eeprom_fixed_16(&gpx, gpx.sio, pem->address, &n) == SUCCESS)
+            if (read_eeprom_fixed_16(gpx, gpx->sio, pem->address, &n) == SUCCESS)
                 return Py_BuildValue("f", n);
             break;
 
         case et_long:
         case et_ulong:
-            if (read_eeprom_32(&gpx, gpx.sio, pem->address, &ul) == SUCCESS)
+            if (read_eeprom_32(gpx, gpx->sio, pem->address, &ul) == SUCCESS)
                 return Py_BuildValue(pem->et == et_long ? "l" : "k", ul);
             break;
 
         case et_float:
-            if (read_eeprom_float(&gpx, gpx.sio, pem->address, &n) == SUCCESS)
+            if (read_eeprom_float(gpx, gpx->sio, pem->address, &n) == SUCCESS)
                 return Py_BuildValue("f", n);
             break;
 
         case et_string:
-            memset(gpx.sio->response.eeprom.buffer, 0, sizeof(gpx.sio->response.eeprom.buffer));
+            memset(gpx->sio->response.eeprom.buffer, 0, sizeof(gpx->sio->response.eeprom.buffer));
             int len = pem->len;
-            if (len > sizeof(gpx.sio->response.eeprom.buffer))
-                len = sizeof(gpx.sio->response.eeprom.buffer);
-            if (read_eeprom(&gpx, pem->address, len) == SUCCESS)
-                return Py_BuildValue("s", gpx.sio->response.eeprom.buffer);
+            if (len > sizeof(gpx->sio->response.eeprom.buffer))
+                len = sizeof(gpx->sio->response.eeprom.buffer);
+            if (read_eeprom(gpx, pem->address, len) == SUCCESS)
+                return Py_BuildValue("s", gpx->sio->response.eeprom.buffer);
             break;
 
         default:
@@ -772,17 +867,17 @@ static PyObject *py_write_eeprom(PyObject *self, PyObject *args)
         return NULL;
     id = (const char*)pybuf.buf;
 
-    PyObject_Print(value, gpx.log, 0);
-    fprintf(gpx.log, " <- \n");
+    PyObject_Print(value, gpx->log, 0);
+    fprintf(gpx->log, " <- \n");
 
-    if (gpx.flag.verboseMode) fprintf(gpx.log, "py_write_eeprom\n");
-    if (gpx.eepromMap == NULL && load_eeprom_map(&gpx) != SUCCESS) {
+    if (gpx->flag.verboseMode) fprintf(gpx->log, "py_write_eeprom\n");
+    if (gpx->eepromMap == NULL && load_eeprom_map(gpx) != SUCCESS) {
         PyErr_SetString(pyerrUnknownFirmware, "No EEPROM map found for firmware type and/or version");
         PyBuffer_Release(&pybuf);
         return NULL;
     }
 
-    EepromMapping *pem = find_any_eeprom_mapping(&gpx, id);
+    EepromMapping *pem = find_any_eeprom_mapping(gpx, id);
     id = NULL;
     PyBuffer_Release(&pybuf);
     if (pem == NULL) {
@@ -802,8 +897,8 @@ static PyObject *py_write_eeprom(PyObject *self, PyObject *args)
         case et_boolean:
             if (!PyArg_Parse(value, "B", &b))
                 return NULL;
-            gcodeResult(&gpx, "write_eeprom_8(%u) to address %u", (unsigned)!!b, pem->address);
-            rval = write_eeprom_8(&gpx, gpx.sio, pem->address, !!b);
+            gcodeResult(gpx, "write_eeprom_8(%u) to address %u", (unsigned)!!b, pem->address);
+            rval = write_eeprom_8(gpx, gpx->sio, pem->address, !!b);
             break;
 
         case et_bitfield:
@@ -815,8 +910,8 @@ static PyObject *py_write_eeprom(PyObject *self, PyObject *args)
             Py_DECREF(value);
             if (!f)
                 return NULL;
-            gcodeResult(&gpx, "write_eeprom_8(%u) to address %u", (unsigned)b, pem->address);
-            rval = write_eeprom_8(&gpx, gpx.sio, pem->address, b);
+            gcodeResult(gpx, "write_eeprom_8(%u) to address %u", (unsigned)b, pem->address);
+            rval = write_eeprom_8(gpx, gpx->sio, pem->address, b);
             break;
 
         case et_ushort:
@@ -827,8 +922,8 @@ static PyObject *py_write_eeprom(PyObject *self, PyObject *args)
             Py_DECREF(value);
             if (!f)
                 return NULL;
-            gcodeResult(&gpx, "write_eeprom_16(%u) to address %u", us, pem->address);
-            rval = write_eeprom_16(&gpx, gpx.sio, pem->address, us);
+            gcodeResult(gpx, "write_eeprom_16(%u) to address %u", us, pem->address);
+            rval = write_eeprom_16(gpx, gpx->sio, pem->address, us);
             break;
 
         case et_fixed:
@@ -839,8 +934,8 @@ static PyObject *py_write_eeprom(PyObject *self, PyObject *args)
             Py_DECREF(value);
             if (!f)
                 return NULL;
-            rval = write_eeprom_fixed_16(&gpx, gpx.sio, pem->address, n);
-            gcodeResult(&gpx, "write_eeprom_fixed_16(%f) to address %u", n, pem->address);
+            rval = write_eeprom_fixed_16(gpx, gpx->sio, pem->address, n);
+            gcodeResult(gpx, "write_eeprom_fixed_16(%f) to address %u", n, pem->address);
             break;
 
         case et_long:
@@ -851,8 +946,8 @@ static PyObject *py_write_eeprom(PyObject *self, PyObject *args)
             Py_DECREF(value);
             if (!f)
                 return NULL;
-            rval = write_eeprom_32(&gpx, gpx.sio, pem->address, ul);
-            gcodeResult(&gpx, "write_eeprom_32(%lu) to address %u", ul, pem->address);
+            rval = write_eeprom_32(gpx, gpx->sio, pem->address, ul);
+            gcodeResult(gpx, "write_eeprom_32(%lu) to address %u", ul, pem->address);
             break;
 
         case et_ulong:
@@ -863,8 +958,8 @@ static PyObject *py_write_eeprom(PyObject *self, PyObject *args)
             Py_DECREF(value);
             if (!f)
                 return NULL;
-            rval = write_eeprom_32(&gpx, gpx.sio, pem->address, ul);
-            gcodeResult(&gpx, "write_eeprom_32(%lu) to address %u", ul, pem->address);
+            rval = write_eeprom_32(gpx, gpx->sio, pem->address, ul);
+            gcodeResult(gpx, "write_eeprom_32(%lu) to address %u", ul, pem->address);
             break;
 
         case et_float:
@@ -875,8 +970,8 @@ static PyObject *py_write_eeprom(PyObject *self, PyObject *args)
             Py_DECREF(value);
             if (!f)
                 return NULL;
-            rval = write_eeprom_float(&gpx, gpx.sio, pem->address, n);
-            gcodeResult(&gpx, "write_eeprom_float(%f) to address %u", n, pem->address);
+            rval = write_eeprom_float(gpx, gpx->sio, pem->address, n);
+            gcodeResult(gpx, "write_eeprom_float(%f) to address %u", n, pem->address);
             break;
 
         case et_string:
@@ -887,8 +982,8 @@ static PyObject *py_write_eeprom(PyObject *self, PyObject *args)
                 PyErr_SetString(PyExc_ValueError, "String value too long for indicated EEPROM entry");
                 return NULL;
             }
-            rval = write_eeprom(&gpx, pem->address, s, len + 1);
-            gcodeResult(&gpx, "write_eeprom(%s) to address %u", s, pem->address);
+            rval = write_eeprom(gpx, pem->address, s, len + 1);
+            gcodeResult(gpx, "write_eeprom(%s) to address %u", s, pem->address);
             break;
 
         default:
@@ -905,6 +1000,7 @@ static PyMethodDef GpxMethods[] = {
     {"connect", py_connect, METH_VARARGS, "connect(port, baud = 0, inifilepath = None, logfilepath = None) Open the serial port to the printer and initialize the channel"},
     {"disconnect", py_disconnect, METH_VARARGS, "disconnect() Close the serial port and clean up."},
     {"write", py_write, METH_VARARGS, "write(string) Translate g-code into x3g and send."},
+    {"write_moves", py_write_moves, METH_VARARGS, "write_moves(buffer) Translate moves held as records of 15 doubles, the g m t x y z a b e f p r s i j words with NaN for a missing word, into x3g and send."},
     {"readnext", py_readnext, METH_VARARGS, "readnext() read next response if any"},
     {"set_baudrate", py_set_baudrate, METH_VARARGS, "set_baudrate(long) Set the current baudrate for the connection to the printer."},
     {"get_machine_defaults", py_get_machine_defaults, METH_VARARGS, "get_machine_defaults(string) Return a dict with the default settings for the indicated machine type."},
@@ -940,12 +1036,14 @@ static PyObject *init_gpx_module(PyObject *m)
     Py_INCREF(pyerrTimeout);
     PyModule_AddObject(m, "Timeout", pyerrTimeout);
 
+    PyModule_AddIntConstant(m, "MOVE_FIELDS", MOVE_FIELDS);
+
     pyerrUnknownFirmware = PyErr_NewException("gpx.UnknownFirmware", NULL, NULL);
     Py_INCREF(pyerrUnknownFirmware);
     PyModule_AddObject(m, "UnknownFirmware", pyerrUnknownFirmware);
 
-    gpx_initialize(&gpx, 1);
-    tio = tio_initialize(&gpx);
+    if ((gpx = gpx_create()) == NULL || (tio = tio_initialize(gpx)) == NULL)
+        return PyErr_NoMemory();
     return m;
 }
 
@@ -5,16 +5,27 @@ from setuptools import setup, Extension
 
 sources = [
 	'gpxmodule.c',
-	'../shared/machine_config.c',
-	'../shared/opt.c',
 	'../gpx/vector.c',
 	'../gpx/gpx.c',
-	'../gpx/gpx-main.c',
+	'../gpx/cache.c',
 	'../gpx/gpxresp.c',
+	'../gpx/kinematics.c',
+	'../gpx/pipeline.c',
+	'../gpx/planner.c',
+	'../gpx/scanner.c',
+	'../shared/crc8.c',
 	]
 if sys.platform == 'win32':
 	sources.append('../gpx/winsio.c')
 
+# configure decides whether gpx reads and writes gzip through zlib
+libraries = []
+try:
+	if '#define HAVE_ZLIB 1' in open('../../build/src/shared/config.h').read():
+		libraries.append('z')
+except IOError:
+	pass
+
 def params():
 	name='gcodex3g'
 	version='1.0'
@@ -26,7 +37,8 @@ def params():
 		Extension('gcodex3g',
 		sources = sources,
 		extra_compile_args = ['-DGPX_VERSION="\\"Python\\""', '-DSERIAL_SUPPORT', '-fvisibility=hidden', '-I../../build/src/shared', '-I../shared', '-I../gpx'],
-		extra_link_args = ['-fvisibility=hidden'])
+		extra_link_args = ['-fvisibility=hidden'],
+		libraries = libraries)
 		]
 	return locals()
 
@@ -0,0 +1,34 @@
+#!/usr/bin/env python
+# reset_ini must leave the module able to translate, run it after building the
+# module in place:
+#   python setup.py build_ext --inplace && python test_reset_ini.py
+# a pseudo terminal stands in for the printer, nothing written here needs the
+# bot to answer
+
+import os
+import unittest
+
+import gcodex3g as gpx
+
+class ResetIniTest(unittest.TestCase):
+    def setUp(self):
+        self.master, self.slave = os.openpty()
+        gpx.connect(os.ttyname(self.slave), 115200)
+
+    def tearDown(self):
+        gpx.disconnect()
+        os.close(self.master)
+        os.close(self.slave)
+
+    def test_write_after_reset(self):
+        gpx.reset_ini()
+        self.assertEqual(gpx.write("G90"), "ok")
+        self.assertEqual(gpx.write("G21"), "ok")
+
+    def test_reset_twice(self):
+        gpx.reset_ini()
+        gpx.reset_ini()
+        self.assertEqual(gpx.write("G91"), "ok")
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,44 @@
+#!/usr/bin/env python
+# write_moves reports how much of a batch it converted, run it after building
+# the module in place:
+#   python setup.py build_ext --inplace && python test_write_moves.py
+# a pseudo terminal stands in for the printer and never answers, so the first
+# move that has to be sent times out
+
+import os
+import unittest
+from array import array
+
+import gcodex3g as gpx
+
+nan = float('nan')
+
+def record(g, x=nan, y=nan, f=nan):
+    return [g, nan, nan, x, y, nan, nan, nan, nan, f, nan, nan, nan, nan, nan]
+
+class WriteMovesTest(unittest.TestCase):
+    def setUp(self):
+        self.master, self.slave = os.openpty()
+        gpx.connect(os.ttyname(self.slave), 115200)
+
+    def tearDown(self):
+        gpx.disconnect()
+        os.close(self.master)
+        os.close(self.slave)
+
+    def test_whole_batch(self):
+        moves = array('d', record(90) + record(21) + record(91))
+        self.assertEqual(len(moves), 3 * gpx.MOVE_FIELDS)
+        self.assertEqual(gpx.write_moves(moves), ("ok", 3))
+
+    def test_stopped_batch(self):
+        moves = array('d', record(90) + record(1, 10, 10, 1800) + record(21))
+        try:
+            gpx.write_moves(moves)
+        except gpx.Timeout as e:
+            self.assertEqual(e.converted, 1)
+        else:
+            self.fail("the move to an unanswering printer didn't time out")
+
+if __name__ == '__main__':
+    unittest.main()
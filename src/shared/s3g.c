@@ -30,6 +30,7 @@
 #include <fcntl.h>
 
 #include "portable_endian.h"
+#include "crc8.h"
 #include "s3g_private.h"
 #include "s3g_stdio.h"
 #include "s3g.h"
@@ -58,191 +59,110 @@ typedef struct {
      const char *cmd_desc;
 } s3g_command_info_t;
 
-static const s3g_command_info_t command_table_raw[] = {
-     /*   0 */  {HOST_CMD_VERSION, 0, 0, "version"},
-     /*   1 */  {HOST_CMD_INIT, 0, -1, "initialize"},
-     /*   2 */  {HOST_CMD_GET_BUFFER_SIZE, 0, 0, "get buffer size"},
-     /*   3 */  {HOST_CMD_CLEAR_BUFFER, 0, 0, "clear buffer"},
-     /*   4 */  {HOST_CMD_GET_POSITION, 0, -1, "get position"},
+// Indexed by command id.  The tables are read-only so that any number of
+// contexts may decode concurrently; ids without an entry have a NULL
+// cmd_desc and are treated as unrecognized (and blocking).
+
+static const s3g_command_info_t command_table[256] = {
+     /*   0 */  [HOST_CMD_VERSION] = {HOST_CMD_VERSION, 0, 0, "version"},
+     /*   1 */  [HOST_CMD_INIT] = {HOST_CMD_INIT, 0, -1, "initialize"},
+     /*   2 */  [HOST_CMD_GET_BUFFER_SIZE] = {HOST_CMD_GET_BUFFER_SIZE, 0, 0, "get buffer size"},
+     /*   3 */  [HOST_CMD_CLEAR_BUFFER] = {HOST_CMD_CLEAR_BUFFER, 0, 0, "clear buffer"},
+     /*   4 */  [HOST_CMD_GET_POSITION] = {HOST_CMD_GET_POSITION, 0, -1, "get position"},
      /* 5,6 */  // DO NOT EXIST
-     /*   7 */  {HOST_CMD_ABORT, 0, -1, "abort"},
-     /*   8 */  {HOST_CMD_PAUSE, 0, -1, "Pause"},
-     /*   9 */  {HOST_CMD_PROBE, 0, -1, "probe"},
-     /*  10 */  {HOST_CMD_TOOL_QUERY, 0, 0, "tool query"},
-     /*  11 */  {HOST_CMD_IS_FINISHED, 0, -1, "is finished?"},
-     /*  12 */  {HOST_CMD_READ_EEPROM, 0, 0, "read EEPROM"},
-     /*  13 */  {HOST_CMD_WRITE_EEPROM, 0, 0, "write EEPROM"},
-     /*  14 */  {HOST_CMD_CAPTURE_TO_FILE, 0, -1, "capture to file"},
-     /*  15 */  {HOST_CMD_END_CAPTURE, 0, -1, "end capture"},
-     /*  16 */  {HOST_CMD_PLAYBACK_CAPTURE, 0, -1, "playback capture"},
-     /*  17 */  {HOST_CMD_RESET, 0, -1, "software reset"},
-     /*  18 */  {HOST_CMD_NEXT_FILENAME, 0, -1, "next SD card filename"},
-     /*  19 */  {HOST_CMD_GET_DBG_REG, 0, 0, "get debug register"},
-     /*  20 */  {HOST_CMD_GET_BUILD_NAME, 0, 0, "get build name"},
-     /*  21 */  {HOST_CMD_GET_POSITION_EXT, 0, -1, "get position extended"},
-     /*  22 */  {HOST_CMD_EXTENDED_STOP, 0, -1, "extended stop"},
-     /*  23 */  {HOST_CMD_BOARD_STATUS, 0, 0, "get board status"},
-     /*  24 */  {HOST_CMD_GET_BUILD_STATS, 0, -1, "get build statistics"},
+     /*   7 */  [HOST_CMD_ABORT] = {HOST_CMD_ABORT, 0, -1, "abort"},
+     /*   8 */  [HOST_CMD_PAUSE] = {HOST_CMD_PAUSE, 0, -1, "Pause"},
+     /*   9 */  [HOST_CMD_PROBE] = {HOST_CMD_PROBE, 0, -1, "probe"},
+     /*  10 */  [HOST_CMD_TOOL_QUERY] = {HOST_CMD_TOOL_QUERY, 0, 0, "tool query"},
+     /*  11 */  [HOST_CMD_IS_FINISHED] = {HOST_CMD_IS_FINISHED, 0, -1, "is finished?"},
+     /*  12 */  [HOST_CMD_READ_EEPROM] = {HOST_CMD_READ_EEPROM, 0, 0, "read EEPROM"},
+     /*  13 */  [HOST_CMD_WRITE_EEPROM] = {HOST_CMD_WRITE_EEPROM, 0, 0, "write EEPROM"},
+     /*  14 */  [HOST_CMD_CAPTURE_TO_FILE] = {HOST_CMD_CAPTURE_TO_FILE, 0, -1, "capture to file"},
+     /*  15 */  [HOST_CMD_END_CAPTURE] = {HOST_CMD_END_CAPTURE, 0, -1, "end capture"},
+     /*  16 */  [HOST_CMD_PLAYBACK_CAPTURE] = {HOST_CMD_PLAYBACK_CAPTURE, 0, -1, "playback capture"},
+     /*  17 */  [HOST_CMD_RESET] = {HOST_CMD_RESET, 0, -1, "software reset"},
+     /*  18 */  [HOST_CMD_NEXT_FILENAME] = {HOST_CMD_NEXT_FILENAME, 0, -1, "next SD card filename"},
+     /*  19 */  [HOST_CMD_GET_DBG_REG] = {HOST_CMD_GET_DBG_REG, 0, 0, "get debug register"},
+     /*  20 */  [HOST_CMD_GET_BUILD_NAME] = {HOST_CMD_GET_BUILD_NAME, 0, 0, "get build name"},
+     /*  21 */  [HOST_CMD_GET_POSITION_EXT] = {HOST_CMD_GET_POSITION_EXT, 0, -1, "get position extended"},
+     /*  22 */  [HOST_CMD_EXTENDED_STOP] = {HOST_CMD_EXTENDED_STOP, 0, -1, "extended stop"},
+     /*  23 */  [HOST_CMD_BOARD_STATUS] = {HOST_CMD_BOARD_STATUS, 0, 0, "get board status"},
+     /*  24 */  [HOST_CMD_GET_BUILD_STATS] = {HOST_CMD_GET_BUILD_STATS, 0, -1, "get build statistics"},
      /* 25-6*/  // DO NOT EXIST
-     /*  27 */  {HOST_CMD_ADVANCED_VERSION, 0, 0, "advanced version"},
+     /*  27 */  [HOST_CMD_ADVANCED_VERSION] = {HOST_CMD_ADVANCED_VERSION, 0, 0, "advanced version"},
      /* ... */  // DO NOT EXIST
-     /* 112 */  {HOST_CMD_DEBUG_ECHO, 0, -1, "debug echo"},
+     /* 112 */  [HOST_CMD_DEBUG_ECHO] = {HOST_CMD_DEBUG_ECHO, 0, -1, "debug echo"},
      /* ... */  // DO NOT EXIST
-     /* 131 */  {HOST_CMD_FIND_AXES_MINIMUM, 7, -1, "find axes minimum"},
-     /* 132 */  {HOST_CMD_FIND_AXES_MAXIMUM, 7, -1, "find axes maximum"},
-     /* 133 */  {HOST_CMD_DELAY, 4, -1, "delay"},
-     /* 134 */  {HOST_CMD_CHANGE_TOOL, 1, -1, "change tool"},
-     /* 135 */  {HOST_CMD_WAIT_FOR_TOOL, 5, -1, "wait for tool ready"},
-     /* 136 */  {HOST_CMD_TOOL_COMMAND, 0xffffffff, 0, "tool action"},
-     /* 137 */  {HOST_CMD_ENABLE_AXES, 1, -1, "enable/disable axes"},
+     /* 131 */  [HOST_CMD_FIND_AXES_MINIMUM] = {HOST_CMD_FIND_AXES_MINIMUM, 7, -1, "find axes minimum"},
+     /* 132 */  [HOST_CMD_FIND_AXES_MAXIMUM] = {HOST_CMD_FIND_AXES_MAXIMUM, 7, -1, "find axes maximum"},
+     /* 133 */  [HOST_CMD_DELAY] = {HOST_CMD_DELAY, 4, -1, "delay"},
+     /* 134 */  [HOST_CMD_CHANGE_TOOL] = {HOST_CMD_CHANGE_TOOL, 1, -1, "change tool"},
+     /* 135 */  [HOST_CMD_WAIT_FOR_TOOL] = {HOST_CMD_WAIT_FOR_TOOL, 5, -1, "wait for tool ready"},
+     /* 136 */  [HOST_CMD_TOOL_COMMAND] = {HOST_CMD_TOOL_COMMAND, 0xffffffff, 0, "tool action"},
+     /* 137 */  [HOST_CMD_ENABLE_AXES] = {HOST_CMD_ENABLE_AXES, 1, -1, "enable/disable axes"},
      /* 138 */  // DOES NOT EXIST
-     /* 139 */  {HOST_CMD_QUEUE_POINT_EXT, 24, -1, "queue point extended"},
-     /* 140 */  {HOST_CMD_SET_POSITION_EXT, 20, -1, "set position extended"},
-     /* 141 */  {HOST_CMD_WAIT_FOR_PLATFORM, 5, -1, "wait for platform ready"},
-     /* 142 */  {HOST_CMD_QUEUE_POINT_NEW, 25, -1, "queue new point"},
-     /* 143 */  {HOST_CMD_STORE_HOME_POSITION, 1, -1, "store home position"},
-     /* 144 */  {HOST_CMD_RECALL_HOME_POSITION, 1, -1, "recall home position"},
-     /* 145 */  {HOST_CMD_SET_POT_VALUE, 2, -1, "digital potentiometer"},
-     /* 146 */  {HOST_CMD_SET_RGB_LED, 5, -1, "RGB LED"},
-     /* 147 */  {HOST_CMD_SET_BEEP, 5, -1, "buzzer beep"},
-     /* 148 */  {HOST_CMD_PAUSE_FOR_BUTTON, 4, -1, "pause for button"},
-     /* 149 */  {HOST_CMD_DISPLAY_MESSAGE, -1, -1, "display message"},
-     /* 150 */  {HOST_CMD_SET_BUILD_PERCENT, 2, 0, "build percentage"},
-     /* 151 */  {HOST_CMD_QUEUE_SONG, 1, -1, "queue song"},
-     /* 152 */  {HOST_CMD_RESET_TO_FACTORY, 1, -1, "restore to factory settings"},
-     /* 153 */  {HOST_CMD_BUILD_START_NOTIFICATION, 4, -1, "build start notification"},
-     /* 154 */  {HOST_CMD_BUILD_END_NOTIFICATION, 1, -1, "build end notification"},
-     /* 155 */  {HOST_CMD_QUEUE_POINT_NEW_EXT, 31, 0, "queue point new extended"},
-     /* 156 */  {HOST_CMD_SET_ACCELERATION_TOGGLE, 1, -1, "set segment acceleration"},
-     /* 157 */  {HOST_CMD_STREAM_VERSION, 20, 0, "stream version"},
-     /* 158 */  {HOST_CMD_PAUSE_AT_ZPOS, 4, 0, "pause at Z position"}
+     /* 139 */  [HOST_CMD_QUEUE_POINT_EXT] = {HOST_CMD_QUEUE_POINT_EXT, 24, -1, "queue point extended"},
+     /* 140 */  [HOST_CMD_SET_POSITION_EXT] = {HOST_CMD_SET_POSITION_EXT, 20, -1, "set position extended"},
+     /* 141 */  [HOST_CMD_WAIT_FOR_PLATFORM] = {HOST_CMD_WAIT_FOR_PLATFORM, 5, -1, "wait for platform ready"},
+     /* 142 */  [HOST_CMD_QUEUE_POINT_NEW] = {HOST_CMD_QUEUE_POINT_NEW, 25, -1, "queue new point"},
+     /* 143 */  [HOST_CMD_STORE_HOME_POSITION] = {HOST_CMD_STORE_HOME_POSITION, 1, -1, "store home position"},
+     /* 144 */  [HOST_CMD_RECALL_HOME_POSITION] = {HOST_CMD_RECALL_HOME_POSITION, 1, -1, "recall home position"},
+     /* 145 */  [HOST_CMD_SET_POT_VALUE] = {HOST_CMD_SET_POT_VALUE, 2, -1, "digital potentiometer"},
+     /* 146 */  [HOST_CMD_SET_RGB_LED] = {HOST_CMD_SET_RGB_LED, 5, -1, "RGB LED"},
+     /* 147 */  [HOST_CMD_SET_BEEP] = {HOST_CMD_SET_BEEP, 5, -1, "buzzer beep"},
+     /* 148 */  [HOST_CMD_PAUSE_FOR_BUTTON] = {HOST_CMD_PAUSE_FOR_BUTTON, 4, -1, "pause for button"},
+     /* 149 */  [HOST_CMD_DISPLAY_MESSAGE] = {HOST_CMD_DISPLAY_MESSAGE, -1, -1, "display message"},
+     /* 150 */  [HOST_CMD_SET_BUILD_PERCENT] = {HOST_CMD_SET_BUILD_PERCENT, 2, 0, "build percentage"},
+     /* 151 */  [HOST_CMD_QUEUE_SONG] = {HOST_CMD_QUEUE_SONG, 1, -1, "queue song"},
+     /* 152 */  [HOST_CMD_RESET_TO_FACTORY] = {HOST_CMD_RESET_TO_FACTORY, 1, -1, "restore to factory settings"},
+     /* 153 */  [HOST_CMD_BUILD_START_NOTIFICATION] = {HOST_CMD_BUILD_START_NOTIFICATION, 4, -1, "build start notification"},
+     /* 154 */  [HOST_CMD_BUILD_END_NOTIFICATION] = {HOST_CMD_BUILD_END_NOTIFICATION, 1, -1, "build end notification"},
+     /* 155 */  [HOST_CMD_QUEUE_POINT_NEW_EXT] = {HOST_CMD_QUEUE_POINT_NEW_EXT, 31, 0, "queue point new extended"},
+     /* 156 */  [HOST_CMD_SET_ACCELERATION_TOGGLE] = {HOST_CMD_SET_ACCELERATION_TOGGLE, 1, -1, "set segment acceleration"},
+     /* 157 */  [HOST_CMD_STREAM_VERSION] = {HOST_CMD_STREAM_VERSION, 20, 0, "stream version"},
+     /* 158 */  [HOST_CMD_PAUSE_AT_ZPOS] = {HOST_CMD_PAUSE_AT_ZPOS, 4, 0, "pause at Z position"}
      /* ... */  // DO NOT EXIST
 };
 
-static const s3g_command_info_t tool_command_table_raw[] = {
-     /*   0 */  {TOOL_CMD_VERSION, 0, 0, "version"},
-     /*   1 */  {TOOL_CMD_INIT, 0, -1, "initialize"},
-     /*   2 */  {TOOL_CMD_GET_TEMP, 0, 0, "query current extruder temperature"},
-     /*   3 */  {TOOL_CMD_SET_TEMP, 0, 0, "set extruder target temperature"},
-     /*   4 */  {TOOL_CMD_SET_MOTOR_1_PWM, 0, -1, "set motor 1 speed (PWM)"},
-     /*   5 */  {TOOL_CMD_SET_MOTOR_2_PWM, 0, -1, "set motor 2 speed (PWM)"},
-     /*   6 */  {TOOL_CMD_SET_MOTOR_1_RPM, 0, -1, "set motor 1 speed (RPM)"},
-     /*   7 */  {TOOL_CMD_SET_MOTOR_2_RPM, 0, -1, "set motor 2 speed (RPM)"},
-     /*   8 */  {TOOL_CMD_SET_MOTOR_1_DIR, 0, -1, "set motor 1 direction"},
-     /*   9 */  {TOOL_CMD_SET_MOTOR_2_DIR, 0, -1, "set motor 2 direction"},
-     /*  10 */  {TOOL_CMD_TOGGLE_MOTOR_1, 0, -1, "set motor 1 state"},
-     /*  11 */  {TOOL_CMD_TOGGLE_MOTOR_2, 0, -1, "set motor 2 state"},
-     /*  12 */  {TOOL_CMD_TOGGLE_FAN, 0, 0, "set heatsink cooling fan state"},
-     /*  13 */  {TOOL_CMD_TOGGLE_VALVE, 0, 0, "set print cooling fan state"},
-     /*  14 */  {TOOL_CMD_SET_SERVO_1_POS, 0, -1, "set servo 1 position"},
-     /*  15 */  {TOOL_CMD_SET_SERVO_2_POS, 0, -1, "set servo 2 position"},
-     /*  16 */  {TOOL_CMD_FILAMENT_STATUS, 0, 0, "query filament status"},
-     /*  17 */  {TOOL_CMD_GET_MOTOR_1_RPM, 0, 0, "query motor 1 speed (RPM)"},
-     /*  18 */  {TOOL_CMD_GET_MOTOR_2_RPM, 0, 0, "query motor 2 speed (RPM)"},
-     /*  19 */  {TOOL_CMD_GET_MOTOR_1_PWM, 0, 0, "query motor 1 speed (PWM)"},
-     /*  20 */  {TOOL_CMD_GET_MOTOR_2_PWM, 0, 0, "query motor 2 speed (PWM)"},
-     /*  21 */  {TOOL_CMD_SELECT_TOOL, 0, -1, "switch tool"},
-     /*  22 */  {TOOL_CMD_IS_TOOL_READY, 0, -1, "query tool ready"},
-     /*  23 */  {TOOL_CMD_PAUSE_UNPAUSE, 0, -1, "toggle pause state"},
-     /*  24 */  {TOOL_CMD_ABORT, 0, -1, "abort"},
-     /*  25 */  {TOOL_CMD_READ_FROM_EEPROM, 0, 0, "read EEPROM"},
-     /*  26 */  {TOOL_CMD_WRITE_TO_EEPROM, 0, 0, "write EEPROM"},
-     /*  30 */  {TOOL_CMD_GET_PLATFORM_TEMP, 0, 0, "query current platform temperature"},
-     /*  31 */  {TOOL_CMD_SET_PLATFORM_TEMP, 0, 0, "set platform target temperature"},
-     /*  32 */  {TOOL_CMD_GET_SP, 0, 0, "query extruder target temperature"},
-     /*  33 */  {TOOL_CMD_GET_PLATFORM_SP, 0, 0, "query platform target temperature"},
-     /*  34 */  {TOOL_CMD_GET_BUILD_NAME, 0, 0, "query build name"},
-     /*  35 */  {TOOL_CMD_IS_PLATFORM_READY, 0, -1, "query platform ready"},
-     /*  36 */  {TOOL_CMD_GET_TOOL_STATUS, 0, 0, "query tool status"},
-     /*  37 */  {TOOL_CMD_GET_PID_STATE, 0, 0, "query PID state"},
-     /*  40 */  {TOOL_CMD_LIGHT_INDICATOR_LED, 0, -1, "set LED state"}
+static const s3g_command_info_t tool_command_table[256] = {
+     /*   0 */  [TOOL_CMD_VERSION] = {TOOL_CMD_VERSION, 0, 0, "version"},
+     /*   1 */  [TOOL_CMD_INIT] = {TOOL_CMD_INIT, 0, -1, "initialize"},
+     /*   2 */  [TOOL_CMD_GET_TEMP] = {TOOL_CMD_GET_TEMP, 0, 0, "query current extruder temperature"},
+     /*   3 */  [TOOL_CMD_SET_TEMP] = {TOOL_CMD_SET_TEMP, 0, 0, "set extruder target temperature"},
+     /*   4 */  [TOOL_CMD_SET_MOTOR_1_PWM] = {TOOL_CMD_SET_MOTOR_1_PWM, 0, -1, "set motor 1 speed (PWM)"},
+     /*   5 */  [TOOL_CMD_SET_MOTOR_2_PWM] = {TOOL_CMD_SET_MOTOR_2_PWM, 0, -1, "set motor 2 speed (PWM)"},
+     /*   6 */  [TOOL_CMD_SET_MOTOR_1_RPM] = {TOOL_CMD_SET_MOTOR_1_RPM, 0, -1, "set motor 1 speed (RPM)"},
+     /*   7 */  [TOOL_CMD_SET_MOTOR_2_RPM] = {TOOL_CMD_SET_MOTOR_2_RPM, 0, -1, "set motor 2 speed (RPM)"},
+     /*   8 */  [TOOL_CMD_SET_MOTOR_1_DIR] = {TOOL_CMD_SET_MOTOR_1_DIR, 0, -1, "set motor 1 direction"},
+     /*   9 */  [TOOL_CMD_SET_MOTOR_2_DIR] = {TOOL_CMD_SET_MOTOR_2_DIR, 0, -1, "set motor 2 direction"},
+     /*  10 */  [TOOL_CMD_TOGGLE_MOTOR_1] = {TOOL_CMD_TOGGLE_MOTOR_1, 0, -1, "set motor 1 state"},
+     /*  11 */  [TOOL_CMD_TOGGLE_MOTOR_2] = {TOOL_CMD_TOGGLE_MOTOR_2, 0, -1, "set motor 2 state"},
+     /*  12 */  [TOOL_CMD_TOGGLE_FAN] = {TOOL_CMD_TOGGLE_FAN, 0, 0, "set heatsink cooling fan state"},
+     /*  13 */  [TOOL_CMD_TOGGLE_VALVE] = {TOOL_CMD_TOGGLE_VALVE, 0, 0, "set print cooling fan state"},
+     /*  14 */  [TOOL_CMD_SET_SERVO_1_POS] = {TOOL_CMD_SET_SERVO_1_POS, 0, -1, "set servo 1 position"},
+     /*  15 */  [TOOL_CMD_SET_SERVO_2_POS] = {TOOL_CMD_SET_SERVO_2_POS, 0, -1, "set servo 2 position"},
+     /*  16 */  [TOOL_CMD_FILAMENT_STATUS] = {TOOL_CMD_FILAMENT_STATUS, 0, 0, "query filament status"},
+     /*  17 */  [TOOL_CMD_GET_MOTOR_1_RPM] = {TOOL_CMD_GET_MOTOR_1_RPM, 0, 0, "query motor 1 speed (RPM)"},
+     /*  18 */  [TOOL_CMD_GET_MOTOR_2_RPM] = {TOOL_CMD_GET_MOTOR_2_RPM, 0, 0, "query motor 2 speed (RPM)"},
+     /*  19 */  [TOOL_CMD_GET_MOTOR_1_PWM] = {TOOL_CMD_GET_MOTOR_1_PWM, 0, 0, "query motor 1 speed (PWM)"},
+     /*  20 */  [TOOL_CMD_GET_MOTOR_2_PWM] = {TOOL_CMD_GET_MOTOR_2_PWM, 0, 0, "query motor 2 speed (PWM)"},
+     /*  21 */  [TOOL_CMD_SELECT_TOOL] = {TOOL_CMD_SELECT_TOOL, 0, -1, "switch tool"},
+     /*  22 */  [TOOL_CMD_IS_TOOL_READY] = {TOOL_CMD_IS_TOOL_READY, 0, -1, "query tool ready"},
+     /*  23 */  [TOOL_CMD_PAUSE_UNPAUSE] = {TOOL_CMD_PAUSE_UNPAUSE, 0, -1, "toggle pause state"},
+     /*  24 */  [TOOL_CMD_ABORT] = {TOOL_CMD_ABORT, 0, -1, "abort"},
+     /*  25 */  [TOOL_CMD_READ_FROM_EEPROM] = {TOOL_CMD_READ_FROM_EEPROM, 0, 0, "read EEPROM"},
+     /*  26 */  [TOOL_CMD_WRITE_TO_EEPROM] = {TOOL_CMD_WRITE_TO_EEPROM, 0, 0, "write EEPROM"},
+     /*  30 */  [TOOL_CMD_GET_PLATFORM_TEMP] = {TOOL_CMD_GET_PLATFORM_TEMP, 0, 0, "query current platform temperature"},
+     /*  31 */  [TOOL_CMD_SET_PLATFORM_TEMP] = {TOOL_CMD_SET_PLATFORM_TEMP, 0, 0, "set platform target temperature"},
+     /*  32 */  [TOOL_CMD_GET_SP] = {TOOL_CMD_GET_SP, 0, 0, "query extruder target temperature"},
+     /*  33 */  [TOOL_CMD_GET_PLATFORM_SP] = {TOOL_CMD_GET_PLATFORM_SP, 0, 0, "query platform target temperature"},
+     /*  34 */  [TOOL_CMD_GET_BUILD_NAME] = {TOOL_CMD_GET_BUILD_NAME, 0, 0, "query build name"},
+     /*  35 */  [TOOL_CMD_IS_PLATFORM_READY] = {TOOL_CMD_IS_PLATFORM_READY, 0, -1, "query platform ready"},
+     /*  36 */  [TOOL_CMD_GET_TOOL_STATUS] = {TOOL_CMD_GET_TOOL_STATUS, 0, 0, "query tool status"},
+     /*  37 */  [TOOL_CMD_GET_PID_STATE] = {TOOL_CMD_GET_PID_STATE, 0, 0, "query PID state"},
+     /*  40 */  [TOOL_CMD_LIGHT_INDICATOR_LED] = {TOOL_CMD_LIGHT_INDICATOR_LED, 0, -1, "set LED state"}
 };
 
-static s3g_command_info_t command_table[256];
-static s3g_command_info_t tool_command_table[256];
-
-// Not thread safe
-
-static int tables_initialized = 0;
-
-static int s3g_init(void)
-{
-     int i, istat;
-     const s3g_command_info_t *p;
-
-     if (tables_initialized != 0)
-	  return(0);
-
-     // Initialize the indexed command tables
-     memset(command_table,      0, sizeof(command_table));
-     memset(tool_command_table, 0, sizeof(tool_command_table));
-
-     // Force all unrecognized commands to be blocking
-     for (i = 0; i < 256; i++)
-     {
-	  command_table[i].cmd_blocking      = -1;
-	  tool_command_table[i].cmd_blocking = -1;
-     }
-
-     istat = 0;
-     p = command_table_raw;
-
-     // Load the indexed command table, looking for conflicts
-     for (i = 0; i < sizeof(command_table_raw) / sizeof(s3g_command_info_t); i++, p++)
-     {
-	  if ((command_table[p->cmd_id].cmd_len != 0 ||
-	       command_table[p->cmd_id].cmd_desc != NULL))
-	  {
-	       // Table already has an entry for this command id
-	       // Make sure that the lengths don't conflict
-	       if (command_table[p->cmd_id].cmd_len != p->cmd_len)
-	       {
-		    fprintf(stderr,
-			    "s3g_init(%d): Two commands with identical ids (%d) but "
-			    "different lengths encountered; ignoring \"%s\"\n",
-			    __LINE__, p->cmd_id, p->cmd_desc ? p->cmd_desc : "<no name>");
-		    istat = -1;
-		    continue;
-	       }
-	  }
-	  command_table[p->cmd_id].cmd_id       = p->cmd_id;
-	  command_table[p->cmd_id].cmd_len      = p->cmd_len;
-	  command_table[p->cmd_id].cmd_desc     = p->cmd_desc;
-	  command_table[p->cmd_id].cmd_blocking = p->cmd_blocking;
-     }
-
-     p = tool_command_table_raw;
-
-     // Load the indexed command table, looking for conflicts
-     for (i = 0; i < sizeof(tool_command_table_raw) / sizeof(s3g_command_info_t); i++, p++)
-     {
-	  if ((tool_command_table[p->cmd_id].cmd_len != 0 ||
-	       tool_command_table[p->cmd_id].cmd_desc != NULL))
-	  {
-	       // Table already has an entry for this command id
-	       // Make sure that the lengths don't conflict
-	       if (tool_command_table[p->cmd_id].cmd_len != p->cmd_len)
-	       {
-		    fprintf(stderr,
-			    "s3g_init(%d): Two tool commands with identical ids (%d) but "
-			    "different lengths encountered; ignoring \"%s\"\n",
-			    __LINE__, p->cmd_id, p->cmd_desc ? p->cmd_desc : "<no description>");
-		    istat = -1;
-		    continue;
-	       }
-	  }
-	  tool_command_table[p->cmd_id].cmd_id       = p->cmd_id;
-	  tool_command_table[p->cmd_id].cmd_len      = p->cmd_len;
-	  tool_command_table[p->cmd_id].cmd_desc     = p->cmd_desc;
-	  tool_command_table[p->cmd_id].cmd_blocking = p->cmd_blocking;
-     }
-
-     tables_initialized = -1;
-
-     return(istat);
-}
-
-
 s3g_context_t *s3g_open(int type, const char *src, int flags, int mode)
 {
      s3g_context_t *ctx;
@@ -280,14 +200,19 @@ int s3g_close(s3g_context_t *ctx)
 
 int s3g_command_isblocking(s3g_command_t *cmd)
 {
+     const s3g_command_info_t *ct;
+
      if (!cmd)
 	  // Bad call: claim the worst case which is blocking true;
 	  return(-1);
 
      if (cmd->cmd_id != HOST_CMD_TOOL_COMMAND)
-	  return (command_table[cmd->cmd_id].cmd_blocking);
+	  ct = command_table + cmd->cmd_id;
      else
-	  return(tool_command_table[cmd->t.tool.subcmd_id].cmd_blocking);
+	  ct = tool_command_table + cmd->t.tool.subcmd_id;
+
+     // Force all unrecognized commands to be blocking
+     return((ct->cmd_desc != NULL) ? ct->cmd_blocking : -1);
 
 }
 
@@ -296,14 +221,16 @@ int s3g_command_read_ext(s3g_context_t *ctx, s3g_command_t *cmd,
 {
      unsigned char *buf0 = buf;
      ssize_t bytes_expected, bytes_read;
-     s3g_command_info_t *ct;
+     const s3g_command_info_t *ct;
      s3g_command_t dummy;
      foo_16_t f16;
      foo_32_t f32;
      int iret;
      uint8_t ui8arg;
+     unsigned char frame[2];
 
      iret = -1;
+     frame[0] = 0;
 
      if (buflen)
 	  *buflen = 0;
@@ -332,9 +259,6 @@ int s3g_command_read_ext(s3g_context_t *ctx, s3g_command_t *cmd,
 	  return(-1);
      }
 
-     // Initialize command table
-     s3g_init();
-
      if (1 != (bytes_expected = (*ctx->read)(ctx->r_ctx, buf0, maxbuf, 1)))
      {
 	  // End of file condition?
@@ -348,6 +272,21 @@ int s3g_command_read_ext(s3g_context_t *ctx, s3g_command_t *cmd,
 	  return(-1);
      }
 
+     // A framed packet, as written by gpx -F, wraps the command in a start
+     // byte and the payload length ahead of it and the payload's CRC after it
+     if (buf0[0] == CRC8_PACKET_START)
+     {
+	  frame[0] = buf0[0];
+	  if (1 != (*ctx->read)(ctx->r_ctx, frame + 1, 1, 1) ||
+	      1 != (*ctx->read)(ctx->r_ctx, buf0, maxbuf, 1))
+	  {
+	       fprintf(stderr,
+		       "s3g_command_get(%d): Truncated packet in the s3g file\n",
+		       __LINE__);
+	       return(-1);
+	  }
+     }
+
      ct = command_table + buf0[0];  // &command_table[buf0[0]]
 
      buf    += 1;
@@ -687,6 +626,25 @@ trunc:
 
 done:
      cmd->cmd_raw_len = (size_t)(buf - buf0);
+     if (iret == 0 && frame[0] == CRC8_PACKET_START)
+     {
+	  unsigned char crc;
+	  if (1 != (*ctx->read)(ctx->r_ctx, &crc, 1, 1))
+	  {
+	       fprintf(stderr,
+		       "s3g_command_get(%d): Truncated packet in the s3g file\n",
+		       __LINE__);
+	       iret = -1;
+	  }
+	  else if (frame[1] != cmd->cmd_raw_len ||
+		   crc != crc8(0, buf0, cmd->cmd_raw_len))
+	  {
+	       fprintf(stderr,
+		       "s3g_command_get(%d): Packet length or CRC mismatch\n",
+		       __LINE__);
+	       iret = -1;
+	  }
+     }
      if (buflen)
 	  *buflen = cmd->cmd_raw_len;
 
@@ -22,6 +22,10 @@
  *  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
 #include <stdio.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -29,6 +33,10 @@
 #include <stdlib.h>
 #include <errno.h>
 
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
 #include "s3g_stdio.h"
 
 // Identify temporary read errors
@@ -62,6 +70,9 @@ typedef struct {
      int    fd;  // File descriptor; < 0 indicates that the file is not open
      size_t nread;
      size_t nwritten;
+#ifdef HAVE_ZLIB
+     gzFile gz;  // Reading through zlib, which passes uncompressed input as is
+#endif
 } s3g_rw_stdio_ctx_t;
 
 
@@ -94,6 +105,15 @@ static int stdio_close(void *ctx)
      }
 
      fd = myctx->fd;
+#ifdef HAVE_ZLIB
+     if (myctx->gz)
+     {
+	  // gzclose() closes fd as well
+	  gzFile gz = myctx->gz;
+	  free(myctx);
+	  return(gzclose(gz) == Z_OK ? 0 : -1);
+     }
+#endif
      free(myctx);
 
      if (fd < 0)
@@ -167,6 +187,22 @@ static ssize_t stdio_read_retry(int fd, void *buf, size_t nbytes)
 }
 
 
+// stdio_read_fill
+//
+// Read nbytes as stdio_read_retry() does, inflating them first when the file
+// is read through zlib.  gzread() reads all nbytes unless the end of the
+// file is reached or an error occurs.
+
+static ssize_t stdio_read_fill(s3g_rw_stdio_ctx_t *myctx, void *buf, size_t nbytes)
+{
+#ifdef HAVE_ZLIB
+     if (myctx->gz)
+	  return((ssize_t)gzread(myctx->gz, buf, (unsigned)nbytes));
+#endif
+     return(stdio_read_retry(myctx->fd, buf, nbytes));
+}
+
+
 // stdio_read
 //
 // Read the specified number of bytes from the input source, placing at most
@@ -233,10 +269,10 @@ static ssize_t stdio_read(void *ctx, void *buf, size_t maxbuf, size_t nbytes)
 
      // Buffer is big enough to contain the entire read
      if (nbytes <= maxbuf)
-	  return(stdio_read_retry(myctx->fd, buf, nbytes));
+	  return(stdio_read_fill(myctx, buf, nbytes));
 
      // Buffer is not large enough to contain the entire read
-     if ((n = stdio_read_retry(myctx->fd, buf, maxbuf)) <= 0)
+     if ((n = stdio_read_fill(myctx, buf, maxbuf)) <= 0)
 	  return(n);
 
      // Read the remaining number of bytes requested without
@@ -251,9 +287,9 @@ static ssize_t stdio_read(void *ctx, void *buf, size_t maxbuf, size_t nbytes)
 	       
 	       nread = (sizeof(tmpbuf) < nbytes) ?
 		    (size_t)sizeof(tmpbuf) : nbytes;
-	       if ((n = stdio_read_retry(myctx->fd, tmpbuf, nread)) <= 0)
+	       if ((n = stdio_read_fill(myctx, tmpbuf, nread)) <= 0)
 		    return(n);
-	       // NOTE: stdio_read_retry() guarantees n == nread when n > 0
+	       // NOTE: stdio_read_fill() guarantees n == nread when n > 0
 	       nbytes       -= n;
 	       myctx->nread += n;
 	  }
@@ -354,7 +390,8 @@ static ssize_t stdio_write(void *ctx, const void *buf, size_t nbytes)
 //     (create_file != 0).  Otherwise, the value is treated as a "const char *"
 //     pointer pointing to the name of a file to open in read only mode.  A
 //     ".s3g" will NOT be appended to the file name.  The file name must be
-//     the complete file name (but need not be an absolute file path).
+//     the complete file name (but need not be an absolute file path).  When
+//     built with zlib, a file or stdin read from may be gzip compressed.
 //
 //   int create_file
 //     If zero, then the file is opened for reading only.  If non-zero, the
@@ -417,6 +454,23 @@ int s3g_stdio_open(s3g_context_t *ctx, const char *src, int create_file, int mod
 	  tmp->fd = fd;
      }
 
+#ifdef HAVE_ZLIB
+     // Gzip compressed x3g is inflated as it's read
+     if (!create_file)
+     {
+	  tmp->gz = gzdopen(tmp->fd, "rb");
+	  if (tmp->gz == NULL)
+	  {
+	       fprintf(stderr, "s3g_open(%d): Unable to allocate VM; %s (%d)\n",
+		       __LINE__, strerror(errno), errno);
+	       if (src != NULL)
+		    close(tmp->fd);
+	       free(tmp);
+	       return(-1);
+	  }
+     }
+#endif
+
      // All finished and happy
      ctx->close  = stdio_close;
      ctx->read   = stdio_read;
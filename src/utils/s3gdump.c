@@ -29,8 +29,18 @@
 // or
 //
 //     s3gdump < filename
+//
+// or from where layer N starts, as found in the layer index gpx wrote
+// beside the file
+//
+//     s3gdump -l N filename
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -44,24 +54,131 @@ static void usage(FILE *f, const char *prog)
 	  f = stderr;
 
      fprintf(f,
-"Usage: %s -hE [file]\n"
+"Usage: %s -hE [-l layer] [file]\n"
 "   file  -- The .s3g file to dump.  If not supplied then stdin is dumped\n"
-"  ?, -h  -- This help message\n",
+"  ?, -h  -- This help message\n"
+"  -l N   -- Start from layer N, using the layer index file.idx\n",
 	     prog ? prog : "s3gdump");
 }
 
+// Find where a layer starts in the layer index written beside the file
+//
+// Return values:
+//
+//   >= 0 -- Byte offset of the layer
+//     -1 -- No index or no such layer; the problem is logged to stderr
+
+static long layer_offset(const char *fname, int layer)
+{
+     char line[256];
+     FILE *fp;
+     long offset = -1;
+     size_t len = strlen(fname);
+     char *index = (char *)malloc(len + 5);
+
+     if (!index)
+     {
+	  fprintf(stderr, "s3gdump: Unable to allocate VM\n");
+	  return(-1);
+     }
+     memcpy(index, fname, len);
+     strcpy(index + len, ".idx");
+     if ((fp = fopen(index, "r")) == NULL)
+     {
+	  fprintf(stderr, "s3gdump: Unable to open the layer index \"%s\"\n",
+		  index);
+	  free(index);
+	  return(-1);
+     }
+
+     // Lines of "layer z offset seconds filament", comments start with ;
+     while (fgets(line, sizeof(line), fp))
+     {
+	  int n;
+	  double z;
+	  unsigned long off;
+
+	  if (line[0] == ';')
+	       continue;
+	  if (sscanf(line, "%d %lf %lu", &n, &z, &off) == 3 && n == layer)
+	  {
+	       offset = (long)off;
+	       break;
+	  }
+     }
+     fclose(fp);
+
+     if (offset < 0)
+	  fprintf(stderr, "s3gdump: Layer %d is not in \"%s\"\n", layer, index);
+     free(index);
+     return(offset);
+}
+
+// Whether a file is gzipped, its layer offsets are then into the inflated
+// x3g rather than the file itself.  The file is left positioned at its start
+//
+// Return values:
+//
+//      1 -- gzipped
+//      0 -- not gzipped
+//     -1 -- Read error; check errno
+
+static int is_gzipped(int fd)
+{
+     unsigned char magic[2];
+     ssize_t n = read(fd, magic, sizeof(magic));
+
+     if (n < 0 || lseek(fd, 0, SEEK_SET) < 0)
+	  return(-1);
+     return(n == 2 && magic[0] == 0x1f && magic[1] == 0x8b);
+}
+
+// Read past the commands before a layer in a gzipped file, which can't be
+// seeked without inflating it anyway
+//
+// Return values:
+//
+//      0 -- Positioned at the layer
+//     -1 -- The file ended first or the offset isn't at a command; the
+//             problem is logged to stderr
+
+static int skip_commands(s3g_context_t *ctx, long offset)
+{
+     s3g_command_t cmd;
+     size_t len;
+
+     while (offset > 0)
+     {
+	  if (s3g_command_read_ext(ctx, &cmd, cmd.cmd_raw, sizeof(cmd.cmd_raw),
+				   &len))
+	       break;
+	  offset -= (long)len;
+     }
+     if (offset != 0)
+     {
+	  fprintf(stderr, "s3gdump: The layer index doesn't match the file\n");
+	  return(-1);
+     }
+     return(0);
+}
+
 int main(int argc, const char *argv[])
 {
      int c;
      s3g_context_t *ctx;
      s3g_command_t cmd;
-     int lineno, simple;
+     int lineno, simple, layer;
 
      simple = 0;
-     while ((c = getopt(argc, (char **)argv, ":h?")) != GETOPTS_END)
+     layer = -1;
+     while ((c = getopt(argc, (char **)argv, ":hl:?")) != GETOPTS_END)
      {
 	  switch(c)
 	  {
+	  case 'l' :
+	       layer = atoi(optarg);
+	       break;
+
 	  // Unknown switch
 	  case ':' :
 	  default :
@@ -80,7 +197,43 @@ int main(int argc, const char *argv[])
      argc -= optind;
      argv += optind;
 
-     if (argc == 0)
+     if (layer >= 0)
+     {
+	  long offset;
+	  int gzipped;
+
+	  if (argc == 0)
+	  {
+	       usage(stderr, NULL);
+	       return(1);
+	  }
+	  if ((offset = layer_offset(argv[0], layer)) < 0)
+	       return(1);
+
+	  // Read the file as stdin, positioned at the layer
+	  if (freopen(argv[0], "rb", stdin) == NULL ||
+	      (gzipped = is_gzipped(fileno(stdin))) < 0 ||
+	      (!gzipped && lseek(fileno(stdin), (off_t)offset, SEEK_SET) < 0))
+	  {
+	       perror(argv[0]);
+	       return(1);
+	  }
+#ifndef HAVE_ZLIB
+	  if (gzipped)
+	  {
+	       fprintf(stderr, "s3gdump: \"%s\" is gzipped, which this build "
+		       "can't read\n", argv[0]);
+	       return(1);
+	  }
+#endif
+	  ctx = s3g_open(0, NULL, 0, 0);
+	  if (ctx && gzipped && skip_commands(ctx, offset))
+	  {
+	       s3g_close(ctx);
+	       return(1);
+	  }
+     }
+     else if (argc == 0)
 	  ctx = s3g_open(0, NULL, 0, 0);
      else
 	  ctx = s3g_open(0, (void *)argv[0], 0, 0);